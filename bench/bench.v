@@ -0,0 +1,150 @@
+/*
+ * Top level benchmark environment for VProc
+ *
+ * Copyright (c) 2026 Simon Southwell.
+ *
+ * This file is part of VProc.
+ *
+ * VProc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VProc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with VProc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+`include "vprocdefs.vh"
+
+// ---------------------------------------------------------
+// Local definitions
+// ---------------------------------------------------------
+
+`define       CLKPERIOD          (2 * `NSEC)
+
+// Writes to addresses with bit 31 set flag a node as finished
+`define       DONEBIT            31
+
+// =========================================================
+// Top level benchmark module. NODES VProc instances, each
+// with a zero wait state 1K word memory.
+// =========================================================
+
+module bench
+#(parameter   NODES         = 1,
+              TIMEOUTCOUNT  = 0
+);
+
+// ---------------------------------------------------------
+// Local state
+// ---------------------------------------------------------
+
+reg           clk;
+integer       Count;
+
+wire [NODES-1:0] Done;
+
+// ---------------------------------------------------------
+// VProc nodes and memories
+// ---------------------------------------------------------
+
+genvar        i;
+
+generate
+  for (i = 0; i < NODES; i = i + 1)
+  begin : node
+
+    wire [31:0]   Addr;
+    wire  [3:0]   BE;
+    wire [31:0]   DataOut;
+    wire [31:0]   DataIn;
+    wire          WE;
+    wire          RD;
+    wire          Update;
+    reg           NodeDone;
+    reg  [31:0]   Mem [0:1023];
+
+    VProc    #(.INT_WIDTH          (3),
+               .NODE_WIDTH         (8),
+               .BURST_ADDR_INCR    (4)
+              ) vp
+              (.Clk                (clk),
+               .Addr               (Addr),
+               .WE                 (WE),
+               .RD                 (RD),
+               .BE                 (BE),
+               .Burst              (),
+               .BurstFirst         (),
+               .BurstLast          (),
+               .DataOut            (DataOut),
+               .DataIn             (DataIn),
+               .WRAck              (WE),
+               .RDAck              (RD),
+               .Interrupt          (3'b000),
+               .Update             (Update),
+               .UpdateResponse     (Update),
+               .Node               (i)
+              );
+
+    assign DataIn  = Mem[Addr[11:2]];
+    assign Done[i] = NodeDone;
+
+    initial
+      NodeDone = 1'b0;
+
+    always @(posedge clk)
+    begin
+      if (WE)
+      begin
+        if (Addr[`DONEBIT])
+          NodeDone     <= 1'b1;
+        else
+          Mem[Addr[11:2]] <= DataOut;
+      end
+    end
+  end
+endgenerate
+
+// ---------------------------------------------------------
+// Initialise state and generate a clock
+// ---------------------------------------------------------
+
+initial
+begin
+    clk         = 1;
+
+    `MINDELAY        // Ensure first x->1 clock edge is complete before initialisation
+    Count       = 0;
+
+    // Generate a clock
+    forever #(`CLKPERIOD/2) clk = ~clk;
+end
+
+// ---------------------------------------------------------
+// Simulation control
+// ---------------------------------------------------------
+
+always @(posedge clk)
+begin
+    Count      = Count + 1;
+
+    if (&Done)
+    begin
+      $display("\n--- Benchmark completed in %0d cycles ---\n", Count);
+      $finish;
+    end
+
+    if (TIMEOUTCOUNT != 0 && Count == TIMEOUTCOUNT)
+    begin
+      $display("***ERROR: Benchmark timed out");
+      $finish;
+    end
+end
+
+endmodule
@@ -0,0 +1,157 @@
+-- =============================================================
+--
+-- Top level benchmark environment for VProc
+--
+-- Copyright (c) 2026 Simon Southwell.
+--
+-- This file is part of VProc.
+--
+-- VProc is free software: you can redistribute it and/or modify
+-- it under the terms of the GNU General Public License as published by
+-- the Free Software Foundation, either version 3 of the License, or
+-- (at your option) any later version.
+--
+-- VProc is distributed in the hope that it will be useful,
+-- but WITHOUT ANY WARRANTY; without even the implied warranty of
+-- MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+-- GNU General Public License for more details.
+--
+-- You should have received a copy of the GNU General Public License
+-- along with VProc. If not, see <http://www.gnu.org/licenses/>.
+--
+-- =============================================================
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library std;
+use std.env.all;
+
+entity bench is
+  generic (
+    NODES                              : integer := 1;
+    TIMEOUTCOUNT                       : integer := 0
+  );
+end entity;
+
+architecture sim of bench is
+
+  ---------------------------------------------
+  -- Declarations
+  ---------------------------------------------
+
+  type     array_t is array (natural range <>) of std_logic_vector;
+
+  constant FREQ                        : real := 100.0e6;
+  constant ClkPeriod                   : time := 1 sec / FREQ;
+
+  -- Writes to addresses with bit 31 set flag a node as finished
+  constant DONEBIT                     : integer := 31;
+
+  signal  Clk                          : std_logic                        := '1';
+  signal  Count                        : integer                          := 0;
+  signal  Done                         : std_logic_vector(NODES-1 downto 0) := (others => '0');
+
+begin
+
+  ---------------------------------------------
+  -- VProc nodes and memories
+  ---------------------------------------------
+
+  G_NODE : for i in 0 to NODES-1 generate
+
+    signal  Addr, DataOut, DataIn      : std_logic_vector(31 downto 0)    := 32x"0";
+    signal  BE                         : std_logic_vector(3 downto 0)     := 4x"F";
+    signal  WE, RD                     : std_logic;
+    signal  Update                     : std_logic;
+    signal  UpdateResponse             : std_logic                        := '1';
+    signal  Mem                        : array_t (0 to 1023)(31 downto 0) := (others => 32x"0");
+
+  begin
+
+    vp : entity work.VProc
+    generic map (
+      NODE_WIDTH                       => 8,
+      BURST_ADDR_INCR                  => 4
+    )
+    port map (
+      Clk                              => Clk,
+      Addr                             => Addr,
+      BE                               => BE,
+      WE                               => WE,
+      RD                               => RD,
+      DataOut                          => DataOut,
+      DataIn                           => DataIn,
+      WRAck                            => WE,
+      RDAck                            => RD,
+      Interrupt                        => "000",
+      Update                           => Update,
+      UpdateResponse                   => UpdateResponse,
+      Burst                            => open,
+      BurstFirst                       => open,
+      BurstLast                        => open,
+      Node                             => std_logic_vector(to_unsigned(i, 8))
+    );
+
+    P_UPDT : process(Update)
+    begin
+      UpdateResponse                   <= not UpdateResponse;
+    end process;
+
+    DataIn                             <= Mem(to_integer(unsigned(Addr(11 downto 2))));
+
+    P_MEM : process (Clk)
+    begin
+      if Clk'event and Clk = '1' then
+        if WE = '1' then
+          if Addr(DONEBIT) = '1' then
+            Done(i)                    <= '1';
+          else
+            Mem(to_integer(unsigned(Addr(11 downto 2)))) <= DataOut;
+          end if;
+        end if;
+      end if;
+    end process;
+
+  end generate;
+
+  ---------------------------------------------
+  -- Clock generation
+  ---------------------------------------------
+
+  P_CLKGEN : process
+  begin
+    -- Generate a clock cycle
+    loop
+      Clk                              <= '1';
+      wait for ClkPeriod/2.0;
+      Clk                              <= '0';
+      wait for ClkPeriod/2.0;
+    end loop;
+  end process;
+
+  ---------------------------------------------
+  -- Simulation control
+  ---------------------------------------------
+
+  P_CTRL : process (Clk)
+  begin
+    if Clk'event and Clk = '1' then
+
+      Count                            <= Count + 1;
+
+      if Done = (Done'range => '1') then
+        report "Benchmark completed in " & integer'image(Count) & " cycles";
+        finish(0);
+      end if;
+
+      if TIMEOUTCOUNT /= 0 and Count = TIMEOUTCOUNT then
+        report "***ERROR: Benchmark timed out" severity error;
+        finish(1);
+      end if;
+
+    end if;
+  end process;
+
+end sim;
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+###################################################################
+# VProc benchmark runner and baseline comparison
+#
+# Copyright (c) 2026 Simon Southwell.
+#
+# This file is part of VProc.
+#
+# This code is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# The code is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this code. If not, see <http://www.gnu.org/licenses/>.
+#
+###################################################################
+#
+# Runs the benchmark on each available simulator for a range of
+# node counts, merging the results into a single JSON file, and
+# optionally compares against a stored baseline, returning a
+# non-zero exit status if any measure has regressed by more than
+# the given tolerance.
+#
+# Usage: benchmark.py [-s ica,verilator,ghdl,nvc] [-n 1,2,4,8]
+#                     [-i <iterations>] [-o <results.json>]
+#                     [-b <baseline.json>] [-t <tolerance %>]
+#                     [-r <existing results.json>]
+#
+###################################################################
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import shutil
+import subprocess
+import sys
+
+# Simulator makefile suffixes and the executable needed for each
+SIMULATORS = {"ica" : "iverilog", "verilator" : "verilator", "ghdl" : "ghdl", "nvc" : "nvc"}
+
+TMPFILE    = "bench_run.json"
+
+# ---------------------------------------------------------------
+# Run a single benchmark configuration, returning the JSON results
+# ---------------------------------------------------------------
+
+def run_one(sim, nodes, iters) :
+
+  mkfile = "makefile." + sim
+
+  subprocess.run(["make", "-f", mkfile, "clean"], check = True)
+
+  if os.path.exists(TMPFILE) :
+    os.remove(TMPFILE)
+
+  subprocess.run(["make", "-f", mkfile, "NODES=%d" % nodes, "ITERS=%d" % iters,
+                  "BENCHFILE=" + TMPFILE, "run"], check = True)
+
+  if not os.path.exists(TMPFILE) :
+    sys.exit("***Error: %s with %d nodes produced no results" % (sim, nodes))
+
+  with open(TMPFILE) as fp :
+    res = json.load(fp)
+
+  os.remove(TMPFILE)
+
+  return res
+
+# ---------------------------------------------------------------
+# Run all configurations
+# ---------------------------------------------------------------
+
+def run_all(sims, nodelist, iters) :
+
+  results = {"host"    : platform.node(),
+             "date"    : datetime.datetime.now().isoformat(timespec = "seconds"),
+             "results" : {}}
+
+  for sim in sims :
+    simres = {"scaling_txns_per_sec" : {}}
+
+    for nodes in nodelist :
+      print("=== Running %s with %d node(s) ===" % (sim, nodes), flush = True)
+      res = run_one(sim, nodes, iters)
+
+      if nodes == 1 :
+        simres["latency_ns"]     = res["latency_ns"]
+        simres["latency_cycles"] = res["latency_cycles"]
+        simres["burst_mbytes_per_sec"] = {str(b["len"]) : b["mbytes_per_sec"] for b in res["burst"]}
+
+      simres["scaling_txns_per_sec"][str(nodes)] = res["txns_per_sec"]
+
+    results["results"][sim] = simres
+
+  return results
+
+# ---------------------------------------------------------------
+# Compare results against a baseline. Latencies are regressions
+# if higher, throughputs if lower. Returns number of regressions.
+# ---------------------------------------------------------------
+
+def compare(results, baseline, tolerance) :
+
+  regressions = 0
+
+  print("\n%-10s %-28s %14s %14s %8s" % ("SIM", "MEASURE", "BASELINE", "CURRENT", "CHANGE"))
+
+  for sim, cur in results["results"].items() :
+    base = baseline.get("results", {}).get(sim)
+
+    if base is None :
+      print("%-10s no baseline results" % sim)
+      continue
+
+    checks = []
+    for op, val in cur.get("latency_ns", {}).items() :
+      checks.append(("latency_ns." + op, base.get("latency_ns", {}).get(op), val, False))
+    for blen, val in cur.get("burst_mbytes_per_sec", {}).items() :
+      checks.append(("burst_MB/s.len" + blen, base.get("burst_mbytes_per_sec", {}).get(blen), val, True))
+    for nodes, val in cur.get("scaling_txns_per_sec", {}).items() :
+      checks.append(("txns_per_sec.nodes" + nodes, base.get("scaling_txns_per_sec", {}).get(nodes), val, True))
+
+    for name, bval, cval, higher_better in checks :
+      if not bval :
+        continue
+
+      change = 100.0 * (cval - bval) / bval
+      worse  = -change if higher_better else change
+      flag   = ""
+
+      if worse > tolerance :
+        flag = "  REGRESSION"
+        regressions += 1
+
+      print("%-10s %-28s %14.1f %14.1f %+7.1f%%%s" % (sim, name, bval, cval, change, flag))
+
+  return regressions
+
+# ---------------------------------------------------------------
+# Main
+# ---------------------------------------------------------------
+
+def main() :
+
+  parser = argparse.ArgumentParser(description = "Run VProc benchmarks")
+  parser.add_argument("-s", "--sims",      default = None,
+                      help = "comma separated simulators (default all available of " + ",".join(SIMULATORS) + ")")
+  parser.add_argument("-n", "--nodes",     default = "1,2,4,8",   help = "comma separated node counts (default 1,2,4,8)")
+  parser.add_argument("-i", "--iters",     default = 20000, type = int, help = "iterations per measure (default 20000)")
+  parser.add_argument("-o", "--output",    default = "bench_results.json", help = "results file")
+  parser.add_argument("-b", "--baseline",  default = None,        help = "baseline results file to compare against")
+  parser.add_argument("-t", "--tolerance", default = 10.0, type = float, help = "regression tolerance in percent (default 10)")
+  parser.add_argument("-r", "--results",   default = None,        help = "compare existing results file, without running")
+  args = parser.parse_args()
+
+  # Resolve file arguments, then run from the benchmark directory, where the makefiles are
+  for attr in ["output", "baseline", "results"] :
+    if getattr(args, attr) :
+      setattr(args, attr, os.path.abspath(getattr(args, attr)))
+
+  os.chdir(os.path.dirname(os.path.abspath(__file__)))
+
+  if args.results :
+    with open(args.results) as fp :
+      results = json.load(fp)
+  else :
+    if args.sims :
+      sims = args.sims.split(",")
+    else :
+      sims = [sim for sim, exe in SIMULATORS.items() if shutil.which(exe)]
+
+    if not sims :
+      sys.exit("***Error: no supported simulators found")
+
+    results = run_all(sims, [int(n) for n in args.nodes.split(",")], args.iters)
+
+    with open(args.output, "w") as fp :
+      json.dump(results, fp, indent = 2)
+
+    print("\nResults written to %s" % args.output)
+
+  if args.baseline :
+    with open(args.baseline) as fp :
+      baseline = json.load(fp)
+
+    if compare(results, baseline, args.tolerance) :
+      sys.exit(1)
+
+if __name__ == "__main__" :
+  main()
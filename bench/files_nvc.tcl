@@ -0,0 +1,3 @@
+../f_vproc_pkg_nvc.vhd
+../f_vproc.vhd
+./bench.vhd
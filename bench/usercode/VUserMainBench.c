@@ -0,0 +1,283 @@
+/**************************************************************/
+/* VUserMainBench.c                          Date: 2026/10/19 */
+/*                                                            */
+/* Copyright (c) 2026 Simon Southwell.                        */
+/* All rights reserved.                                       */
+/*                                                            */
+/**************************************************************/
+//
+// Benchmark user code. With a single node, measures round trip
+// latency of VWrite, VRead and VTick and burst throughput against
+// burst length. With any number of nodes, measures aggregate
+// transaction throughput. Results are written in JSON format to
+// the file named in VPROC_BENCH_FILE (default bench.json) when
+// the last node finishes.
+//
+// Run time configuration (environment):
+//
+//   VPROC_BENCH_NODES : number of nodes in the test bench (default 1)
+//   VPROC_BENCH_ITERS : iterations per measurement (default 20000)
+//   VPROC_BENCH_FILE  : output JSON file name
+//
+// ------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "VUser.h"
+
+// ------------------------------------------------------------
+// LOCAL DEFINITIONS
+// ------------------------------------------------------------
+
+#ifndef BENCH_SIM
+#define BENCH_SIM               "unknown"
+#endif
+
+#define BENCH_MAX_NODES         16
+#define BENCH_DEFAULT_ITERS     20000
+#define BENCH_DEFAULT_FILE      "bench.json"
+#define BENCH_DONE_ADDR         0x80000000
+#define BENCH_MEM_MASK          0xffc
+#define BENCH_MAX_BURST         256
+
+typedef struct {
+    double   ns;
+    double   cycles;
+} latency_t;
+
+typedef struct {
+    unsigned len;
+    double   mbytes_per_sec;
+    double   words_per_cycle;
+} burst_t;
+
+// ------------------------------------------------------------
+// LOCAL STATICS
+// ------------------------------------------------------------
+
+static int              numNodes;
+static int              iters;
+
+static latency_t        latWrite, latRead, latTick;
+static burst_t          burstRes[16];
+static int              numBurst = 0;
+
+static double           nodeSecs[BENCH_MAX_NODES];
+static uint64_t         nodeTxns[BENCH_MAX_NODES];
+static int              nodesDone = 0;
+
+// ------------------------------------------------------------
+// Utility functions
+// ------------------------------------------------------------
+
+static double nowSecs (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static uint64_t nodeCycle (const int node)
+{
+    VStats_t stats;
+    VGetStats(node, &stats);
+    return stats.cycle;
+}
+
+static int envInt (const char *name, const int dflt)
+{
+    char *str = getenv(name);
+    return (str != NULL && str[0] != '\0') ? atoi(str) : dflt;
+}
+
+// ------------------------------------------------------------
+// Round trip latency measurements
+// ------------------------------------------------------------
+
+static void benchLatency (const int node)
+{
+    unsigned data;
+    double   t0;
+    uint64_t c0;
+
+    t0 = nowSecs(); c0 = nodeCycle(node);
+    for (int i = 0; i < iters; i++)
+    {
+        VWrite((i << 2) & BENCH_MEM_MASK, i, 0, node);
+    }
+    latWrite.ns     = (nowSecs() - t0) * 1e9 / iters;
+    latWrite.cycles = (double)(nodeCycle(node) - c0) / iters;
+
+    t0 = nowSecs(); c0 = nodeCycle(node);
+    for (int i = 0; i < iters; i++)
+    {
+        VRead((i << 2) & BENCH_MEM_MASK, &data, 0, node);
+    }
+    latRead.ns      = (nowSecs() - t0) * 1e9 / iters;
+    latRead.cycles  = (double)(nodeCycle(node) - c0) / iters;
+
+    t0 = nowSecs(); c0 = nodeCycle(node);
+    for (int i = 0; i < iters; i++)
+    {
+        VTick(1, node);
+    }
+    latTick.ns      = (nowSecs() - t0) * 1e9 / iters;
+    latTick.cycles  = (double)(nodeCycle(node) - c0) / iters;
+}
+
+// ------------------------------------------------------------
+// Burst throughput measurements, for lengths of powers of 2
+// up to BENCH_MAX_BURST. Each length moves the same number of
+// words, as alternating write and read bursts.
+// ------------------------------------------------------------
+
+static void benchBurst (const int node)
+{
+    static uint32_t wbuf[BENCH_MAX_BURST];
+    static uint32_t rbuf[BENCH_MAX_BURST];
+
+    for (unsigned len = 1; len <= BENCH_MAX_BURST; len <<= 1)
+    {
+        int      reps = iters / len > 8 ? iters / len : 8;
+        double   t0, secs;
+        uint64_t c0, cycles;
+
+        t0 = nowSecs(); c0 = nodeCycle(node);
+        for (int i = 0; i < reps; i++)
+        {
+            VBurstWrite(0, wbuf, len, node);
+            VBurstRead (0, rbuf, len, node);
+        }
+        secs   = nowSecs() - t0;
+        cycles = nodeCycle(node) - c0;
+
+        burstRes[numBurst].len             = len;
+        burstRes[numBurst].mbytes_per_sec  = (double)reps * 2 * len * 4 / secs / 1e6;
+        burstRes[numBurst].words_per_cycle = cycles ? (double)reps * 2 * len / cycles : 0.0;
+        numBurst++;
+    }
+}
+
+// ------------------------------------------------------------
+// Node scaling measurement. Each node does alternating writes
+// and reads.
+// ------------------------------------------------------------
+
+static void benchScaling (const int node)
+{
+    unsigned data;
+    double   t0 = nowSecs();
+
+    for (int i = 0; i < iters; i++)
+    {
+        VWrite((i << 2) & BENCH_MEM_MASK, i,     0, node);
+        VRead ((i << 2) & BENCH_MEM_MASK, &data, 0, node);
+    }
+
+    nodeSecs[node] = nowSecs() - t0;
+    nodeTxns[node] = 2 * (uint64_t)iters;
+}
+
+// ------------------------------------------------------------
+// Write results to JSON file
+// ------------------------------------------------------------
+
+static void benchReport (void)
+{
+    char    *fname = getenv("VPROC_BENCH_FILE");
+    FILE    *fp;
+    double   maxsecs = 0.0;
+    uint64_t txns    = 0;
+
+    if (fname == NULL || fname[0] == '\0')
+    {
+        fname = BENCH_DEFAULT_FILE;
+    }
+
+    if ((fp = fopen(fname, "w")) == NULL)
+    {
+        VPrint("***Error: failed to open %s for writing\n", fname);
+        return;
+    }
+
+    for (int node = 0; node < numNodes; node++)
+    {
+        maxsecs = nodeSecs[node] > maxsecs ? nodeSecs[node] : maxsecs;
+        txns   += nodeTxns[node];
+    }
+
+    fprintf(fp, "{\n  \"simulator\": \"%s\",\n  \"nodes\": %d,\n  \"iterations\": %d,\n", BENCH_SIM, numNodes, iters);
+
+    if (numNodes == 1)
+    {
+        fprintf(fp, "  \"latency_ns\": {\"write\": %.1f, \"read\": %.1f, \"tick\": %.1f},\n",
+                    latWrite.ns, latRead.ns, latTick.ns);
+        fprintf(fp, "  \"latency_cycles\": {\"write\": %.2f, \"read\": %.2f, \"tick\": %.2f},\n",
+                    latWrite.cycles, latRead.cycles, latTick.cycles);
+        fprintf(fp, "  \"burst\": [");
+        for (int idx = 0; idx < numBurst; idx++)
+        {
+            fprintf(fp, "%s\n    {\"len\": %u, \"mbytes_per_sec\": %.3f, \"words_per_cycle\": %.3f}",
+                        idx ? "," : "", burstRes[idx].len, burstRes[idx].mbytes_per_sec, burstRes[idx].words_per_cycle);
+        }
+        fprintf(fp, "\n  ],\n");
+    }
+
+    fprintf(fp, "  \"txns_per_sec\": %.1f\n}\n", maxsecs > 0.0 ? (double)txns / maxsecs : 0.0);
+
+    fclose(fp);
+
+    VPrint("Benchmark results written to %s\n", fname);
+}
+
+// ------------------------------------------------------------
+// Common benchmark entry point for all nodes
+// ------------------------------------------------------------
+
+static void benchMain (const int node)
+{
+    numNodes = envInt("VPROC_BENCH_NODES", 1);
+    iters    = envInt("VPROC_BENCH_ITERS", BENCH_DEFAULT_ITERS);
+
+    if (node >= numNodes)
+    {
+        VTick(GO_TO_SLEEP, node);
+    }
+
+    // Let all nodes come out of reset
+    VTick(10, node);
+
+    if (numNodes == 1)
+    {
+        benchLatency(node);
+        benchBurst(node);
+    }
+
+    benchScaling(node);
+
+    // Last node to finish writes the results
+    if (__atomic_add_fetch(&nodesDone, 1, __ATOMIC_ACQ_REL) == numNodes)
+    {
+        benchReport();
+    }
+
+    VWrite(BENCH_DONE_ADDR, 0, 0, node);
+
+    while (1)
+    {
+        VTick(GO_TO_SLEEP, node);
+    }
+}
+
+// ------------------------------------------------------------
+// VUserMainX entry points
+// ------------------------------------------------------------
+
+#define BENCH_MAIN(_n) void VUserMain##_n (void) { benchMain(_n); }
+
+BENCH_MAIN(0)  BENCH_MAIN(1)  BENCH_MAIN(2)  BENCH_MAIN(3)
+BENCH_MAIN(4)  BENCH_MAIN(5)  BENCH_MAIN(6)  BENCH_MAIN(7)
+BENCH_MAIN(8)  BENCH_MAIN(9)  BENCH_MAIN(10) BENCH_MAIN(11)
+BENCH_MAIN(12) BENCH_MAIN(13) BENCH_MAIN(14) BENCH_MAIN(15)
@@ -0,0 +1,407 @@
+//=====================================================================
+//
+// axi4mgr.c                                          Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// AXI4 manager BFM C API (see axi4mgr.h). Issued transactions are
+// kept, in issue order, on a queue per ID and direction. Completion
+// queue entries from the BFM, each a write response or a read data
+// beat with its ID, are matched with the oldest transaction on their
+// ID's queue, and completed transactions moved to a list of those
+// ready to reap.
+//
+//=====================================================================
+
+#include <string.h>
+#include "VUser.h"
+#include "axi4mgr.h"
+
+// Completion queue entries read from the BFM in one exchange
+#define AXI4MGR_POLL_MAX        128
+
+// Issued transactions for an ID and direction
+typedef struct {
+    Axi4MgrCmpl_t       txn  [AXI4MGR_MAX_PER_ID];
+    unsigned            beats[AXI4MGR_MAX_PER_ID];
+    unsigned            head;
+    unsigned            count;
+} Axi4MgrIdQ_t;
+
+// Per-node state
+typedef struct {
+    uint32_t            base;
+    unsigned            awfree;         // Last known free BFM queue entries
+    unsigned            arfree;
+    unsigned            wfree;
+    unsigned            wdepth;         // BFM write data queue depth, read on the first write
+    unsigned            outstanding;
+    Axi4MgrIdQ_t        rd[AXI4MGR_MAX_IDS];
+    Axi4MgrIdQ_t        wr[AXI4MGR_MAX_IDS];
+    Axi4MgrCmpl_t       done[2 * AXI4MGR_MAX_IDS * AXI4MGR_MAX_PER_ID];
+    unsigned            done_head;
+    unsigned            done_count;
+    VDeltaCmd_t         vec[2 * AXI4MGR_POLL_MAX + AXI4MGR_MAX_LEN + 4];
+} Axi4Mgr_t;
+
+static Axi4Mgr_t       *axi4Mgr[VP_MAX_NODES];
+
+#define AXI4MGR_DONE_SIZE       (2 * AXI4MGR_MAX_IDS * AXI4MGR_MAX_PER_ID)
+
+// -------------------------------------------------------------------------
+// Axi4MgrGet()
+//
+// Get a node's state, creating it with a base address of 0 if not
+// initialised
+// -------------------------------------------------------------------------
+
+static Axi4Mgr_t *Axi4MgrGet (const unsigned node)
+{
+    if (axi4Mgr[node] == NULL)
+    {
+        Axi4MgrInit(0, node);
+    }
+
+    return axi4Mgr[node];
+}
+
+// -------------------------------------------------------------------------
+// Axi4MgrCmd()
+//
+// Set a delta cycle command vector entry for a BFM register
+// -------------------------------------------------------------------------
+
+static void Axi4MgrCmd (Axi4Mgr_t *m, const unsigned idx, const uint32_t reg, const uint32_t data, const unsigned flags)
+{
+    m->vec[idx].addr  = m->base + reg;
+    m->vec[idx].data  = data;
+    m->vec[idx].flags = flags;
+}
+
+// -------------------------------------------------------------------------
+// Axi4MgrComplete()
+//
+// Match a completion queue entry with its transaction, moving the
+// transaction to the done list if complete
+// -------------------------------------------------------------------------
+
+static void Axi4MgrComplete (Axi4Mgr_t *m, const uint32_t hdr, const uint32_t data, const unsigned node)
+{
+    unsigned      id   = AXI4MGR_CHDR_ID(hdr);
+    int           read = (hdr & AXI4MGR_CHDR_READ) ? 1 : 0;
+    Axi4MgrIdQ_t *q;
+    Axi4MgrCmpl_t *t;
+    unsigned     *beats;
+
+    if (id >= AXI4MGR_MAX_IDS || (q = read ? &m->rd[id] : &m->wr[id])->count == 0)
+    {
+        VPrint("***Error: Axi4Mgr node %d unexpected %s completion for ID %d\n", node, read ? "read" : "write", id);
+        exit(1);
+    }
+
+    t     = &q->txn[q->head];
+    beats = &q->beats[q->head];
+
+    if (AXI4MGR_CHDR_RESP(hdr) > t->resp)
+    {
+        t->resp = AXI4MGR_CHDR_RESP(hdr);
+    }
+
+    if (read)
+    {
+        if (*beats < t->len)
+        {
+            t->data[*beats] = data;
+        }
+
+        (*beats)++;
+    }
+
+    if (hdr & AXI4MGR_CHDR_LAST)
+    {
+        if (read && *beats != t->len)
+        {
+            VPrint("***Error: Axi4Mgr node %d read ID %d tag %d had %d beats, expected %d\n", node, id, t->tag, *beats, t->len);
+        }
+
+        m->done[(m->done_head + m->done_count++) % AXI4MGR_DONE_SIZE] = *t;
+
+        q->head = (q->head + 1) % AXI4MGR_MAX_PER_ID;
+        q->count--;
+    }
+}
+
+// -------------------------------------------------------------------------
+// Axi4MgrPoll()
+//
+// Take the entries on the BFM's completion queue, first waiting for
+// there to be at least one if wait is set
+// -------------------------------------------------------------------------
+
+static void Axi4MgrPoll (Axi4Mgr_t *m, const int wait, const unsigned node)
+{
+    unsigned count;
+
+    if (wait)
+    {
+        // Clocked read, acknowledged by the BFM when it has completions
+        VRead(m->base + AXI4MGR_REG_CWAIT, &count, 0, node);
+    }
+    else
+    {
+        VRead(m->base + AXI4MGR_REG_CCOUNT, &count, 1, node);
+    }
+
+    while (count)
+    {
+        unsigned num = (count > AXI4MGR_POLL_MAX) ? AXI4MGR_POLL_MAX : count;
+
+        for (unsigned idx = 0; idx < num; idx++)
+        {
+            Axi4MgrCmd(m, 2*idx,   AXI4MGR_REG_CHDR,  0, VDELTA_READ);
+            Axi4MgrCmd(m, 2*idx+1, AXI4MGR_REG_CDATA, 0, VDELTA_READ);
+        }
+
+        VDeltaVec(m->vec, 2*num, node);
+
+        for (unsigned idx = 0; idx < num; idx++)
+        {
+            Axi4MgrComplete(m, m->vec[2*idx].data, m->vec[2*idx+1].data, node);
+        }
+
+        count -= num;
+    }
+}
+
+// -------------------------------------------------------------------------
+// Axi4MgrRoom()
+//
+// Wait until the BFM's queues have room for a command and, for writes,
+// len words of data, and there is room for another transaction on the
+// ID's queue. Returns -1, without waiting, if the write data queue can
+// never hold len words.
+// -------------------------------------------------------------------------
+
+static int Axi4MgrRoom (Axi4Mgr_t *m, Axi4MgrIdQ_t *q, const int write, const unsigned len, const unsigned node)
+{
+    if (write)
+    {
+        if (m->wdepth == 0)
+        {
+            VRead(m->base + AXI4MGR_REG_WDEPTH, &m->wdepth, 1, node);
+        }
+
+        if (len > m->wdepth)
+        {
+            VPrint("***Error: Axi4Mgr node %d write length (%d) exceeds the BFM write data queue depth (%d)\n",
+                   node, len, m->wdepth);
+            return -1;
+        }
+    }
+
+    // Wait for the oldest transaction on the ID's queue to complete
+    while (q->count == AXI4MGR_MAX_PER_ID)
+    {
+        Axi4MgrPoll(m, 1, node);
+    }
+
+    for (;;)
+    {
+        if (write ? (m->awfree && m->wfree >= len) : (m->arfree != 0))
+        {
+            return 0;
+        }
+
+        // Refresh the free counts from the BFM
+        Axi4MgrCmd(m, 0, AXI4MGR_REG_AWFREE, 0, VDELTA_READ);
+        Axi4MgrCmd(m, 1, AXI4MGR_REG_ARFREE, 0, VDELTA_READ);
+        Axi4MgrCmd(m, 2, AXI4MGR_REG_WFREE,  0, VDELTA_READ);
+        VDeltaVec(m->vec, 3, node);
+
+        m->awfree = m->vec[0].data;
+        m->arfree = m->vec[1].data;
+        m->wfree  = m->vec[2].data;
+
+        if (write ? (m->awfree && m->wfree >= len) : (m->arfree != 0))
+        {
+            return 0;
+        }
+
+        // Still no room, so let the bus progress a cycle, taking any completions
+        VTick(1, node);
+        Axi4MgrPoll(m, 0, node);
+    }
+}
+
+// -------------------------------------------------------------------------
+// Axi4MgrIssue()
+//
+// Issue a transaction
+// -------------------------------------------------------------------------
+
+static int Axi4MgrIssue (const int write, const unsigned id, const uint32_t addr, uint32_t *data, const unsigned len,
+                         const uint32_t tag, const unsigned node)
+{
+    Axi4Mgr_t     *m = Axi4MgrGet(node);
+    Axi4MgrIdQ_t  *q;
+    Axi4MgrCmpl_t *t;
+    unsigned       slot;
+    unsigned       num = 0;
+
+    if (id >= AXI4MGR_MAX_IDS || len == 0 || len > AXI4MGR_MAX_LEN)
+    {
+        VPrint("***Error: Axi4Mgr node %d bad %s ID (%d) or length (%d)\n", node, write ? "write" : "read", id, len);
+        return -1;
+    }
+
+    if (m->outstanding == AXI4MGR_DONE_SIZE)
+    {
+        VPrint("***Error: Axi4Mgr node %d has %d transactions not reaped\n", node, AXI4MGR_DONE_SIZE);
+        return -1;
+    }
+
+    q = write ? &m->wr[id] : &m->rd[id];
+
+    if (Axi4MgrRoom(m, q, write, len, node) < 0)
+    {
+        return -1;
+    }
+
+    slot            = (q->head + q->count++) % AXI4MGR_MAX_PER_ID;
+    t               = &q->txn[slot];
+    t->tag          = tag;
+    t->id           = id;
+    t->write        = write;
+    t->resp         = AXI4MGR_RESP_OKAY;
+    t->data         = write ? NULL : data;
+    t->len          = len;
+    q->beats[slot]  = 0;
+
+    m->outstanding++;
+
+    // Send the command, and any write data, as one vector of delta cycle register writes
+    Axi4MgrCmd(m, num++, AXI4MGR_REG_ADDR, addr,    VDELTA_WRITE);
+    Axi4MgrCmd(m, num++, AXI4MGR_REG_LEN,  len - 1, VDELTA_WRITE);
+    Axi4MgrCmd(m, num++, AXI4MGR_REG_ID,   id,      VDELTA_WRITE);
+
+    if (write)
+    {
+        for (unsigned idx = 0; idx < len; idx++)
+        {
+            Axi4MgrCmd(m, num++, (idx == len - 1) ? AXI4MGR_REG_WLAST : AXI4MGR_REG_WDATA, data[idx], VDELTA_WRITE);
+        }
+
+        Axi4MgrCmd(m, num++, AXI4MGR_REG_AWGO, 0, VDELTA_WRITE);
+
+        m->awfree--;
+        m->wfree -= len;
+    }
+    else
+    {
+        Axi4MgrCmd(m, num++, AXI4MGR_REG_ARGO, 0, VDELTA_WRITE);
+
+        m->arfree--;
+    }
+
+    VDeltaVec(m->vec, num, node);
+
+    return 0;
+}
+
+// =========================================================================
+// User API
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// Axi4MgrInit()
+//
+// Set the base address of the node's BFM registers
+// -------------------------------------------------------------------------
+
+void Axi4MgrInit (const uint32_t base, const unsigned node)
+{
+    if (axi4Mgr[node] == NULL)
+    {
+        axi4Mgr[node] = (Axi4Mgr_t *)calloc(1, sizeof(Axi4Mgr_t));
+    }
+
+    axi4Mgr[node]->base = base;
+}
+
+// -------------------------------------------------------------------------
+// Axi4MgrWrite()
+//
+// Issue a write transaction
+// -------------------------------------------------------------------------
+
+int Axi4MgrWrite (const unsigned id, const uint32_t addr, const uint32_t *data, const unsigned len, const uint32_t tag,
+                  const unsigned node)
+{
+    return Axi4MgrIssue(1, id, addr, (uint32_t *)data, len, tag, node);
+}
+
+// -------------------------------------------------------------------------
+// Axi4MgrRead()
+//
+// Issue a read transaction
+// -------------------------------------------------------------------------
+
+int Axi4MgrRead (const unsigned id, const uint32_t addr, uint32_t *data, const unsigned len, const uint32_t tag,
+                 const unsigned node)
+{
+    return Axi4MgrIssue(0, id, addr, data, len, tag, node);
+}
+
+// -------------------------------------------------------------------------
+// Axi4MgrReap()
+//
+// Reap completed transactions
+// -------------------------------------------------------------------------
+
+unsigned Axi4MgrReap (Axi4MgrCmpl_t *cmpl, const unsigned max, const int wait, const unsigned node)
+{
+    Axi4Mgr_t *m     = Axi4MgrGet(node);
+    unsigned   count = 0;
+
+    // Take what's available, waiting if asked, and if nothing is yet done
+    // but there are transactions in flight
+    Axi4MgrPoll(m, wait && m->done_count == 0 && m->outstanding != 0, node);
+
+    while (count < max && m->done_count)
+    {
+        cmpl[count++] = m->done[m->done_head];
+        m->done_head  = (m->done_head + 1) % AXI4MGR_DONE_SIZE;
+        m->done_count--;
+        m->outstanding--;
+    }
+
+    return count;
+}
+
+// -------------------------------------------------------------------------
+// Axi4MgrOutstanding()
+//
+// Number of transactions issued and not yet reaped
+// -------------------------------------------------------------------------
+
+unsigned Axi4MgrOutstanding (const unsigned node)
+{
+    return Axi4MgrGet(node)->outstanding;
+}
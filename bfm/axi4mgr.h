@@ -0,0 +1,118 @@
+//=====================================================================
+//
+// axi4mgr.h                                          Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// C API for the AXI4 manager BFM (axi4mgrbfm.v), with multiple
+// outstanding transactions. Transactions are issued with an AXI ID
+// and a user tag, without waiting for them to complete, and their
+// completions reaped later. Completions for different IDs may be in
+// any order, whilst those for the same ID (and direction) are in the
+// order issued.
+//
+// Issuing a transaction is a single exchange with the simulation, of
+// zero time register accesses, unless the BFM's queues are full, when
+// the node waits for room. Reaping may wait for at least one
+// transaction to complete.
+//
+// Compile with axi4mgr.c added to the user C sources.
+//
+//=====================================================================
+
+#ifndef _AXI4MGR_H_
+#define _AXI4MGR_H_
+
+#include <stdint.h>
+
+// Number of IDs (1 << IDWIDTH of the BFM)
+#ifndef AXI4MGR_MAX_IDS
+#define AXI4MGR_MAX_IDS         16
+#endif
+
+// Transactions in flight per ID, in each direction
+#ifndef AXI4MGR_MAX_PER_ID
+#define AXI4MGR_MAX_PER_ID      16
+#endif
+
+// Maximum transaction length, in words
+#define AXI4MGR_MAX_LEN         256
+
+// BFM register byte offsets
+#define AXI4MGR_REG_ADDR        0x00
+#define AXI4MGR_REG_LEN         0x04
+#define AXI4MGR_REG_ID          0x08
+#define AXI4MGR_REG_WDATA       0x10
+#define AXI4MGR_REG_WLAST       0x14
+#define AXI4MGR_REG_AWGO        0x18
+#define AXI4MGR_REG_ARGO        0x1c
+#define AXI4MGR_REG_CHDR        0x20
+#define AXI4MGR_REG_CDATA       0x24
+#define AXI4MGR_REG_CCOUNT      0x28
+#define AXI4MGR_REG_CWAIT       0x2c
+#define AXI4MGR_REG_AWFREE      0x30
+#define AXI4MGR_REG_ARFREE      0x34
+#define AXI4MGR_REG_WFREE       0x38
+#define AXI4MGR_REG_WDEPTH      0x3c
+
+// Completion header fields
+#define AXI4MGR_CHDR_VALID      0x80000000
+#define AXI4MGR_CHDR_READ       0x40000000
+#define AXI4MGR_CHDR_LAST       0x20000000
+#define AXI4MGR_CHDR_RESP(_h)   (((_h) >> 24) & 0x3)
+#define AXI4MGR_CHDR_ID(_h)     ((_h) & 0xffff)
+
+// AXI responses
+#define AXI4MGR_RESP_OKAY       0
+#define AXI4MGR_RESP_EXOKAY     1
+#define AXI4MGR_RESP_SLVERR     2
+#define AXI4MGR_RESP_DECERR     3
+
+// Completed transaction
+typedef struct {
+    uint32_t            tag;            // User tag, as issued
+    unsigned            id;
+    int                 write;
+    unsigned            resp;           // Worst response of the transaction's beats
+    uint32_t           *data;           // Read data buffer, as issued
+    unsigned            len;            // Length in words
+} Axi4MgrCmpl_t;
+
+// Set the base address of the node's BFM registers
+extern void     Axi4MgrInit        (const uint32_t base, const unsigned node);
+
+// Issue a write or read of len words at addr, with an ID and tag,
+// returning 0, or -1 on a bad argument (including a write longer than
+// the BFM's write data queue). Write data is copied, and read
+// data is placed in data, which must remain valid until complete.
+extern int      Axi4MgrWrite       (const unsigned id, const uint32_t addr, const uint32_t *data, const unsigned len,
+                                    const uint32_t tag, const unsigned node);
+extern int      Axi4MgrRead        (const unsigned id, const uint32_t addr, uint32_t *data, const unsigned len,
+                                    const uint32_t tag, const unsigned node);
+
+// Reap up to max completed transactions, returning the number reaped.
+// If wait is non-zero and no transactions have completed, waits for at
+// least one (if any are in flight).
+extern unsigned Axi4MgrReap        (Axi4MgrCmpl_t *cmpl, const unsigned max, const int wait, const unsigned node);
+
+// Number of transactions issued and not yet reaped
+extern unsigned Axi4MgrOutstanding (const unsigned node);
+
+#endif
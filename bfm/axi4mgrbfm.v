@@ -0,0 +1,447 @@
+// ====================================================================
+//
+// Verilog AXI4 manager bus functional model (BFM) wrapper for VProc,
+// with multiple outstanding transactions.
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// Implements a 32-bit AXI4 manager interface, with AxID signals and
+// out-of-order completion between IDs. Also has a 32-bit vectored irq
+// input.
+//
+// Rather than the VProc node accessing the AXI bus directly, one
+// access at a time, the node writes transaction commands and write
+// data into queues, and reads completions (write responses and read
+// data beats, with their IDs) from a completion queue, using zero
+// time (delta cycle) register accesses. The AXI channels are driven
+// from the queues, with up to RD_OUTSTANDING reads and WR_OUTSTANDING
+// writes in flight. The C API in axi4mgr.c/.h uses these registers.
+//
+// Registers (byte offsets, decoded from the VProc address bits 7:2):
+//
+//   0x00 ADDR    (W) : transaction address
+//   0x04 LEN     (W) : transaction length, in beats less one (AxLEN)
+//   0x08 ID      (W) : transaction ID
+//   0x10 WDATA   (W) : queue a write data beat (with the byte enables)
+//   0x14 WLAST   (W) : queue the last write data beat of a transaction
+//   0x18 AWGO    (W) : queue a write command with ADDR, LEN and ID
+//   0x1c ARGO    (W) : queue a read command with ADDR, LEN and ID
+//   0x20 CHDR    (R) : head completion header (0 if none):
+//                        bit 31 valid, bit 30 read (else write),
+//                        bit 29 last, bits 25:24 resp, low bits ID
+//   0x24 CDATA   (R) : head completion read data, and remove it
+//   0x28 CCOUNT  (R) : number of completions queued
+//   0x2c CWAIT   (R) : number of completions queued, waiting until
+//                      non-zero (not for delta cycle reads)
+//   0x30 AWFREE  (R) : free entries in the write command queue
+//   0x34 ARFREE  (R) : free entries in the read command queue
+//   0x38 WFREE   (R) : free entries in the write data queue
+//   0x3c WDEPTH  (R) : depth of the write data queue, which limits the
+//                      length of a write transaction
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ====================================================================
+
+`ifndef VPROC_BYTE_ENABLE
+`define VPROC_BYTE_ENABLE
+`endif
+
+`include "vprocdefs.vh"
+
+module axi4mgrbfm
+#(parameter ADDRWIDTH         = 32,       // For future proofing. Do not change
+            DATAWIDTH         = 32,       // For future proofing. Do not change
+            IDWIDTH           = 4,        // Valid ranges => 1 to 16
+            IRQWIDTH          = 32,       // Valid ranges => 1 to 32
+            RD_OUTSTANDING    = 8,        // Maximum reads in flight
+            WR_OUTSTANDING    = 8,        // Maximum writes in flight
+            CMD_LOG2          = 4,        // Log2 of command queue depths
+            WDATA_LOG2        = 8,        // Log2 of write data queue depth
+            COMP_LOG2         = 8,        // Log2 of completion queue depth
+            NODE              = 0
+)
+(
+  input                       clk,
+
+  // Write address channel
+  output       [IDWIDTH-1:0]  awid,
+  output     [ADDRWIDTH-1:0]  awaddr,
+  output               [7:0]  awlen,
+  output               [2:0]  awsize,
+  output               [1:0]  awburst,
+  output               [2:0]  awprot,
+  output                      awvalid,
+  input                       awready,
+
+  // Write Data channel
+  output     [DATAWIDTH-1:0]  wdata,
+  output               [3:0]  wstrb,
+  output                      wlast,
+  output                      wvalid,
+  input                       wready,
+
+  // Write response channel
+  input        [IDWIDTH-1:0]  bid,
+  input                [1:0]  bresp,
+  input                       bvalid,
+  output                      bready,
+
+  // Read address channel
+  output       [IDWIDTH-1:0]  arid,
+  output     [ADDRWIDTH-1:0]  araddr,
+  output               [7:0]  arlen,
+  output               [2:0]  arsize,
+  output               [1:0]  arburst,
+  output               [2:0]  arprot,
+  output                      arvalid,
+  input                       arready,
+
+  // Read data/response channel
+  input        [IDWIDTH-1:0]  rid,
+  input      [DATAWIDTH-1:0]  rdata,
+  input                [1:0]  rresp,
+  input                       rlast,
+  input                       rvalid,
+  output                      rready,
+
+  // Interrupt request (non-AXI side bus)
+  input       [IRQWIDTH-1:0]  irq
+);
+
+// ---------------------------------------------------------
+// Local parameters
+// ---------------------------------------------------------
+
+localparam                    CMDDEPTH     = 1 << CMD_LOG2;
+localparam                    WDATADEPTH   = 1 << WDATA_LOG2;
+localparam                    COMPDEPTH    = 1 << COMP_LOG2;
+
+// Command queue entry of {ID, LEN, ADDR}, write data entry of
+// {strobes, last, data}, and completion entry of {read, last, resp, ID, data}
+localparam                    CMDWIDTH     = IDWIDTH + 8 + ADDRWIDTH;
+localparam                    WDATAWIDTH   = 4 + 1 + DATAWIDTH;
+localparam                    COMPWIDTH    = 1 + 1 + 2 + IDWIDTH + DATAWIDTH;
+
+// Register word addresses
+localparam                    REG_ADDR     = 6'h00;
+localparam                    REG_LEN      = 6'h01;
+localparam                    REG_ID       = 6'h02;
+localparam                    REG_WDATA    = 6'h04;
+localparam                    REG_WLAST    = 6'h05;
+localparam                    REG_AWGO     = 6'h06;
+localparam                    REG_ARGO     = 6'h07;
+localparam                    REG_CHDR     = 6'h08;
+localparam                    REG_CDATA    = 6'h09;
+localparam                    REG_CCOUNT   = 6'h0a;
+localparam                    REG_CWAIT    = 6'h0b;
+localparam                    REG_AWFREE   = 6'h0c;
+localparam                    REG_ARFREE   = 6'h0d;
+localparam                    REG_WFREE    = 6'h0e;
+localparam                    REG_WDEPTH   = 6'h0f;
+
+// ---------------------------------------------------------
+// Signal and register declarations
+// ---------------------------------------------------------
+
+// Virtual processor memory mapped address port signals
+wire                   [31:0] vpdataout;
+wire                   [31:0] vpdatain;
+wire                   [31:0] vpaddr;
+wire                          vpwe;
+wire                          vprd;
+wire                          vpwrack;
+wire                          vprdack;
+wire                    [3:0] vpbyteenable;
+
+// Delta cycle signals
+wire                          update;
+reg                           updateresponse;
+
+// Command registers
+reg           [ADDRWIDTH-1:0] cmdaddr;
+reg                     [7:0] cmdlen;
+reg             [IDWIDTH-1:0] cmdid;
+
+// Latched register read data
+reg                    [31:0] rdreg;
+
+// Queues. The write pointers of the command and write data queues, and
+// the read pointer of the completion queue, are updated by the register
+// accesses, and the others by the AXI channels, with an extra pointer
+// bit to distinguish full from empty.
+reg            [CMDWIDTH-1:0] awq [0:CMDDEPTH-1];
+reg              [CMD_LOG2:0] awq_wp;
+reg              [CMD_LOG2:0] awq_rp;
+
+reg            [CMDWIDTH-1:0] arq [0:CMDDEPTH-1];
+reg              [CMD_LOG2:0] arq_wp;
+reg              [CMD_LOG2:0] arq_rp;
+
+reg          [WDATAWIDTH-1:0] wq  [0:WDATADEPTH-1];
+reg            [WDATA_LOG2:0] wq_wp;
+reg            [WDATA_LOG2:0] wq_rp;
+
+reg           [COMPWIDTH-1:0] cq  [0:COMPDEPTH-1];
+reg             [COMP_LOG2:0] cq_wp;
+reg             [COMP_LOG2:0] cq_rp;
+
+wire             [CMD_LOG2:0] awq_cnt      = awq_wp - awq_rp;
+wire             [CMD_LOG2:0] arq_cnt      = arq_wp - arq_rp;
+wire           [WDATA_LOG2:0] wq_cnt       = wq_wp  - wq_rp;
+wire            [COMP_LOG2:0] cq_cnt       = cq_wp  - cq_rp;
+
+wire           [CMDWIDTH-1:0] awq_head     = awq[awq_rp[CMD_LOG2-1:0]];
+wire           [CMDWIDTH-1:0] arq_head     = arq[arq_rp[CMD_LOG2-1:0]];
+wire         [WDATAWIDTH-1:0] wq_head      = wq[wq_rp[WDATA_LOG2-1:0]];
+wire          [COMPWIDTH-1:0] cq_head      = cq[cq_rp[COMP_LOG2-1:0]];
+wire                   [15:0] cq_head_id   = cq_head[IDWIDTH+DATAWIDTH-1:DATAWIDTH];
+
+// Transactions in flight
+integer                       rd_out;
+integer                       wr_out;
+
+// Channel handshakes
+wire                          awfire       = awvalid & awready;
+wire                          wfire        = wvalid  & wready;
+wire                          bfire        = bvalid  & bready;
+wire                          arfire       = arvalid & arready;
+wire                          rfire        = rvalid  & rready;
+
+// ---------------------------------------------------------
+// Combinatorial logic
+// ---------------------------------------------------------
+
+// Commands are issued from the head of the command queues while
+// within the outstanding transaction limits
+assign awvalid                = (awq_cnt != 0) && (wr_out < WR_OUTSTANDING);
+assign arvalid                = (arq_cnt != 0) && (rd_out < RD_OUTSTANDING);
+
+// The address channel ports are only valid when their valid signals active,
+// else driven X. This ensures external IP does not use invalid held values.
+assign awid                   = awvalid ? awq_head[CMDWIDTH-1:ADDRWIDTH+8]    : {IDWIDTH{1'bx}};
+assign awlen                  = awvalid ? awq_head[ADDRWIDTH+7:ADDRWIDTH]     : 8'hxx;
+assign awaddr                 = awvalid ? awq_head[ADDRWIDTH-1:0]             : {ADDRWIDTH{1'bx}};
+assign arid                   = arvalid ? arq_head[CMDWIDTH-1:ADDRWIDTH+8]    : {IDWIDTH{1'bx}};
+assign arlen                  = arvalid ? arq_head[ADDRWIDTH+7:ADDRWIDTH]     : 8'hxx;
+assign araddr                 = arvalid ? arq_head[ADDRWIDTH-1:0]             : {ADDRWIDTH{1'bx}};
+
+// Word sized incrementing bursts, with no protection
+assign awsize                 = 3'b010;
+assign arsize                 = 3'b010;
+assign awburst                = 2'b01;
+assign arburst                = 2'b01;
+assign awprot                 = 3'b000;
+assign arprot                 = 3'b000;
+
+// Write data from the head of the write data queue
+assign wvalid                 = (wq_cnt != 0);
+assign wstrb                  = wq_head[WDATAWIDTH-1:DATAWIDTH+1];
+assign wlast                  = wvalid & wq_head[DATAWIDTH];
+assign wdata                  = wvalid ? wq_head[DATAWIDTH-1:0]               : {DATAWIDTH{1'bx}};
+
+// Responses and read data accepted while there is room for both
+// in the completion queue
+assign bready                 = (cq_cnt <= COMPDEPTH - 2);
+assign rready                 = (cq_cnt <= COMPDEPTH - 2);
+
+// Register accesses are made at the VProc update, so acknowledged
+// straight away, except for a wait on the completion count, which is
+// acknowledged when there are completions, returning the current count.
+assign vpwrack                = vpwe;
+assign vprdack                = vprd & (vpaddr[7:2] != REG_CWAIT || cq_cnt != 0);
+assign vpdatain               = (vpaddr[7:2] == REG_CWAIT) ? cq_cnt : rdreg;
+
+// ---------------------------------------------------------
+// Initialise the internal state.
+// ---------------------------------------------------------
+
+initial
+begin
+  `MINDELAY
+  updateresponse              <= 1'b1;
+  awq_wp                      <= 0;
+  awq_rp                      <= 0;
+  arq_wp                      <= 0;
+  arq_rp                      <= 0;
+  wq_wp                       <= 0;
+  wq_rp                       <= 0;
+  cq_wp                       <= 0;
+  cq_rp                       <= 0;
+  rd_out                      <= 0;
+  wr_out                      <= 0;
+  rdreg                       <= 0;
+end
+
+// ---------------------------------------------------------
+// Synchronous process for the AXI channels, taking commands and
+// write data from their queues, and putting responses and read data
+// on the completion queue
+// ---------------------------------------------------------
+
+always @(posedge clk)
+begin
+
+  if (awfire)
+  begin
+    awq_rp                    <= awq_rp + 1;
+  end
+
+  if (arfire)
+  begin
+    arq_rp                    <= arq_rp + 1;
+  end
+
+  if (wfire)
+  begin
+    wq_rp                     <= wq_rp + 1;
+  end
+
+  // Read data and write responses are queued in the order they
+  // arrive, which may be out of order between IDs
+  if (rfire)
+  begin
+    cq[cq_wp[COMP_LOG2-1:0]]  <= {1'b1, rlast, rresp, rid, rdata};
+  end
+
+  if (bfire)
+  begin
+    cq[(cq_wp + rfire) & (COMPDEPTH-1)] <= {1'b0, 1'b1, bresp, bid, {DATAWIDTH{1'b0}}};
+  end
+
+  cq_wp                       <= cq_wp + rfire + bfire;
+
+  // Count the transactions in flight
+  wr_out                      <= wr_out + awfire - bfire;
+  rd_out                      <= rd_out + arfire - (rfire & rlast);
+
+end
+
+// ---------------------------------------------------------
+// Delta cycle update process, making the register accesses.
+// Delta cycle accesses are complete when the update is
+// responded to, so all the register accesses are made here.
+// ---------------------------------------------------------
+
+always @(update)
+begin
+
+  if (vpwe === 1'b1)
+  begin
+    case (vpaddr[7:2])
+    REG_ADDR:   cmdaddr       = vpdataout;
+    REG_LEN:    cmdlen        = vpdataout[7:0];
+    REG_ID:     cmdid         = vpdataout[IDWIDTH-1:0];
+
+    REG_WDATA, REG_WLAST:
+    begin
+      if (wq_cnt == WDATADEPTH)
+      begin
+        $display("***Error: axi4mgrbfm node %0d write data queue overflow at time %0t", NODE, $time);
+      end
+      else
+      begin
+        wq[wq_wp[WDATA_LOG2-1:0]] = {vpbyteenable, vpaddr[7:2] == REG_WLAST, vpdataout};
+        wq_wp                 = wq_wp + 1;
+      end
+    end
+
+    REG_AWGO:
+    begin
+      if (awq_cnt == CMDDEPTH)
+      begin
+        $display("***Error: axi4mgrbfm node %0d write command queue overflow at time %0t", NODE, $time);
+      end
+      else
+      begin
+        awq[awq_wp[CMD_LOG2-1:0]] = {cmdid, cmdlen, cmdaddr};
+        awq_wp                = awq_wp + 1;
+      end
+    end
+
+    REG_ARGO:
+    begin
+      if (arq_cnt == CMDDEPTH)
+      begin
+        $display("***Error: axi4mgrbfm node %0d read command queue overflow at time %0t", NODE, $time);
+      end
+      else
+      begin
+        arq[arq_wp[CMD_LOG2-1:0]] = {cmdid, cmdlen, cmdaddr};
+        arq_wp                = arq_wp + 1;
+      end
+    end
+    endcase
+  end
+  else if (vprd === 1'b1)
+  begin
+    case (vpaddr[7:2])
+    REG_CHDR:   rdreg         = (cq_cnt == 0) ? 32'h0 :
+                                {1'b1, cq_head[COMPWIDTH-1:COMPWIDTH-2], 3'h0,
+                                 cq_head[COMPWIDTH-3:COMPWIDTH-4], 8'h00, cq_head_id};
+
+    REG_CDATA:
+    begin
+      rdreg                   = cq_head[DATAWIDTH-1:0];
+
+      if (cq_cnt != 0)
+      begin
+        cq_rp                 = cq_rp + 1;
+      end
+    end
+
+    REG_CCOUNT: rdreg         = cq_cnt;
+    REG_AWFREE: rdreg         = CMDDEPTH   - awq_cnt;
+    REG_ARFREE: rdreg         = CMDDEPTH   - arq_cnt;
+    REG_WFREE:  rdreg         = WDATADEPTH - wq_cnt;
+    REG_WDEPTH: rdreg         = WDATADEPTH;
+    default:    rdreg         = 32'h0;
+    endcase
+  end
+
+  updateresponse              <= ~updateresponse;
+end
+
+// ---------------------------------------------------------
+// Virtual Processor
+// ---------------------------------------------------------
+
+  VProc #(
+           .INT_WIDTH         (IRQWIDTH)
+         ) vp
+         (
+           .Clk               (clk),
+
+           .Addr              (vpaddr),
+
+           .DataOut           (vpdataout),
+           .WE                (vpwe),
+           .WRAck             (vpwrack),
+
+           .BE                (vpbyteenable),
+
+           .DataIn            (vpdatain),
+           .RD                (vprd),
+           .RDAck             (vprdack),
+
+           .Interrupt         (irq),
+
+           .Update            (update),
+           .UpdateResponse    (updateresponse),
+           .Node              (NODE[3:0])
+         );
+
+endmodule
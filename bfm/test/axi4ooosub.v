@@ -0,0 +1,333 @@
+// =============================================================
+//
+// AXI4 subordinate model with out-of-order responses, for
+// testing the axi4mgrbfm VProc wrapper
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// A memory of 2^MEM_LOG2 words, accepting up to 2^PEND_LOG2
+// transactions in each direction. Each write response and read
+// burst is given a random delay of up to MAXDELAY cycles, and,
+// of those that are due, a random one is sent next, as long as
+// it is the oldest of its ID, so that responses are out of
+// order between IDs, and in order for each ID. Read bursts are
+// not interleaved. Only word sized incrementing bursts are
+// supported, and all responses are OKAY.
+//
+// Internal state is updated with blocking assignments, and the
+// outputs are registered with non-blocking assignments.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// =============================================================
+
+module axi4ooosub
+#(parameter IDWIDTH           = 4,
+            MEM_LOG2          = 14,       // Log2 of memory size, in words
+            PEND_LOG2         = 4,        // Log2 of transactions held in each direction
+            MAXDELAY          = 32,       // Maximum response delay, in cycles
+            SEED              = 1
+)
+(
+  input                       clk,
+
+  // Write address channel
+  input        [IDWIDTH-1:0]  awid,
+  input               [31:0]  awaddr,
+  input                [7:0]  awlen,
+  input                       awvalid,
+  output reg                  awready,
+
+  // Write Data channel
+  input               [31:0]  wdata,
+  input                [3:0]  wstrb,
+  input                       wlast,
+  input                       wvalid,
+  output reg                  wready,
+
+  // Write response channel
+  output reg   [IDWIDTH-1:0]  bid,
+  output               [1:0]  bresp,
+  output reg                  bvalid,
+  input                       bready,
+
+  // Read address channel
+  input        [IDWIDTH-1:0]  arid,
+  input               [31:0]  araddr,
+  input                [7:0]  arlen,
+  input                       arvalid,
+  output reg                  arready,
+
+  // Read data/response channel
+  output reg   [IDWIDTH-1:0]  rid,
+  output reg          [31:0]  rdata,
+  output               [1:0]  rresp,
+  output reg                  rlast,
+  output reg                  rvalid,
+  input                       rready
+);
+
+// ---------------------------------------------------------
+// Local parameters
+// ---------------------------------------------------------
+
+localparam                    MEMDEPTH     = 1 << MEM_LOG2;
+localparam                    PENDING      = 1 << PEND_LOG2;
+
+// ---------------------------------------------------------
+// Signal and register declarations
+// ---------------------------------------------------------
+
+reg                    [31:0] mem     [0:MEMDEPTH-1];
+
+// Write commands waiting for their data, in order of arrival
+reg             [IDWIDTH-1:0] wc_id   [0:PENDING-1];
+reg                    [31:0] wc_addr [0:PENDING-1];
+integer                       wc_wp;
+integer                       wc_rp;
+integer                       wbeat;
+
+// Write responses, and read commands, waiting to be sent, with
+// their order of arrival and due cycle
+reg                           b_vld   [0:PENDING-1];
+reg             [IDWIDTH-1:0] b_id    [0:PENDING-1];
+integer                       b_seq   [0:PENDING-1];
+integer                       b_due   [0:PENDING-1];
+integer                       b_cnt;
+
+reg                           r_vld   [0:PENDING-1];
+reg             [IDWIDTH-1:0] r_id    [0:PENDING-1];
+reg                    [31:0] r_addr  [0:PENDING-1];
+reg                     [7:0] r_len   [0:PENDING-1];
+integer                       r_seq   [0:PENDING-1];
+integer                       r_due   [0:PENDING-1];
+integer                       r_cnt;
+
+// Write response, and read burst, being sent
+reg                           bcur_vld;
+reg             [IDWIDTH-1:0] bcur_id;
+
+reg                           rcur_vld;
+reg             [IDWIDTH-1:0] rcur_id;
+reg                    [31:0] rcur_addr;
+reg                     [7:0] rcur_len;
+integer                       rcur_beat;
+
+integer                       cycle;
+integer                       seq;
+integer                       rnd;
+integer                       idx;
+integer                       jdx;
+integer                       sel;
+integer                       start;
+reg                           oldest;
+reg                    [31:0] mask;
+
+// ---------------------------------------------------------
+// Combinatorial logic
+// ---------------------------------------------------------
+
+assign bresp                  = 2'b00;
+assign rresp                  = 2'b00;
+
+// ---------------------------------------------------------
+// Initialise the internal state.
+// ---------------------------------------------------------
+
+initial
+begin
+  awready                     = 1'b0;
+  wready                      = 1'b0;
+  arready                     = 1'b0;
+  bvalid                      = 1'b0;
+  rvalid                      = 1'b0;
+  rlast                       = 1'b0;
+
+  wc_wp                       = 0;
+  wc_rp                       = 0;
+  wbeat                       = 0;
+  b_cnt                       = 0;
+  r_cnt                       = 0;
+  bcur_vld                    = 1'b0;
+  rcur_vld                    = 1'b0;
+  cycle                       = 0;
+  seq                         = 0;
+  rnd                         = SEED;
+
+  for (idx = 0; idx < PENDING; idx = idx + 1)
+  begin
+    b_vld[idx]                = 1'b0;
+    r_vld[idx]                = 1'b0;
+  end
+end
+
+// ---------------------------------------------------------
+// Synchronous process
+// ---------------------------------------------------------
+
+always @(posedge clk)
+begin
+
+  cycle                       = cycle + 1;
+
+  // Write commands are held until their data arrives
+  if (awvalid && awready)
+  begin
+    wc_id[wc_wp % PENDING]    = awid;
+    wc_addr[wc_wp % PENDING]  = awaddr;
+    wc_wp                     = wc_wp + 1;
+  end
+
+  // Write data is written to memory, and a response queued after the
+  // last beat
+  if (wvalid && wready)
+  begin
+    mask                      = {{8{wstrb[3]}}, {8{wstrb[2]}}, {8{wstrb[1]}}, {8{wstrb[0]}}};
+    idx                       = ((wc_addr[wc_rp % PENDING] >> 2) + wbeat) % MEMDEPTH;
+    mem[idx]                  = (mem[idx] & ~mask) | (wdata & mask);
+    wbeat                     = wbeat + 1;
+
+    if (wlast)
+    begin
+      for (sel = 0; b_vld[sel]; sel = sel + 1);
+
+      b_vld[sel]              = 1'b1;
+      b_id[sel]               = wc_id[wc_rp % PENDING];
+      b_seq[sel]              = seq;
+      b_due[sel]              = cycle + {$random(rnd)} % MAXDELAY;
+      seq                     = seq + 1;
+      b_cnt                   = b_cnt + 1;
+      wc_rp                   = wc_rp + 1;
+      wbeat                   = 0;
+    end
+  end
+
+  // Read commands are queued
+  if (arvalid && arready)
+  begin
+    for (sel = 0; r_vld[sel]; sel = sel + 1);
+
+    r_vld[sel]                = 1'b1;
+    r_id[sel]                 = arid;
+    r_addr[sel]               = araddr;
+    r_len[sel]                = arlen;
+    r_seq[sel]                = seq;
+    r_due[sel]                = cycle + {$random(rnd)} % MAXDELAY;
+    seq                       = seq + 1;
+    r_cnt                     = r_cnt + 1;
+  end
+
+  // Move on from an accepted write response or read beat
+  if (bvalid && bready)
+  begin
+    bcur_vld                  = 1'b0;
+  end
+
+  if (rvalid && rready)
+  begin
+    rcur_beat                 = rcur_beat + 1;
+
+    if (rlast)
+    begin
+      rcur_vld                = 1'b0;
+    end
+  end
+
+  // Pick the next write response from those due which are the oldest
+  // for their ID, starting from a random entry
+  if (!bcur_vld)
+  begin
+    start                     = {$random(rnd)} % PENDING;
+
+    for (jdx = 0; jdx < PENDING && !bcur_vld; jdx = jdx + 1)
+    begin
+      sel                     = (start + jdx) % PENDING;
+
+      if (b_vld[sel] && b_due[sel] <= cycle)
+      begin
+        oldest                = 1'b1;
+
+        for (idx = 0; idx < PENDING; idx = idx + 1)
+        begin
+          if (b_vld[idx] && b_id[idx] == b_id[sel] && b_seq[idx] < b_seq[sel])
+          begin
+            oldest            = 1'b0;
+          end
+        end
+
+        if (oldest)
+        begin
+          bcur_vld            = 1'b1;
+          bcur_id             = b_id[sel];
+          b_vld[sel]          = 1'b0;
+          b_cnt               = b_cnt - 1;
+        end
+      end
+    end
+  end
+
+  // Likewise for the next read burst
+  if (!rcur_vld)
+  begin
+    start                     = {$random(rnd)} % PENDING;
+
+    for (jdx = 0; jdx < PENDING && !rcur_vld; jdx = jdx + 1)
+    begin
+      sel                     = (start + jdx) % PENDING;
+
+      if (r_vld[sel] && r_due[sel] <= cycle)
+      begin
+        oldest                = 1'b1;
+
+        for (idx = 0; idx < PENDING; idx = idx + 1)
+        begin
+          if (r_vld[idx] && r_id[idx] == r_id[sel] && r_seq[idx] < r_seq[sel])
+          begin
+            oldest            = 1'b0;
+          end
+        end
+
+        if (oldest)
+        begin
+          rcur_vld            = 1'b1;
+          rcur_id             = r_id[sel];
+          rcur_addr           = r_addr[sel];
+          rcur_len            = r_len[sel];
+          rcur_beat           = 0;
+          r_vld[sel]          = 1'b0;
+          r_cnt               = r_cnt - 1;
+        end
+      end
+    end
+  end
+
+  // Register the outputs. There is always room for a command accepted
+  // with the ready signals set here.
+  awready                     <= (wc_wp - wc_rp + b_cnt + bcur_vld) < PENDING;
+  wready                      <= (wc_wp != wc_rp);
+  arready                     <= (r_cnt < PENDING);
+
+  bvalid                      <= bcur_vld;
+  bid                         <= bcur_id;
+
+  rvalid                      <= rcur_vld;
+  rid                         <= rcur_id;
+  rdata                       <= mem[((rcur_addr >> 2) + rcur_beat) % MEMDEPTH];
+  rlast                       <= rcur_vld && (rcur_beat == rcur_len);
+
+end
+
+endmodule
@@ -0,0 +1,207 @@
+// =============================================================
+//
+// Top level test environment for the Verilog AXI4 manager BFM
+// VProc wrapper, with multiple outstanding transactions
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// The manager is connected to a subordinate model that returns
+// responses out of order between IDs. The write data queue is
+// reduced to 64 words (WDATA_LOG2 of 6), which the user code
+// relies on to test the write length limit.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// =============================================================
+
+`timescale 1 ns / 10 ps
+
+module testaxi4mgr
+#(parameter CLKPERIOD = 10,
+            STOPCOUNT = 100000,
+            FINISH    = 0,
+            VCD_DUMP  = 0);
+
+localparam                    IDWIDTH = 4;
+
+reg                           clk;
+integer                       count;
+
+wire [IDWIDTH-1:0]            awid;
+wire [31:0]                   awaddr;
+wire                          awvalid;
+wire                          awready;
+wire  [7:0]                   awlen;
+
+wire [31:0]                   wdata;
+wire                          wvalid;
+wire                          wready;
+wire                          wlast;
+wire  [3:0]                   wstrb;
+
+wire [IDWIDTH-1:0]            bid;
+wire  [1:0]                   bresp;
+wire                          bvalid;
+wire                          bready;
+
+wire [IDWIDTH-1:0]            arid;
+wire [31:0]                   araddr;
+wire                          arvalid;
+wire                          arready;
+wire  [7:0]                   arlen;
+
+wire [IDWIDTH-1:0]            rid;
+wire [31:0]                   rdata;
+wire  [1:0]                   rresp;
+wire                          rlast;
+wire                          rvalid;
+wire                          rready;
+
+reg  [31:0]                   irq;
+
+// ---------------------------------------------------------
+// Generate a clock
+// ---------------------------------------------------------
+initial
+begin
+  // If enabled, dump all the signals to a VCD file
+  if (VCD_DUMP != 0)
+  begin
+    $dumpfile("waves.vcd");
+    $dumpvars(0, testaxi4mgr);
+  end
+
+  clk                         = 1'b1;
+  count                       = 0;
+  irq                         = 0;
+
+  forever # (CLKPERIOD/2) clk = ~clk;
+end
+
+// ---------------------------------------------------------
+// Simulation control
+// ---------------------------------------------------------
+
+always @(posedge clk)
+begin
+  count                       <= count + 1;
+
+  if (count == STOPCOUNT)
+  begin
+    if (FINISH != 0)
+    begin
+      $finish;
+    end
+    else
+    begin
+      $stop;
+    end
+  end
+end
+
+// ---------------------------------------------------------
+// AXI4 manager bus functional model
+// ---------------------------------------------------------
+
+  axi4mgrbfm
+  #(.IDWIDTH                  (IDWIDTH),
+    .WDATA_LOG2               (6),
+    .NODE                     (0)
+  ) axivp
+  (
+    .clk                      (clk),
+
+    .awid                     (awid),
+    .awaddr                   (awaddr),
+    .awlen                    (awlen),
+    .awsize                   (),
+    .awburst                  (),
+    .awprot                   (),
+    .awvalid                  (awvalid),
+    .awready                  (awready),
+
+    .wdata                    (wdata),
+    .wstrb                    (wstrb),
+    .wlast                    (wlast),
+    .wvalid                   (wvalid),
+    .wready                   (wready),
+
+    .bid                      (bid),
+    .bresp                    (bresp),
+    .bvalid                   (bvalid),
+    .bready                   (bready),
+
+    .arid                     (arid),
+    .araddr                   (araddr),
+    .arlen                    (arlen),
+    .arsize                   (),
+    .arburst                  (),
+    .arprot                   (),
+    .arvalid                  (arvalid),
+    .arready                  (arready),
+
+    .rid                      (rid),
+    .rdata                    (rdata),
+    .rresp                    (rresp),
+    .rlast                    (rlast),
+    .rvalid                   (rvalid),
+    .rready                   (rready),
+
+    .irq                      (irq)
+  );
+
+// ---------------------------------------------------------
+// Out-of-order subordinate
+// ---------------------------------------------------------
+
+  axi4ooosub
+  #(.IDWIDTH                  (IDWIDTH)
+  ) sub
+  (
+    .clk                      (clk),
+
+    .awid                     (awid),
+    .awaddr                   (awaddr),
+    .awlen                    (awlen),
+    .awvalid                  (awvalid),
+    .awready                  (awready),
+
+    .wdata                    (wdata),
+    .wstrb                    (wstrb),
+    .wlast                    (wlast),
+    .wvalid                   (wvalid),
+    .wready                   (wready),
+
+    .bid                      (bid),
+    .bresp                    (bresp),
+    .bvalid                   (bvalid),
+    .bready                   (bready),
+
+    .arid                     (arid),
+    .araddr                   (araddr),
+    .arlen                    (arlen),
+    .arvalid                  (arvalid),
+    .arready                  (arready),
+
+    .rid                      (rid),
+    .rdata                    (rdata),
+    .rresp                    (rresp),
+    .rlast                    (rlast),
+    .rvalid                   (rvalid),
+    .rready                   (rready)
+  );
+
+endmodule
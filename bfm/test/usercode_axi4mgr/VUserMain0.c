@@ -0,0 +1,217 @@
+// ====================================================================
+// VUserMain0.c                                        Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// Test user code for the AXI4 manager BFM (testaxi4mgr.v). In each
+// round, NUM_TXNS writes of random lengths are issued to one bank of
+// regions, with random IDs, while the regions written in the previous
+// round are read back from the other bank, and all the completions are
+// reaped with Axi4MgrReap(). The completions for each ID and direction
+// are checked to be in the order issued, and those between IDs to have
+// been out of order at least once. A write of the BFM's full write data
+// queue depth is then checked, and one longer than it checked to fail.
+//
+// ===================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "VUser.h"
+#include "axi4mgr.h"
+
+#define SLEEPFOREVER {while(1) VTick(0x7fffffff, node);}
+
+// Write data queue depth, as set by WDATA_LOG2 in testaxi4mgr.v
+#define WDATA_DEPTH             64
+
+#define NUM_IDS                 8
+#define NUM_TXNS                32
+#define NUM_ROUNDS              16
+#define MAX_LEN                 16
+
+// Region address, in bytes, within a bank
+#define REGION_ADDR(_b, _r)     ((((_b) * NUM_TXNS) + (_r)) * WDATA_DEPTH * 4)
+
+// Tag of a transaction, with reads distinguished from writes
+#define TAG_READ                0x100
+
+// ------------------------------------------------------------
+// LOCAL STATICS
+// ------------------------------------------------------------
+
+// I'm node 0
+static const int node = 0;
+
+static int       errors = 0;
+
+// Expected data and length of each region, in each bank
+static uint32_t  expdata[2][NUM_TXNS][WDATA_DEPTH];
+static unsigned  explen [2][NUM_TXNS];
+
+static uint32_t  rdata  [NUM_TXNS][WDATA_DEPTH];
+
+// Last tag reaped for each ID and direction, and for each direction
+static int       lastTag[2][NUM_IDS];
+static int       prevTag[2];
+static int       outOfOrder = 0;
+
+// ------------------------------------------------------------
+// Check a value and report a mismatch
+// ------------------------------------------------------------
+
+static void check (const char *what, const uint32_t got, const uint32_t exp)
+{
+    if (got != exp)
+    {
+        VPrint("***Error: %s got 0x%08x, expected 0x%08x\n", what, got, exp);
+        errors++;
+    }
+}
+
+// ------------------------------------------------------------
+// Reap all outstanding transactions, checking their order, and
+// the read data against the bank it was read from
+// ------------------------------------------------------------
+
+static void reapAll (const int rdbank)
+{
+    Axi4MgrCmpl_t cmpl[8];
+    unsigned      num;
+
+    for (int id = 0; id < NUM_IDS; id++)
+    {
+        lastTag[0][id] = -1;
+        lastTag[1][id] = -1;
+    }
+
+    prevTag[0] = -1;
+    prevTag[1] = -1;
+
+    while (Axi4MgrOutstanding(node))
+    {
+        num = Axi4MgrReap(cmpl, 8, 1, node);
+
+        for (unsigned idx = 0; idx < num; idx++)
+        {
+            int read = (cmpl[idx].tag & TAG_READ) ? 1 : 0;
+            int txn  = cmpl[idx].tag & ~TAG_READ;
+
+            check("completion direction", cmpl[idx].write, !read);
+            check("completion response",  cmpl[idx].resp,  AXI4MGR_RESP_OKAY);
+
+            // Issue order is the order of the tags
+            if (txn <= lastTag[read][cmpl[idx].id])
+            {
+                VPrint("***Error: %s ID %d tag %d completed after tag %d\n", read ? "read" : "write", cmpl[idx].id,
+                       txn, lastTag[read][cmpl[idx].id]);
+                errors++;
+            }
+
+            lastTag[read][cmpl[idx].id] = txn;
+
+            if (txn < prevTag[read])
+            {
+                outOfOrder++;
+            }
+
+            prevTag[read] = txn;
+
+            if (read)
+            {
+                check("read length", cmpl[idx].len, explen[rdbank][txn]);
+
+                for (unsigned word = 0; word < explen[rdbank][txn]; word++)
+                {
+                    check("read data", rdata[txn][word], expdata[rdbank][txn][word]);
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------
+// MAIN ENTRY POINT FOR NODE 0
+// ------------------------------------------------------------
+
+void VUserMain0 (void)
+{
+    Axi4MgrInit(0, node);
+
+    // Writes to one bank, with reads of the other bank written in the previous round
+    for (int round = 0; round <= NUM_ROUNDS; round++)
+    {
+        int wrbank = round % 2;
+        int rdbank = !wrbank;
+
+        for (int txn = 0; txn < NUM_TXNS; txn++)
+        {
+            if (round < NUM_ROUNDS)
+            {
+                explen[wrbank][txn] = 1 + rand() % MAX_LEN;
+
+                for (unsigned word = 0; word < explen[wrbank][txn]; word++)
+                {
+                    expdata[wrbank][txn][word] = ((uint32_t)rand() << 16) ^ rand();
+                }
+
+                check("write issue", Axi4MgrWrite(rand() % NUM_IDS, REGION_ADDR(wrbank, txn), expdata[wrbank][txn],
+                                                  explen[wrbank][txn], txn, node), 0);
+            }
+
+            if (round > 0)
+            {
+                check("read issue", Axi4MgrRead(rand() % NUM_IDS, REGION_ADDR(rdbank, txn), rdata[txn],
+                                                explen[rdbank][txn], TAG_READ | txn, node), 0);
+            }
+        }
+
+        reapAll(rdbank);
+    }
+
+    if (outOfOrder == 0)
+    {
+        VPrint("***Error: no completions were out of order\n");
+        errors++;
+    }
+
+    // A write of the full write data queue depth, read back
+    explen[0][0] = WDATA_DEPTH;
+
+    for (unsigned word = 0; word < WDATA_DEPTH; word++)
+    {
+        expdata[0][0][word] = ~word;
+    }
+
+    check("full depth write", Axi4MgrWrite(0, REGION_ADDR(0, 0), expdata[0][0], WDATA_DEPTH, 0, node), 0);
+    reapAll(0);
+    check("full depth read", Axi4MgrRead(0, REGION_ADDR(0, 0), rdata[0], WDATA_DEPTH, TAG_READ, node), 0);
+    reapAll(0);
+
+    // A write longer than the write data queue fails, rather than waiting for room
+    VPrint("Expect an error for a write longer than the BFM write data queue:\n");
+    check("over depth write", Axi4MgrWrite(0, REGION_ADDR(0, 0), expdata[0][0], WDATA_DEPTH + 1, 0, node), (uint32_t)-1);
+    check("over depth outstanding", Axi4MgrOutstanding(node), 0);
+
+    VPrint("%d out of order completions\n", outOfOrder);
+    VPrint("%s: %d error%s\n", errors ? "FAIL" : "PASS", errors, errors == 1 ? "" : "s");
+
+    SLEEPFOREVER;
+}
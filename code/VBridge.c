@@ -0,0 +1,690 @@
+//=====================================================================
+//
+// VBridge.c                                          Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Simulation to simulation bridge (see VBridge.h). The bridge node's
+// thread publishes its cycle, acts on received messages that are
+// due, and then ticks up to the next message due or the end of the
+// lookahead window, whichever is sooner, waiting for the other side
+// to publish when at the end of the window.
+//
+//=====================================================================
+
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <fcntl.h>
+#include <signal.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#include "VProc.h"
+#include "VUser.h"
+#include "VBridge.h"
+
+// Seconds between checks that the other side is still alive
+#define VBRIDGE_POLL_SECS       1
+
+// Time between attempts to attach to the other side's segment
+#define VBRIDGE_ATTACH_NS       100000000
+
+// Polls of the other side's epoch before sleeping on the futex
+#define VBRIDGE_SPIN            2000
+
+// Largest single tick the bridge node issues
+#define VBRIDGE_MAX_TICKS       0x10000000
+
+// Response slot for each requesting node
+typedef struct {
+    uint32_t            valid;
+    uint32_t            data[VBRIDGE_MAX_WORDS];
+} VBridgeResp_t;
+
+// Message queued locally while the link's ring is full
+typedef struct VBridgePend_s {
+    struct VBridgePend_s *next;
+    VBridgeMsg_t          msg;          // With the cycle sent in msg.cycle
+} VBridgePend_t;
+
+static VBridgeSeg_t    *bridgeSeg   = NULL;
+static int              bridgeSide;
+static unsigned         bridgeNode;
+static uint64_t         bridgeLookahead;
+static uint64_t         bridgePublished = 0;
+static char             bridgeName[DEFAULT_STR_BUF_SIZE*4];
+static pthread_mutex_t  bridgeTxLock = PTHREAD_MUTEX_INITIALIZER;
+static pVBridgeIrqCB_t  bridgeIrqCB  = NULL;
+static VBridgeResp_t    bridgeResp[VP_MAX_NODES];
+static VBridgePend_t   *bridgePendHead = NULL;
+static VBridgePend_t   *bridgePendTail = NULL;
+
+// Link statistics
+static uint64_t         bridgeSent     = 0;
+static uint64_t         bridgeReceived = 0;
+static uint64_t         bridgeWaitNs   = 0;
+
+#ifdef __linux__
+
+// -------------------------------------------------------------------------
+// VBridgeAtExit()
+//
+// Flag to the other side that this simulation has ended, and
+// report link statistics
+// -------------------------------------------------------------------------
+
+static void VBridgeAtExit (void)
+{
+    VBridgeDir_t *tx = &bridgeSeg->dir[bridgeSide];
+
+    __atomic_store_n(&bridgeSeg->closed[bridgeSide], 1, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&tx->epoch, 1, __ATOMIC_SEQ_CST);
+    syscall(SYS_futex, &tx->epoch, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+
+    if (bridgeSide == 0)
+    {
+        shm_unlink(bridgeName);
+    }
+
+    VPrint("VBridge: side %d sent %llu and received %llu messages, waited %.3f secs for side %d\n",
+           bridgeSide, (unsigned long long)bridgeSent, (unsigned long long)bridgeReceived,
+           (double)bridgeWaitNs / 1e9, 1 - bridgeSide);
+}
+
+// -------------------------------------------------------------------------
+// VBridgeConnect()
+//
+// Side 0 creates the link segment and side 1 attaches to it,
+// waiting for it to be created
+// -------------------------------------------------------------------------
+
+static void VBridgeConnect (const char *name, const int side, const unsigned lookahead)
+{
+    struct timespec ts = {0, VBRIDGE_ATTACH_NS};
+    VBridgeSeg_t   *seg;
+    int             fd;
+
+    snprintf(bridgeName, sizeof(bridgeName), "%s%s", name[0] == '/' ? "" : "/", name);
+
+    if (side == 0)
+    {
+        shm_unlink(bridgeName);
+
+        if ((fd = shm_open(bridgeName, O_CREAT | O_EXCL | O_RDWR, 0600)) == -1 || ftruncate(fd, sizeof(VBridgeSeg_t)) == -1)
+        {
+            VPrint("***Error: VBridgeRun() failed to create shared memory %s\n", bridgeName);
+            exit(1);
+        }
+    }
+    else
+    {
+        while ((fd = shm_open(bridgeName, O_RDWR, 0)) == -1)
+        {
+            nanosleep(&ts, NULL);
+        }
+    }
+
+    if ((seg = (VBridgeSeg_t *) mmap(NULL, sizeof(VBridgeSeg_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED)
+    {
+        VPrint("***Error: VBridgeRun() failed to map shared memory %s\n", bridgeName);
+        exit(1);
+    }
+
+    close(fd);
+
+    if (side == 0)
+    {
+        seg->version   = VBRIDGE_VERSION;
+        seg->lookahead = lookahead;
+        seg->pid[0]    = getpid();
+
+        // Magic is written last, marking the segment as ready
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        memcpy(seg->magic, VBRIDGE_MAGIC, strlen(VBRIDGE_MAGIC));
+    }
+    else
+    {
+        while (memcmp((char *)seg->magic, VBRIDGE_MAGIC, strlen(VBRIDGE_MAGIC)))
+        {
+            nanosleep(&ts, NULL);
+        }
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (seg->version != VBRIDGE_VERSION || seg->lookahead != lookahead)
+        {
+            VPrint("***Error: VBridgeRun() %s has version %d and lookahead %d (expected %d and %d)\n",
+                   bridgeName, seg->version, seg->lookahead, VBRIDGE_VERSION, lookahead);
+            exit(1);
+        }
+
+        seg->pid[1] = getpid();
+    }
+
+    bridgeSeg = seg;
+
+    atexit(VBridgeAtExit);
+}
+
+// -------------------------------------------------------------------------
+// VBridgeWaitPublish()
+//
+// Wait for the other side to publish a new cycle, or to exit
+// -------------------------------------------------------------------------
+
+static void VBridgeWaitPublish (const uint32_t old)
+{
+    VBridgeDir_t   *rx = &bridgeSeg->dir[1 - bridgeSide];
+    struct timespec to = {VBRIDGE_POLL_SECS, 0};
+    uint64_t        t0 = VStatsNowNs();
+
+    for (int idx = 0; idx < VBRIDGE_SPIN; idx++)
+    {
+        if (__atomic_load_n(&rx->epoch, __ATOMIC_ACQUIRE) != old)
+        {
+            bridgeWaitNs += VStatsNowNs() - t0;
+            return;
+        }
+    }
+
+    __atomic_store_n(&rx->waiting, 1, __ATOMIC_SEQ_CST);
+
+    while (__atomic_load_n(&rx->epoch, __ATOMIC_SEQ_CST) == old)
+    {
+        if (syscall(SYS_futex, &rx->epoch, FUTEX_WAIT, old, &to, NULL, 0) == -1 && errno == ETIMEDOUT)
+        {
+            int pid = bridgeSeg->pid[1 - bridgeSide];
+
+            if (pid != 0 && kill(pid, 0) == -1)
+            {
+                VPrint("VBridge: side %d simulation has gone, continuing unsynchronised\n", 1 - bridgeSide);
+                __atomic_store_n(&bridgeSeg->closed[1 - bridgeSide], 1, __ATOMIC_RELEASE);
+                break;
+            }
+        }
+    }
+
+    __atomic_store_n(&rx->waiting, 0, __ATOMIC_RELAXED);
+
+    bridgeWaitNs += VStatsNowNs() - t0;
+}
+
+// -------------------------------------------------------------------------
+// VBridgePublish()
+//
+// Publish this side's cycle. Holds the transmit lock so that no
+// message can be sent with a timestamp based on an older cycle.
+// -------------------------------------------------------------------------
+
+static void VBridgePublish (const uint64_t cycle)
+{
+    VBridgeDir_t *tx = &bridgeSeg->dir[bridgeSide];
+
+    pthread_mutex_lock(&bridgeTxLock);
+    bridgePublished = cycle;
+    __atomic_store_n(&tx->cycle, cycle, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&bridgeTxLock);
+
+    __atomic_add_fetch(&tx->epoch, 1, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&tx->waiting, __ATOMIC_SEQ_CST))
+    {
+        syscall(SYS_futex, &tx->epoch, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+#endif
+
+// -------------------------------------------------------------------------
+// VBridgeMsgSize()
+//
+// Number of bytes of a message in use
+// -------------------------------------------------------------------------
+
+static size_t VBridgeMsgSize (const VBridgeMsg_t *msg)
+{
+    return offsetof(VBridgeMsg_t, data) + (msg->len ? msg->len : 1) * sizeof(uint32_t);
+}
+
+// -------------------------------------------------------------------------
+// VBridgePut()
+//
+// Put a message on the ring, if not full, timestamped a lookahead
+// after the later of the given cycle and the published cycle.
+// Returns non-zero if the ring is full. Called with the transmit
+// lock held.
+// -------------------------------------------------------------------------
+
+static int VBridgePut (VBridgeMsg_t *msg, const uint64_t cycle)
+{
+    VBridgeDir_t *tx = &bridgeSeg->dir[bridgeSide];
+    uint32_t      wr = tx->wr;
+
+    if ((wr - __atomic_load_n(&tx->rd, __ATOMIC_ACQUIRE)) >= VP_BRIDGE_RING_SIZE)
+    {
+        return 1;
+    }
+
+    msg->cycle = (cycle > bridgePublished ? cycle : bridgePublished) + bridgeLookahead;
+
+    memcpy(&tx->ring[wr & VBRIDGE_RING_MASK], msg, VBridgeMsgSize(msg));
+
+    __atomic_store_n(&tx->wr, wr + 1, __ATOMIC_RELEASE);
+
+    bridgeSent++;
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// VBridgeFlush()
+//
+// Move locally queued messages onto the ring, in order, until it is
+// full. Called with the transmit lock held. Returns non-zero if any
+// remain queued.
+// -------------------------------------------------------------------------
+
+static int VBridgeFlush (void)
+{
+    while (bridgePendHead != NULL)
+    {
+        VBridgePend_t *pend = bridgePendHead;
+
+        if (VBridgePut(&pend->msg, pend->msg.cycle))
+        {
+            return 1;
+        }
+
+        if ((bridgePendHead = pend->next) == NULL)
+        {
+            bridgePendTail = NULL;
+        }
+
+        free(pend);
+    }
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// VBridgeSend()
+//
+// Send a message. If the ring is full, ticks the given node and
+// retries or, if tick_node is negative, queues the message locally
+// to be sent later by the bridge node's main loop. The bridge node's
+// own messages (read responses and interrupts) are always queued
+// like this, as the bridge node must not block waiting for the other
+// side, which may itself be waiting for the bridge node to publish.
+// -------------------------------------------------------------------------
+
+static int VBridgeSend (VBridgeMsg_t *msg, const uint64_t cycle, const int tick_node)
+{
+    VBridgePend_t *pend;
+
+    pthread_mutex_lock(&bridgeTxLock);
+
+    // Any queued messages go first, to keep messages in order
+    while (VBridgeFlush() || VBridgePut(msg, cycle))
+    {
+        if (tick_node < 0)
+        {
+            if ((pend = (VBridgePend_t *) malloc(sizeof(VBridgePend_t))) == NULL)
+            {
+                VPrint("***Error: VBridgeSend() failed to allocate memory\n");
+                exit(1);
+            }
+
+            memcpy(&pend->msg, msg, VBridgeMsgSize(msg));
+            pend->msg.cycle = cycle;
+            pend->next      = NULL;
+
+            if (bridgePendTail != NULL)
+            {
+                bridgePendTail->next = pend;
+            }
+            else
+            {
+                bridgePendHead = pend;
+            }
+
+            bridgePendTail = pend;
+
+            break;
+        }
+
+        pthread_mutex_unlock(&bridgeTxLock);
+
+        VTick(1, tick_node);
+
+        pthread_mutex_lock(&bridgeTxLock);
+    }
+
+    pthread_mutex_unlock(&bridgeTxLock);
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// VBridgeIrqCB()
+//
+// Interrupt callback for the bridge node, forwarding the new value.
+// Called on the simulation thread.
+// -------------------------------------------------------------------------
+
+static int VBridgeIrqCB (int irq)
+{
+    VBridgeMsg_t msg;
+
+    msg.type    = VBRIDGE_MSG_IRQ;
+    msg.tag     = bridgeNode;
+    msg.addr    = 0;
+    msg.len     = 0;
+    msg.data[0] = irq;
+
+    VBridgeSend(&msg, ns[bridgeNode]->stats.s.cycle, -1);
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// VBridgeAct()
+//
+// Act on a received message on the bridge node's thread
+// -------------------------------------------------------------------------
+
+static void VBridgeAct (VBridgeMsg_t *msg)
+{
+    VBridgeMsg_t resp;
+
+    switch (msg->type)
+    {
+    case VBRIDGE_MSG_WRITE:
+        if (msg->len)
+        {
+            VBurstWrite(msg->addr, msg->data, msg->len, bridgeNode);
+        }
+        else
+        {
+            VWrite(msg->addr, msg->data[0], 0, bridgeNode);
+        }
+        break;
+
+    case VBRIDGE_MSG_READ:
+        if (msg->len)
+        {
+            VBurstRead(msg->addr, resp.data, msg->len, bridgeNode);
+        }
+        else
+        {
+            VRead(msg->addr, &resp.data[0], 0, bridgeNode);
+        }
+
+        resp.type = VBRIDGE_MSG_RESP;
+        resp.tag  = msg->tag;
+        resp.addr = msg->addr;
+        resp.len  = msg->len;
+
+        VBridgeSend(&resp, ns[bridgeNode]->stats.s.cycle, -1);
+        break;
+
+    case VBRIDGE_MSG_RESP:
+        memcpy(bridgeResp[msg->tag].data, msg->data, (msg->len ? msg->len : 1) * sizeof(uint32_t));
+        __atomic_store_n(&bridgeResp[msg->tag].valid, 1, __ATOMIC_RELEASE);
+        break;
+
+    case VBRIDGE_MSG_IRQ:
+        if (bridgeIrqCB != NULL)
+        {
+            bridgeIrqCB(msg->data[0]);
+        }
+        break;
+    }
+}
+
+// -------------------------------------------------------------------------
+// VBridgeReceive()
+//
+// Act on all received messages due at or before the current cycle.
+// Returns the cycle of the next pending message, or UINT64_MAX if
+// none.
+// -------------------------------------------------------------------------
+
+static uint64_t VBridgeReceive (void)
+{
+    VBridgeDir_t *rx = &bridgeSeg->dir[1 - bridgeSide];
+    VBridgeMsg_t  msg;
+    uint32_t      rd = rx->rd;
+
+    while (rd != __atomic_load_n(&rx->wr, __ATOMIC_ACQUIRE))
+    {
+        VBridgeMsg_t *head = &rx->ring[rd & VBRIDGE_RING_MASK];
+
+        if (head->cycle > ns[bridgeNode]->stats.s.cycle)
+        {
+            return head->cycle;
+        }
+
+        memcpy(&msg, head, sizeof(VBridgeMsg_t));
+        __atomic_store_n(&rx->rd, ++rd, __ATOMIC_RELEASE);
+
+        bridgeReceived++;
+
+        // May advance the cycle, if a bus transaction
+        VBridgeAct(&msg);
+    }
+
+    return UINT64_MAX;
+}
+
+// -------------------------------------------------------------------------
+// VBridgeWaitResp()
+//
+// Tick a requesting node until its response has been received
+// -------------------------------------------------------------------------
+
+static void VBridgeWaitResp (uint32_t *data, const unsigned len, const unsigned node)
+{
+    // A response can't come back in less than a round trip
+    VTick(2 * bridgeLookahead, node);
+
+    while (!__atomic_load_n(&bridgeResp[node].valid, __ATOMIC_ACQUIRE))
+    {
+        VTick(1, node);
+    }
+
+    memcpy(data, bridgeResp[node].data, (len ? len : 1) * sizeof(uint32_t));
+    bridgeResp[node].valid = 0;
+}
+
+// -------------------------------------------------------------------------
+// VBridgeRequest()
+//
+// Common request function for the user API. Waits for the link to
+// be connected before sending.
+// -------------------------------------------------------------------------
+
+static int VBridgeRequest (const uint32_t type, const unsigned addr, uint32_t *data, const unsigned len, const unsigned node)
+{
+    VBridgeMsg_t msg;
+
+    if (len > VBRIDGE_MAX_WORDS)
+    {
+        VPrint("***Error: VBridge burst length %d greater than maximum of %d\n", len, VBRIDGE_MAX_WORDS);
+        return 1;
+    }
+
+    while (__atomic_load_n(&bridgeSeg, __ATOMIC_ACQUIRE) == NULL)
+    {
+        VTick(1, node);
+    }
+
+    msg.type = type;
+    msg.tag  = node;
+    msg.addr = addr;
+    msg.len  = len;
+
+    if (type == VBRIDGE_MSG_WRITE)
+    {
+        memcpy(msg.data, data, (len ? len : 1) * sizeof(uint32_t));
+    }
+
+    if (VBridgeSend(&msg, ns[node]->stats.s.cycle, node))
+    {
+        return 1;
+    }
+
+    if (type == VBRIDGE_MSG_READ)
+    {
+        VBridgeWaitResp(data, len, node);
+    }
+
+    return 0;
+}
+
+// =========================================================================
+// User API functions
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VBridgeRun()
+//
+// Bridge node main loop
+// -------------------------------------------------------------------------
+
+void VBridgeRun (const char *name, const int side, const unsigned lookahead, const unsigned node)
+{
+#ifdef __linux__
+    if ((side != 0 && side != 1) || lookahead == 0)
+    {
+        VPrint("***Error: VBridgeRun() side must be 0 or 1, and lookahead non-zero\n");
+        exit(1);
+    }
+
+    bridgeSide      = side;
+    bridgeNode      = node;
+    bridgeLookahead = lookahead;
+
+    VPrint("VBridge: node %d is side %d of %s, lookahead %d cycles\n", node, side, name, lookahead);
+
+    VBridgeConnect(name, side, lookahead);
+
+    VRegIrq(VBridgeIrqCB, node);
+
+    while (1)
+    {
+        VBridgeDir_t *rx = &bridgeSeg->dir[1 - bridgeSide];
+        uint64_t      cycle, limit, next;
+        uint32_t      epoch = __atomic_load_n(&rx->epoch, __ATOMIC_ACQUIRE);
+
+        // Send any messages queued while the ring was full
+        pthread_mutex_lock(&bridgeTxLock);
+        VBridgeFlush();
+        pthread_mutex_unlock(&bridgeTxLock);
+
+        VBridgePublish(ns[node]->stats.s.cycle);
+
+        next  = VBridgeReceive();
+        cycle = ns[node]->stats.s.cycle;
+
+        // Acting on messages may have moved time on, so publish again
+        if (cycle != bridgePublished)
+        {
+            continue;
+        }
+
+        if (__atomic_load_n(&bridgeSeg->closed[1 - bridgeSide], __ATOMIC_ACQUIRE))
+        {
+            limit = UINT64_MAX;
+        }
+        else
+        {
+            limit = __atomic_load_n(&rx->cycle, __ATOMIC_ACQUIRE) + bridgeLookahead;
+
+            // At the end of the window, so wait for the other side to catch up
+            if (limit <= cycle)
+            {
+                VBridgeWaitPublish(epoch);
+                continue;
+            }
+        }
+
+        next = (next < limit) ? next : limit;
+
+        VTick((next - cycle) < VBRIDGE_MAX_TICKS ? (unsigned)(next - cycle) : VBRIDGE_MAX_TICKS, node);
+    }
+#else
+    VPrint("***Error: VBridgeRun() not supported on this platform\n");
+    exit(1);
+#endif
+}
+
+// -------------------------------------------------------------------------
+// VBridgeRegIrq()
+//
+// Register a callback for interrupts from the other simulation
+// -------------------------------------------------------------------------
+
+void VBridgeRegIrq (const pVBridgeIrqCB_t func)
+{
+    bridgeIrqCB = func;
+}
+
+// -------------------------------------------------------------------------
+// VBridgeWrite()
+// -------------------------------------------------------------------------
+
+int VBridgeWrite (const unsigned addr, const unsigned data, const unsigned node)
+{
+    uint32_t wdata = data;
+
+    return VBridgeRequest(VBRIDGE_MSG_WRITE, addr, &wdata, 0, node);
+}
+
+// -------------------------------------------------------------------------
+// VBridgeRead()
+// -------------------------------------------------------------------------
+
+int VBridgeRead (const unsigned addr, unsigned *data, const unsigned node)
+{
+    return VBridgeRequest(VBRIDGE_MSG_READ, addr, (uint32_t *)data, 0, node);
+}
+
+// -------------------------------------------------------------------------
+// VBridgeBurstWrite()
+// -------------------------------------------------------------------------
+
+int VBridgeBurstWrite (const unsigned addr, void *data, const unsigned wordlen, const unsigned node)
+{
+    return VBridgeRequest(VBRIDGE_MSG_WRITE, addr, (uint32_t *)data, wordlen, node);
+}
+
+// -------------------------------------------------------------------------
+// VBridgeBurstRead()
+// -------------------------------------------------------------------------
+
+int VBridgeBurstRead (const unsigned addr, void *data, const unsigned wordlen, const unsigned node)
+{
+    return VBridgeRequest(VBRIDGE_MSG_READ, addr, (uint32_t *)data, wordlen, node);
+}
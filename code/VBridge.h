@@ -0,0 +1,114 @@
+//=====================================================================
+//
+// VBridge.h                                          Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Simulation to simulation bridge. A bridge node in each of two
+// simulations runs VBridgeRun() as its user code, and the two are
+// linked through a POSIX shared memory segment. Transactions issued
+// by user code in one simulation with the VBridgeXXX() calls are
+// carried out by the bridge node in the other, and interrupts on
+// the bridge node's input are forwarded to the other side.
+//
+// Synchronisation is conservative, with a fixed link latency (the
+// lookahead) in clock cycles. Each side publishes its current cycle
+// and may run up to a lookahead beyond the other side's published
+// cycle, with all messages timestamped for delivery a lookahead
+// after they were sent, so no message can arrive late. Interrupts
+// are timestamped from the bridge node's last scheduled cycle, and
+// so may arrive up to a lookahead earlier than this.
+//
+//=====================================================================
+
+#ifndef _VBRIDGE_H_
+#define _VBRIDGE_H_
+
+#include <stdint.h>
+
+#define VBRIDGE_MAGIC           "VPBRIDG"
+#define VBRIDGE_VERSION         1
+
+// Messages in each direction's ring (must be a power of 2)
+#ifndef VP_BRIDGE_RING_SIZE
+#define VP_BRIDGE_RING_SIZE     256
+#endif
+
+#define VBRIDGE_RING_MASK       (VP_BRIDGE_RING_SIZE - 1)
+
+// Maximum words carried in one message, and so the longest burst
+#define VBRIDGE_MAX_WORDS       256
+
+// Message types
+#define VBRIDGE_MSG_WRITE       1
+#define VBRIDGE_MSG_READ        2
+#define VBRIDGE_MSG_RESP        3
+#define VBRIDGE_MSG_IRQ         4
+
+// Link message
+typedef struct {
+    uint64_t            cycle;          // Cycle at which receiver acts on message
+    uint32_t            type;           // VBRIDGE_MSG_xxx
+    uint32_t            tag;            // Requesting node in the sending simulation
+    uint32_t            addr;
+    uint32_t            len;            // Words (0 for a single word access)
+    uint32_t            data[VBRIDGE_MAX_WORDS];
+} VBridgeMsg_t;
+
+// One direction of the link, written by one side and read by the other
+typedef struct {
+    uint64_t            cycle       __attribute__((aligned(64)));  // Sender's published cycle
+    uint32_t            epoch;          // Futex word, incremented on each publish
+    uint32_t            waiting;        // Receiver is sleeping on epoch
+    uint32_t            wr          __attribute__((aligned(64)));  // Written by sender only
+    uint32_t            rd          __attribute__((aligned(64)));  // Written by receiver only
+    VBridgeMsg_t        ring[VP_BRIDGE_RING_SIZE];
+} VBridgeDir_t;
+
+// Shared segment. Side n sends on dir[n] and receives on dir[1-n].
+typedef struct {
+    char                magic[8];
+    uint32_t            version;
+    uint32_t            lookahead;
+    int32_t             pid[2];
+    uint32_t            closed[2];      // Set when a side's simulation exits
+    VBridgeDir_t        dir[2];
+} VBridgeSeg_t;
+
+// Callback for interrupts forwarded from the other simulation
+typedef int (*pVBridgeIrqCB_t)(int);
+
+// Bridge node user code entry point. Does not return.
+extern void VBridgeRun          (const char *name, const int side, const unsigned lookahead, const unsigned node);
+
+// Register a callback for interrupts from the other side. Called on
+// the bridge node's thread, so it may issue transactions on the
+// bridge node's bus (e.g. to an interrupt controller).
+extern void VBridgeRegIrq       (const pVBridgeIrqCB_t func);
+
+// Transactions in the other simulation, called from any node's user
+// code. Writes are posted, and reads tick the calling node until the
+// data returns.
+extern int  VBridgeWrite        (const unsigned addr, const unsigned data, const unsigned node);
+extern int  VBridgeRead         (const unsigned addr, unsigned *data,      const unsigned node);
+extern int  VBridgeBurstWrite   (const unsigned addr, void *data, const unsigned wordlen, const unsigned node);
+extern int  VBridgeBurstRead    (const unsigned addr, void *data, const unsigned wordlen, const unsigned node);
+
+#endif
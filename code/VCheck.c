@@ -0,0 +1,487 @@
+//=====================================================================
+//
+// VCheck.c                                           Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Deferred checking (see VCheck.h). Submitted checks are queued in
+// order on a single list, protected by a mutex, from which the
+// worker threads take them. Failures are kept until reported, and
+// sorted by cycle when reported.
+//
+//=====================================================================
+
+#include <string.h>
+#include <unistd.h>
+#include "VProc.h"
+#include "VUser.h"
+#include "VCheck.h"
+
+// Queued check
+typedef struct VCheckJob {
+    struct VCheckJob   *next;
+    unsigned            node;
+    uint64_t            seq;
+    uint64_t            cycle;
+    char                name[VCHECK_NAME_SIZE];
+    void               *data;
+    size_t              bytes;
+    pVCheckFunc_t       func;
+    pVCheckGen_t        gen;
+    void               *ctx;
+    int                 own_ctx;
+} VCheckJob_t;
+
+// Recorded failure
+typedef struct {
+    unsigned            node;
+    uint64_t            seq;
+    uint64_t            cycle;
+    char                name[VCHECK_NAME_SIZE];
+    char                msg[VCHECK_MSG_SIZE];
+} VCheckFail_t;
+
+// Per-node counts
+typedef struct {
+    uint64_t            submitted;
+    uint64_t            completed;
+    uint64_t            failed;
+} VCheckNode_t;
+
+static pthread_once_t   checkOnce     = PTHREAD_ONCE_INIT;
+static pthread_mutex_t  checkLock     = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   checkWork     = PTHREAD_COND_INITIALIZER;     // Signalled when a job is queued
+static pthread_cond_t   checkDone     = PTHREAD_COND_INITIALIZER;     // Signalled when a job completes
+static VCheckJob_t     *checkHead     = NULL;
+static VCheckJob_t     *checkTail     = NULL;
+static unsigned         checkPending  = 0;
+static VCheckNode_t     checkNode[VP_MAX_NODES];
+static VCheckFail_t    *checkFails    = NULL;
+static size_t           checkNumFails = 0;
+static size_t           checkMaxFails = 0;
+static int              checkThreads  = 0;
+
+// -------------------------------------------------------------------------
+// VCheckCompare()
+//
+// Compare data with the generated expected data
+// -------------------------------------------------------------------------
+
+static int VCheckCompare (const VCheckJob_t *job, char *msg, const size_t msglen)
+{
+    uint32_t *exp   = (uint32_t *)malloc(job->bytes + 4);
+    uint32_t *got   = (uint32_t *)job->data;
+    size_t    words = job->bytes / 4;
+    size_t    first = 0;
+    size_t    diffs = 0;
+
+    if (exp == NULL)
+    {
+        VPrint("***Error: VCheck failed to allocate memory\n");
+        exit(1);
+    }
+
+    job->gen(exp, job->bytes, job->ctx);
+
+    if (memcmp(exp, got, job->bytes) != 0)
+    {
+        for (size_t idx = 0; idx < words; idx++)
+        {
+            if (got[idx] != exp[idx] && diffs++ == 0)
+            {
+                first = idx;
+            }
+        }
+
+        if (diffs)
+        {
+            snprintf(msg, msglen, "%zu of %zu words differ, first at word %zu: got 0x%08x, expected 0x%08x",
+                     diffs, words, first, got[first], exp[first]);
+        }
+        else
+        {
+            snprintf(msg, msglen, "trailing bytes of %zu differ", job->bytes);
+        }
+
+        free(exp);
+        return 1;
+    }
+
+    free(exp);
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// VCheckWorker()
+//
+// Worker thread, running queued checks
+// -------------------------------------------------------------------------
+
+static void *VCheckWorker (void *arg)
+{
+    for (;;)
+    {
+        VCheckJob_t *job;
+        char         msg[VCHECK_MSG_SIZE];
+        int          fail;
+
+        pthread_mutex_lock(&checkLock);
+
+        while (checkHead == NULL)
+        {
+            pthread_cond_wait(&checkWork, &checkLock);
+        }
+
+        job       = checkHead;
+        checkHead = job->next;
+
+        if (checkHead == NULL)
+        {
+            checkTail = NULL;
+        }
+
+        pthread_mutex_unlock(&checkLock);
+
+        msg[0] = '\0';
+
+        if (job->gen != NULL)
+        {
+            fail = VCheckCompare(job, msg, sizeof(msg));
+        }
+        else
+        {
+            fail = job->func(job->data, job->bytes, job->ctx, msg, sizeof(msg));
+        }
+
+        pthread_mutex_lock(&checkLock);
+
+        if (fail)
+        {
+            VCheckFail_t *f;
+
+            if (checkNumFails == checkMaxFails)
+            {
+                checkMaxFails = checkMaxFails ? checkMaxFails * 2 : 64;
+                checkFails    = (VCheckFail_t *)realloc(checkFails, checkMaxFails * sizeof(VCheckFail_t));
+
+                if (checkFails == NULL)
+                {
+                    VPrint("***Error: VCheck failed to allocate memory\n");
+                    exit(1);
+                }
+            }
+
+            f        = &checkFails[checkNumFails++];
+            f->node  = job->node;
+            f->seq   = job->seq;
+            f->cycle = job->cycle;
+            strcpy(f->name, job->name);
+            strncpy(f->msg, msg, VCHECK_MSG_SIZE - 1);
+            f->msg[VCHECK_MSG_SIZE - 1] = '\0';
+
+            checkNode[job->node].failed++;
+        }
+
+        checkNode[job->node].completed++;
+        checkPending--;
+
+        pthread_cond_broadcast(&checkDone);
+        pthread_mutex_unlock(&checkLock);
+
+        free(job->data);
+
+        if (job->own_ctx)
+        {
+            free(job->ctx);
+        }
+
+        free(job);
+    }
+
+    return NULL;
+}
+
+// -------------------------------------------------------------------------
+// VCheckFailCmp()
+//
+// Order failures by cycle, then node, then sequence
+// -------------------------------------------------------------------------
+
+static int VCheckFailCmp (const void *a, const void *b)
+{
+    const VCheckFail_t *fa = (const VCheckFail_t *)a;
+    const VCheckFail_t *fb = (const VCheckFail_t *)b;
+
+    if (fa->cycle != fb->cycle)
+    {
+        return fa->cycle < fb->cycle ? -1 : 1;
+    }
+
+    if (fa->node != fb->node)
+    {
+        return fa->node < fb->node ? -1 : 1;
+    }
+
+    return fa->seq < fb->seq ? -1 : (fa->seq > fb->seq);
+}
+
+// -------------------------------------------------------------------------
+// VCheckReport()
+//
+// Report, in cycle order, and discard the recorded failures for a
+// node (or for all nodes if node is negative). Called with the lock
+// held.
+// -------------------------------------------------------------------------
+
+static void VCheckReport (const int node)
+{
+    size_t kept = 0;
+
+    qsort(checkFails, checkNumFails, sizeof(VCheckFail_t), VCheckFailCmp);
+
+    for (size_t idx = 0; idx < checkNumFails; idx++)
+    {
+        VCheckFail_t *f = &checkFails[idx];
+
+        if (node < 0 || f->node == (unsigned)node)
+        {
+            VPrint("***Error: VCheck node %d cycle %llu check %s (#%llu): %s\n", f->node,
+                   (unsigned long long)f->cycle, f->name, (unsigned long long)f->seq, f->msg);
+        }
+        else
+        {
+            checkFails[kept++] = *f;
+        }
+    }
+
+    checkNumFails = kept;
+}
+
+// -------------------------------------------------------------------------
+// VCheckAtExit()
+//
+// Wait for outstanding checks, and report failures and a summary
+// -------------------------------------------------------------------------
+
+static void VCheckAtExit (void)
+{
+    pthread_mutex_lock(&checkLock);
+
+    while (checkPending)
+    {
+        pthread_cond_wait(&checkDone, &checkLock);
+    }
+
+    VCheckReport(-1);
+
+    for (int node = 0; node < VP_MAX_NODES; node++)
+    {
+        if (checkNode[node].submitted)
+        {
+            VPrint("VCheck: node %d ran %llu checks with %llu failures\n", node,
+                   (unsigned long long)checkNode[node].completed, (unsigned long long)checkNode[node].failed);
+        }
+    }
+
+    pthread_mutex_unlock(&checkLock);
+}
+
+// -------------------------------------------------------------------------
+// VCheckInit()
+//
+// Start the worker threads, once only
+// -------------------------------------------------------------------------
+
+static void VCheckInit (void)
+{
+    char     *threads = getenv(VCHECK_THREADS_ENV);
+    pthread_t thread;
+
+    if (threads != NULL && threads[0] != '\0')
+    {
+        checkThreads = (int)strtol(threads, NULL, 0);
+    }
+    else
+    {
+        checkThreads = (int)sysconf(_SC_NPROCESSORS_ONLN) / 2;
+    }
+
+    if (checkThreads < 1)
+    {
+        checkThreads = 1;
+    }
+
+    for (int idx = 0; idx < checkThreads; idx++)
+    {
+        if (pthread_create(&thread, NULL, VCheckWorker, NULL) != 0)
+        {
+            VPrint("***Error: VCheck failed to create worker thread\n");
+            exit(1);
+        }
+
+        pthread_detach(thread);
+    }
+
+    atexit(VCheckAtExit);
+}
+
+// -------------------------------------------------------------------------
+// VCheckQueue()
+//
+// Create a job and queue it for the workers
+// -------------------------------------------------------------------------
+
+static uint64_t VCheckQueue (const unsigned node, const char *name, void *data, const size_t bytes, const int flags,
+                             const pVCheckFunc_t func, const pVCheckGen_t gen, void *ctx, const size_t ctx_size)
+{
+    VCheckJob_t *job = (VCheckJob_t *)calloc(1, sizeof(VCheckJob_t));
+    uint64_t     seq;
+
+    if (job == NULL)
+    {
+        VPrint("***Error: VCheck failed to allocate memory\n");
+        exit(1);
+    }
+
+    pthread_once(&checkOnce, VCheckInit);
+
+    job->node  = node;
+    job->cycle = ns[node]->stats.s.cycle;
+    job->bytes = bytes;
+    job->func  = func;
+    job->gen   = gen;
+
+    strncpy(job->name, name != NULL ? name : "", VCHECK_NAME_SIZE - 1);
+
+    if (flags & VCHECK_OWN)
+    {
+        job->data = data;
+    }
+    else
+    {
+        if ((job->data = malloc(bytes + 4)) == NULL)
+        {
+            VPrint("***Error: VCheck failed to allocate memory\n");
+            exit(1);
+        }
+
+        memcpy(job->data, data, bytes);
+    }
+
+    if (ctx_size)
+    {
+        if ((job->ctx = malloc(ctx_size)) == NULL)
+        {
+            VPrint("***Error: VCheck failed to allocate memory\n");
+            exit(1);
+        }
+
+        job->own_ctx = 1;
+        memcpy(job->ctx, ctx, ctx_size);
+    }
+    else
+    {
+        job->ctx     = ctx;
+    }
+
+    pthread_mutex_lock(&checkLock);
+
+    // Apply back pressure if the workers are falling behind
+    while (checkPending >= VP_CHECK_MAX_PENDING)
+    {
+        pthread_cond_wait(&checkDone, &checkLock);
+    }
+
+    seq      = ++checkNode[node].submitted;
+    job->seq = seq;
+
+    if (checkTail == NULL)
+    {
+        checkHead = job;
+    }
+    else
+    {
+        checkTail->next = job;
+    }
+
+    checkTail = job;
+    checkPending++;
+
+    pthread_cond_signal(&checkWork);
+    pthread_mutex_unlock(&checkLock);
+
+    return seq;
+}
+
+// =========================================================================
+// User API
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VCheckSubmit()
+//
+// Submit data for checking with a check function
+// -------------------------------------------------------------------------
+
+uint64_t VCheckSubmit (const unsigned node, const char *name, void *data, const size_t bytes, const int flags,
+                       const pVCheckFunc_t func, void *ctx, const size_t ctx_size)
+{
+    return VCheckQueue(node, name, data, bytes, flags, func, NULL, ctx, ctx_size);
+}
+
+// -------------------------------------------------------------------------
+// VCheckSubmitGen()
+//
+// Submit data for comparison with generated expected data
+// -------------------------------------------------------------------------
+
+uint64_t VCheckSubmitGen (const unsigned node, const char *name, void *data, const size_t bytes, const int flags,
+                          const pVCheckGen_t gen, void *ctx, const size_t ctx_size)
+{
+    return VCheckQueue(node, name, data, bytes, flags, NULL, gen, ctx, ctx_size);
+}
+
+// -------------------------------------------------------------------------
+// VCheckSync()
+//
+// Wait for the node's checks to complete and report its failures
+// -------------------------------------------------------------------------
+
+uint64_t VCheckSync (const unsigned node)
+{
+    uint64_t failed;
+
+    pthread_once(&checkOnce, VCheckInit);
+
+    pthread_mutex_lock(&checkLock);
+
+    while (checkNode[node].completed != checkNode[node].submitted)
+    {
+        pthread_cond_wait(&checkDone, &checkLock);
+    }
+
+    VCheckReport((int)node);
+
+    failed = checkNode[node].failed;
+
+    pthread_mutex_unlock(&checkLock);
+
+    return failed;
+}
@@ -0,0 +1,80 @@
+//=====================================================================
+//
+// VCheck.h                                           Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Deferred checking of data read by user code. A node submits the
+// data it has read with either a check function or a function that
+// generates the expected data, and continues issuing transactions
+// while a pool of worker threads runs the checks. Failures are
+// stamped with the node's clock cycle at submission, and reported in
+// cycle order when the node calls VCheckSync(), or at the end of
+// simulation, along with a summary of the checks run.
+//
+// The number of worker threads is set by the VPROC_CHECK_THREADS
+// environment variable (default half the available processors).
+//
+//=====================================================================
+
+#ifndef _VCHECK_H_
+#define _VCHECK_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define VCHECK_THREADS_ENV      "VPROC_CHECK_THREADS"
+
+// Checks outstanding before submission waits for the workers
+#ifndef VP_CHECK_MAX_PENDING
+#define VP_CHECK_MAX_PENDING    1024
+#endif
+
+// Length of check names and failure messages
+#define VCHECK_NAME_SIZE        64
+#define VCHECK_MSG_SIZE         256
+
+// Submission flags
+#define VCHECK_COPY             0       // Data is copied, and the buffer may be reused on return
+#define VCHECK_OWN              1       // Data buffer is from malloc() and is freed after the check
+
+// Check function, returning 0 if the data is good, or non-zero with
+// a message describing the failure in msg
+typedef int  (*pVCheckFunc_t) (const void *data, const size_t bytes, void *ctx, char *msg, const size_t msglen);
+
+// Expected data generator, filling expected with bytes bytes
+typedef void (*pVCheckGen_t)  (void *expected, const size_t bytes, void *ctx);
+
+// Submit data for checking by func. If ctx_size is non-zero, the
+// context is copied, otherwise the ctx pointer is passed as is and
+// must remain valid until the check is complete. Returns a sequence
+// number for the check.
+extern uint64_t VCheckSubmit    (const unsigned node, const char *name, void *data, const size_t bytes, const int flags,
+                                 const pVCheckFunc_t func, void *ctx, const size_t ctx_size);
+
+// Submit data for comparison with the output of gen
+extern uint64_t VCheckSubmitGen (const unsigned node, const char *name, void *data, const size_t bytes, const int flags,
+                                 const pVCheckGen_t gen, void *ctx, const size_t ctx_size);
+
+// Wait for all the node's checks to complete, report any new
+// failures, and return the node's total number of failures
+extern uint64_t VCheckSync      (const unsigned node);
+
+#endif
@@ -0,0 +1,183 @@
+//=====================================================================
+//
+// VLive.c                                            Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Live statistics published to a POSIX shared memory segment, for
+// monitoring a running simulation with tools/vptop.
+//
+//=====================================================================
+
+#include <string.h>
+#include <unistd.h>
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+#include "VProc.h"
+#include "VUser.h"
+
+// Pointer to mapped segment (NULL when disabled)
+VLiveSeg_t*      VLiveSeg = NULL;
+
+static int       liveInitialised = 0;
+static char      liveName[DEFAULT_STR_BUF_SIZE*2];
+
+// -------------------------------------------------------------------------
+// VLiveAtExit()
+//
+// Remove the shared memory segment name at the end of simulation.
+// The mapping is left in place, as other threads may still be
+// updating it, and is released when the process exits.
+// -------------------------------------------------------------------------
+
+static void VLiveAtExit (void)
+{
+#ifndef WIN32
+    shm_unlink(liveName);
+#endif
+}
+
+// =========================================================================
+// Internal functions
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VLiveInit()
+//
+// Called from VInit() for each node. Creates the segment on the
+// first call, if enabled in the environment.
+// -------------------------------------------------------------------------
+
+void VLiveInit (const unsigned node)
+{
+#ifndef WIN32
+    if (!liveInitialised)
+    {
+        char       *name = getenv(VLIVE_ENV);
+        VLiveSeg_t *seg;
+        int         fd;
+
+        liveInitialised = 1;
+
+        if (name == NULL)
+        {
+            return;
+        }
+
+        if (name[0] == '/')
+        {
+            snprintf(liveName, sizeof(liveName), "%s", name);
+        }
+        else
+        {
+            snprintf(liveName, sizeof(liveName), "%s%d", VLIVE_NAME_PREFIX, (int)getpid());
+        }
+
+        if ((fd = shm_open(liveName, O_CREAT | O_RDWR | O_TRUNC, 0644)) == -1 ||
+            ftruncate(fd, VLIVE_SEG_SIZE(VP_MAX_NODES)) == -1)
+        {
+            VPrint("***Error: VLiveInit() failed to create shared memory segment %s\n", liveName);
+            return;
+        }
+
+        seg = (VLiveSeg_t *) mmap(NULL, VLIVE_SEG_SIZE(VP_MAX_NODES), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (seg == MAP_FAILED)
+        {
+            VPrint("***Error: VLiveInit() failed to map shared memory segment %s\n", liveName);
+            shm_unlink(liveName);
+            return;
+        }
+
+        seg->version   = VLIVE_VERSION;
+        seg->max_nodes = VP_MAX_NODES;
+        seg->pid       = getpid();
+        seg->start_ns  = VStatsNowNs();
+
+        // Magic written last so readers only see a complete header
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        memcpy(seg->magic, VLIVE_MAGIC, strlen(VLIVE_MAGIC));
+
+        VPrint("VLiveInit(): live statistics in shared memory segment %s\n", liveName);
+
+        atexit(VLiveAtExit);
+        VLiveSeg = seg;
+    }
+
+    if (VLiveSeg != NULL)
+    {
+        VLIVE_STORE(VLiveSeg->node[node].state, VLIVE_STATE_RUNNING);
+    }
+#endif
+}
+
+// -------------------------------------------------------------------------
+// VLiveSchedIn()
+//
+// Called from VSched() on entry, after the statistics cycle count
+// has been updated
+// -------------------------------------------------------------------------
+
+void VLiveSchedIn (const unsigned node)
+{
+    VLiveNode_t *ln = &VLiveSeg->node[node];
+
+    VLIVE_STORE(ln->cycle,     ns[node]->stats.s.cycle);
+    VLIVE_STORE(ln->update_ns, VStatsNowNs());
+}
+
+// -------------------------------------------------------------------------
+// VLiveExchStart()
+//
+// Called from VExch() on entry, as the user thread blocks
+// -------------------------------------------------------------------------
+
+void VLiveExchStart (const unsigned node, const unsigned addr, const unsigned rw, const int ticks)
+{
+    VLiveNode_t *ln   = &VLiveSeg->node[node];
+    rw_t        *p_rw = (rw_t *)&rw;
+
+    if (p_rw->write || p_rw->read)
+    {
+        VLIVE_STORE(ln->txns,      ln->txns + 1);
+        VLIVE_STORE(ln->words,     ln->words + (p_rw->burstlen ? p_rw->burstlen : 1));
+        VLIVE_STORE(ln->last_addr, addr);
+        VLIVE_STORE(ln->state,     VLIVE_STATE_BLOCKED);
+    }
+    else
+    {
+        VLIVE_STORE(ln->ticks,     ln->ticks + 1);
+        VLIVE_STORE(ln->state,     ticks == GO_TO_SLEEP ? VLIVE_STATE_SLEEPING : VLIVE_STATE_BLOCKED);
+    }
+}
+
+// -------------------------------------------------------------------------
+// VLiveExchEnd()
+//
+// Called from VExch() before returning to user code
+// -------------------------------------------------------------------------
+
+void VLiveExchEnd (const unsigned node)
+{
+    VLIVE_STORE(VLiveSeg->node[node].state, VLIVE_STATE_RUNNING);
+}
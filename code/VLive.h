@@ -0,0 +1,94 @@
+//=====================================================================
+//
+// VLive.h                                            Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Live statistics shared memory segment layout. The segment is
+// written with relaxed atomic stores from VSched() and VExch(), and
+// read by monitoring tools (tools/vptop.c) attaching to a running
+// simulation. This header is shared with those tools and so is
+// self-contained.
+//
+//=====================================================================
+
+#ifndef _VLIVE_H_
+#define _VLIVE_H_
+
+#include <stdint.h>
+
+// Environment variable enabling the live statistics segment. If set
+// to a non-empty name (starting with '/') that is used as the POSIX
+// shared memory object name, otherwise "/vproc.<pid>" is used.
+#define VLIVE_ENV               "VPROC_LIVE_STATS"
+#define VLIVE_NAME_PREFIX       "/vproc."
+
+#define VLIVE_MAGIC             "VPLIVE"
+#define VLIVE_VERSION           1
+
+// Node states
+#define VLIVE_STATE_IDLE        0       // Node not initialised
+#define VLIVE_STATE_RUNNING     1       // User code running
+#define VLIVE_STATE_BLOCKED     2       // User thread waiting on simulation
+#define VLIVE_STATE_SLEEPING    3       // User thread ticking forever
+
+// Per-node counters, on their own cache line
+typedef struct {
+    uint64_t            cycle;          // Current simulation cycle
+    uint64_t            txns;           // Bus transactions issued
+    uint64_t            ticks;          // Tick commands issued
+    uint64_t            words;          // Words transferred
+    uint64_t            update_ns;      // CLOCK_MONOTONIC time of last update
+    uint32_t            last_addr;      // Address of last transaction
+    uint32_t            state;          // VLIVE_STATE_xxx
+    uint8_t             pad[16];
+} __attribute__((aligned(64))) VLiveNode_t;
+
+// Segment header, followed by max_nodes VLiveNode_t entries
+typedef struct {
+    char                magic[8];
+    uint32_t            version;
+    uint32_t            max_nodes;
+    uint64_t            pid;
+    uint64_t            start_ns;       // CLOCK_MONOTONIC time segment was created
+    uint8_t             pad[32];
+    VLiveNode_t         node[];
+} VLiveSeg_t;
+
+#define VLIVE_SEG_SIZE(_nodes)  (sizeof(VLiveSeg_t) + (_nodes) * sizeof(VLiveNode_t))
+
+// Relaxed store/load of a counter
+#define VLIVE_STORE(_var, _val) __atomic_store_n(&(_var), (_val), __ATOMIC_RELAXED)
+#define VLIVE_LOAD(_var)        __atomic_load_n(&(_var), __ATOMIC_RELAXED)
+
+#ifndef VLIVE_NO_PROTOTYPES
+
+// Pointer to mapped segment (NULL when disabled)
+extern VLiveSeg_t* VLiveSeg;
+
+// Internal functions called from VSched.c and VUser.c
+extern void VLiveInit       (const unsigned node);
+extern void VLiveSchedIn    (const unsigned node);
+extern void VLiveExchStart  (const unsigned node, const unsigned addr, const unsigned rw, const int ticks);
+extern void VLiveExchEnd    (const unsigned node);
+
+#endif
+
+#endif
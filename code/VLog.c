@@ -0,0 +1,386 @@
+//=====================================================================
+//
+// VLog.c                                             Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Buffered logging (see VLog.h). Each node's ring has a single
+// producer (the node's user thread) and a single consumer (the
+// writer thread), so the indexes need only acquire/release ordering.
+// A producer wakes the writer when it writes to an empty ring, and
+// the writer otherwise polls, so a busy ring is drained in batches.
+//
+//=====================================================================
+
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <time.h>
+#include "VProc.h"
+#include "VUser.h"
+#include "VLog.h"
+
+// Writer thread poll interval when not woken (ms)
+#define VLOG_POLL_MS            100
+
+// Producer back off when its ring is full (us)
+#define VLOG_FULL_WAIT_US       50
+
+static pthread_once_t     logOnce       = PTHREAD_ONCE_INIT;
+static VLogRing_t        *logRing[VP_MAX_NODES];
+static FILE              *logFp[VP_MAX_NODES];
+static FILE              *logMergedFp   = NULL;
+static char               logName[DEFAULT_STR_BUF_SIZE*4];
+static int                logPerNode    = 0;
+static volatile unsigned  logLevel      = VLOG_INFO;
+static volatile uint32_t  logCats       = 0xffffffff;
+static volatile int       logStop       = 0;
+static sem_t              logWake;
+static pthread_t          logThread;
+
+static const char        *logLevelName[] = {"ERROR", "WARN", "INFO", "DEBUG"};
+
+// -------------------------------------------------------------------------
+// VLogFile()
+//
+// Get the output file for a node's messages, opening it if needed
+// -------------------------------------------------------------------------
+
+static FILE *VLogFile (const unsigned node)
+{
+    char fname[DEFAULT_STR_BUF_SIZE*5];
+
+    if (!logPerNode)
+    {
+        return logMergedFp;
+    }
+
+    if (logFp[node] == NULL)
+    {
+        snprintf(fname, sizeof(fname), "%s.%d", logName[0] ? logName : "vproc.log", node);
+
+        if ((logFp[node] = fopen(fname, "w")) == NULL)
+        {
+            VPrint("***Error: VLog failed to open %s\n", fname);
+            exit(1);
+        }
+    }
+
+    return logFp[node];
+}
+
+// -------------------------------------------------------------------------
+// VLogDrain()
+//
+// Write out all the messages in every node's ring
+// -------------------------------------------------------------------------
+
+static void VLogDrain (void)
+{
+    for (int node = 0; node < VP_MAX_NODES; node++)
+    {
+        VLogRing_t *ring = __atomic_load_n(&logRing[node], __ATOMIC_ACQUIRE);
+        uint32_t    rd, wr;
+        FILE       *fp;
+
+        if (ring == NULL)
+        {
+            continue;
+        }
+
+        rd = ring->rd;
+        wr = __atomic_load_n(&ring->wr, __ATOMIC_ACQUIRE);
+
+        if (rd == wr)
+        {
+            continue;
+        }
+
+        fp = VLogFile(node);
+
+        for (; rd != wr; rd++)
+        {
+            VLogMsg_t *m   = &ring->slot[rd & VLOG_SLOT_MASK];
+            size_t     len = strlen(m->msg);
+
+            // Lines are terminated here, so drop any trailing newline
+            if (len && m->msg[len-1] == '\n')
+            {
+                m->msg[len-1] = '\0';
+            }
+
+            fprintf(fp, "%10llu %3d %-5s %08x: %s\n", (unsigned long long)m->cycle, node,
+                    logLevelName[m->level], m->cat, m->msg);
+        }
+
+        fflush(fp);
+
+        __atomic_store_n(&ring->rd, rd, __ATOMIC_RELEASE);
+    }
+}
+
+// -------------------------------------------------------------------------
+// VLogWriter()
+//
+// Writer thread
+// -------------------------------------------------------------------------
+
+static void *VLogWriter (void *arg)
+{
+    while (!logStop)
+    {
+        struct timespec ts;
+
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += VLOG_POLL_MS * 1000000L;
+        ts.tv_sec  += ts.tv_nsec / 1000000000L;
+        ts.tv_nsec %= 1000000000L;
+
+        sem_timedwait(&logWake, &ts);
+
+        VLogDrain();
+    }
+
+    VLogDrain();
+
+    return NULL;
+}
+
+// -------------------------------------------------------------------------
+// VLogAtExit()
+//
+// Stop the writer thread, once it has written out all messages
+// -------------------------------------------------------------------------
+
+static void VLogAtExit (void)
+{
+    logStop = 1;
+    sem_post(&logWake);
+    pthread_join(logThread, NULL);
+
+    for (int node = 0; node < VP_MAX_NODES; node++)
+    {
+        if (logRing[node] != NULL && logRing[node]->waits)
+        {
+            VPrint("VLog: node %d waited %llu times for a full log buffer\n", node,
+                   (unsigned long long)logRing[node]->waits);
+        }
+
+        if (logFp[node] != NULL)
+        {
+            fclose(logFp[node]);
+        }
+    }
+
+    if (logMergedFp != NULL && logMergedFp != stdout)
+    {
+        fclose(logMergedFp);
+    }
+}
+
+// -------------------------------------------------------------------------
+// VLogInit()
+//
+// Get settings and start the writer thread, once only
+// -------------------------------------------------------------------------
+
+static void VLogInit (void)
+{
+    char *fname   = getenv(VLOG_FILE_ENV);
+    char *pernode = getenv(VLOG_PER_NODE_ENV);
+    char *level   = getenv(VLOG_LEVEL_ENV);
+    char *cats    = getenv(VLOG_CATS_ENV);
+
+    if (fname != NULL)
+    {
+        strncpy(logName, fname, sizeof(logName) - 1);
+    }
+
+    logPerNode = pernode != NULL && strtol(pernode, NULL, 0) != 0;
+
+    if (level != NULL && level[0] != '\0')
+    {
+        logLevel = VLOG_DEBUG + 1;
+
+        for (unsigned idx = VLOG_ERROR; idx <= VLOG_DEBUG; idx++)
+        {
+            if (strcasecmp(level, logLevelName[idx]) == 0)
+            {
+                logLevel = idx;
+            }
+        }
+
+        if (logLevel > VLOG_DEBUG)
+        {
+            logLevel = (unsigned)strtoul(level, NULL, 0);
+        }
+    }
+
+    if (cats != NULL && cats[0] != '\0')
+    {
+        logCats = (uint32_t)strtoul(cats, NULL, 16);
+    }
+
+    if (!logPerNode)
+    {
+        if (logName[0] == '\0')
+        {
+            logMergedFp = stdout;
+        }
+        else if ((logMergedFp = fopen(logName, "w")) == NULL)
+        {
+            VPrint("***Error: VLog failed to open %s\n", logName);
+            exit(1);
+        }
+    }
+
+    sem_init(&logWake, 0, 0);
+
+    if (pthread_create(&logThread, NULL, VLogWriter, NULL) != 0)
+    {
+        VPrint("***Error: VLog failed to create writer thread\n");
+        exit(1);
+    }
+
+    atexit(VLogAtExit);
+}
+
+// =========================================================================
+// User API
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VLogEnabled()
+//
+// Returns non-zero if messages of the level and category are logged
+// -------------------------------------------------------------------------
+
+int VLogEnabled (const unsigned level, const uint32_t cat)
+{
+    pthread_once(&logOnce, VLogInit);
+
+    return level <= logLevel && (cat == 0 || (cat & logCats));
+}
+
+// -------------------------------------------------------------------------
+// VLog()
+//
+// Log a message from a node's user thread
+// -------------------------------------------------------------------------
+
+void VLog (const unsigned node, const unsigned level, const uint32_t cat, const char *fmt, ...)
+{
+    VLogRing_t *ring;
+    VLogMsg_t  *m;
+    uint32_t    wr, rd;
+    va_list     args;
+
+    if (!VLogEnabled(level, cat))
+    {
+        return;
+    }
+
+    if ((ring = logRing[node]) == NULL)
+    {
+        if (posix_memalign((void **)&ring, 64, sizeof(VLogRing_t)) != 0)
+        {
+            VPrint("***Error: VLog failed to allocate buffer for node %d\n", node);
+            exit(1);
+        }
+
+        memset(ring, 0, sizeof(VLogRing_t));
+        __atomic_store_n(&logRing[node], ring, __ATOMIC_RELEASE);
+    }
+
+    wr = ring->wr;
+
+    // Wait for the writer thread if the ring is full
+    while (wr - (rd = __atomic_load_n(&ring->rd, __ATOMIC_ACQUIRE)) >= VP_LOG_SLOTS)
+    {
+        ring->waits++;
+        sem_post(&logWake);
+        usleep(VLOG_FULL_WAIT_US);
+    }
+
+    m        = &ring->slot[wr & VLOG_SLOT_MASK];
+    m->cycle = ns[node]->stats.s.cycle;
+    m->level = level > VLOG_DEBUG ? VLOG_DEBUG : level;
+    m->cat   = cat;
+
+    va_start(args, fmt);
+    vsnprintf(m->msg, VP_LOG_MSG_SIZE, fmt, args);
+    va_end(args);
+
+    __atomic_store_n(&ring->wr, wr + 1, __ATOMIC_RELEASE);
+
+    if (wr == rd)
+    {
+        sem_post(&logWake);
+    }
+}
+
+// -------------------------------------------------------------------------
+// VLogSetLevel()
+//
+// Set the highest level logged
+// -------------------------------------------------------------------------
+
+void VLogSetLevel (const unsigned level)
+{
+    pthread_once(&logOnce, VLogInit);
+
+    logLevel = level;
+}
+
+// -------------------------------------------------------------------------
+// VLogSetCats()
+//
+// Set the mask of categories logged
+// -------------------------------------------------------------------------
+
+void VLogSetCats (const uint32_t cats)
+{
+    pthread_once(&logOnce, VLogInit);
+
+    logCats = cats;
+}
+
+// -------------------------------------------------------------------------
+// VLogFlush()
+//
+// Wait until all messages logged so far have been written
+// -------------------------------------------------------------------------
+
+void VLogFlush (void)
+{
+    pthread_once(&logOnce, VLogInit);
+
+    for (int node = 0; node < VP_MAX_NODES; node++)
+    {
+        VLogRing_t *ring = __atomic_load_n(&logRing[node], __ATOMIC_ACQUIRE);
+
+        while (ring != NULL && __atomic_load_n(&ring->rd, __ATOMIC_ACQUIRE) != ring->wr)
+        {
+            sem_post(&logWake);
+            usleep(VLOG_FULL_WAIT_US);
+        }
+    }
+}
@@ -0,0 +1,102 @@
+//=====================================================================
+//
+// VLog.h                                             Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Buffered logging from user code. Each node has a lock-free ring of
+// message slots, written only by the node's user thread, which a
+// background writer thread drains to a single merged log or to a log
+// per node. Messages are stamped with the node's clock cycle, node
+// number, level and category, and are filtered by level and a mask
+// of categories before being formatted, so disabled messages cost
+// little. Output is written at the end of simulation if not before.
+//
+// Settings are taken from environment variables:
+//
+//   VPROC_LOG_FILE     Log file name (default standard output)
+//   VPROC_LOG_PER_NODE Non-zero for a file per node, "<name>.<node>"
+//   VPROC_LOG_LEVEL    Highest level logged, as a number or name
+//                      (default info)
+//   VPROC_LOG_CATS     Hex mask of categories logged (default all).
+//                      Messages with category 0 are always logged.
+//
+//=====================================================================
+
+#ifndef _VLOG_H_
+#define _VLOG_H_
+
+#include <stdint.h>
+
+#define VLOG_FILE_ENV           "VPROC_LOG_FILE"
+#define VLOG_PER_NODE_ENV       "VPROC_LOG_PER_NODE"
+#define VLOG_LEVEL_ENV          "VPROC_LOG_LEVEL"
+#define VLOG_CATS_ENV           "VPROC_LOG_CATS"
+
+// Log levels
+#define VLOG_ERROR              0
+#define VLOG_WARN               1
+#define VLOG_INFO               2
+#define VLOG_DEBUG              3
+
+// Message slots in each node's ring (must be a power of 2)
+#ifndef VP_LOG_SLOTS
+#define VP_LOG_SLOTS            1024
+#endif
+
+// Longest message, including the terminating null (longer ones are
+// truncated)
+#ifndef VP_LOG_MSG_SIZE
+#define VP_LOG_MSG_SIZE         240
+#endif
+
+#define VLOG_SLOT_MASK          (VP_LOG_SLOTS - 1)
+
+// Message slot
+typedef struct {
+    uint64_t            cycle;
+    uint32_t            level;
+    uint32_t            cat;
+    char                msg[VP_LOG_MSG_SIZE];
+} VLogMsg_t;
+
+// Per-node ring
+typedef struct {
+    volatile uint32_t   wr          __attribute__((aligned(64)));  // Written by the node's user thread
+    volatile uint32_t   rd          __attribute__((aligned(64)));  // Written by the writer thread
+    uint64_t            waits;          // Times the node found its ring full
+    VLogMsg_t           slot[VP_LOG_SLOTS];
+} VLogRing_t;
+
+// Log a message from a node's user thread, with printf style format
+extern void VLog         (const unsigned node, const unsigned level, const uint32_t cat, const char *fmt, ...)
+                         __attribute__((format(printf, 4, 5)));
+
+// Returns non-zero if messages of a level and category are logged
+extern int  VLogEnabled  (const unsigned level, const uint32_t cat);
+
+// Change the level and categories logged at run time
+extern void VLogSetLevel (const unsigned level);
+extern void VLogSetCats  (const uint32_t cats);
+
+// Wait until all messages logged so far have been written
+extern void VLogFlush    (void);
+
+#endif
@@ -0,0 +1,352 @@
+//=====================================================================
+//
+// VMbox.c                                            Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Node to node mailboxes and barriers (see VMbox.h). Each mailbox is
+// a bounded multi-producer, multi-consumer ring, where each cell has
+// a sequence number that says whether it's free for the sender, or
+// full for the receiver, at a given position, and senders and
+// receivers claim positions with a compare and swap. A barrier is an
+// arrival count and a generation number, incremented by the last node
+// to arrive to release the others.
+//
+// A node that must wait records the operation in its park state and
+// ticks. VSchedNode() then calls VMboxParked() on each cycle, which
+// retries the operation on the simulation thread, returning to the
+// user thread only when it completes.
+//
+//=====================================================================
+
+#include "VProc.h"
+#include "VUser.h"
+#include "VMbox.h"
+
+#define VMBOX_MASK              (VMBOX_DEPTH - 1)
+
+#if (VMBOX_DEPTH & VMBOX_MASK) != 0
+#error "VMBOX_DEPTH must be a power of 2"
+#endif
+
+// Parked operations
+#define VMBOX_OP_NONE           0
+#define VMBOX_OP_SEND           1
+#define VMBOX_OP_RECV           2
+#define VMBOX_OP_BARRIER        3
+
+// Mailbox cell. The sequence number is held less the cell's index, so
+// that a zeroed mailbox is empty.
+typedef struct {
+    uint64_t            seq;
+    VMboxMsg_t          msg;
+} VMboxCell_t;
+
+typedef struct {
+    VMboxCell_t         cell[VMBOX_DEPTH];
+    uint64_t            head;           // Next position to receive from
+    uint64_t            tail;           // Next position to send to
+} VMbox_t;
+
+typedef struct {
+    uint32_t            count;          // Nodes arrived in this generation
+    uint32_t            gen;
+} VBarrier_t;
+
+// Per-node park state
+typedef struct {
+    int                 op;
+    unsigned            id;
+    uint64_t            data;
+    VMboxMsg_t         *msg;
+    uint32_t            gen;
+} VMboxPark_t;
+
+static VMbox_t          mbox[VP_MAX_MBOX];
+static VBarrier_t       barrier[VP_MAX_BARRIER];
+static VMboxPark_t      mboxPark[VP_MAX_NODES];
+
+// -------------------------------------------------------------------------
+// VMboxGet()
+//
+// Get a mailbox, checking its number
+// -------------------------------------------------------------------------
+
+static VMbox_t *VMboxGet (const unsigned id)
+{
+    if (id >= VP_MAX_MBOX)
+    {
+        VPrint("***Error: VMbox mailbox %d out of range (VP_MAX_MBOX is %d)\n", id, VP_MAX_MBOX);
+        exit(1);
+    }
+
+    return &mbox[id];
+}
+
+// -------------------------------------------------------------------------
+// VMboxPut()
+//
+// Send a message to a mailbox, stamped with the node's current cycle.
+// Returns 1 if sent, or 0 if the mailbox is full.
+// -------------------------------------------------------------------------
+
+static int VMboxPut (VMbox_t *mb, const uint64_t data, const unsigned node)
+{
+    uint64_t pos = __atomic_load_n(&mb->tail, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        unsigned     idx = pos & VMBOX_MASK;
+        VMboxCell_t *c   = &mb->cell[idx];
+        int64_t      dif = (int64_t)(__atomic_load_n(&c->seq, __ATOMIC_ACQUIRE) + idx - pos);
+
+        if (dif == 0)
+        {
+            if (__atomic_compare_exchange_n(&mb->tail, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                c->msg.data  = data;
+                c->msg.cycle = ns[node]->stats.s.cycle;
+                c->msg.src   = node;
+
+                __atomic_store_n(&c->seq, pos + 1 - idx, __ATOMIC_RELEASE);
+
+                return 1;
+            }
+        }
+        else if (dif < 0)
+        {
+            // Cell not yet received from a lap ago, so full
+            return 0;
+        }
+        else
+        {
+            pos = __atomic_load_n(&mb->tail, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+// VMboxTake()
+//
+// Receive a message from a mailbox. Returns 1 if received, or 0 if the
+// mailbox is empty.
+// -------------------------------------------------------------------------
+
+static int VMboxTake (VMbox_t *mb, VMboxMsg_t *msg)
+{
+    uint64_t pos = __atomic_load_n(&mb->head, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        unsigned     idx = pos & VMBOX_MASK;
+        VMboxCell_t *c   = &mb->cell[idx];
+        int64_t      dif = (int64_t)(__atomic_load_n(&c->seq, __ATOMIC_ACQUIRE) + idx - (pos + 1));
+
+        if (dif == 0)
+        {
+            if (__atomic_compare_exchange_n(&mb->head, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                if (msg != NULL)
+                {
+                    *msg = c->msg;
+                }
+
+                __atomic_store_n(&c->seq, pos + VMBOX_DEPTH - idx, __ATOMIC_RELEASE);
+
+                return 1;
+            }
+        }
+        else if (dif < 0)
+        {
+            // Cell not yet sent to, so empty
+            return 0;
+        }
+        else
+        {
+            pos = __atomic_load_n(&mb->head, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+// VMboxPark()
+//
+// Park the node until its recorded operation completes. The simulation
+// thread retries the operation on each cycle after this tick, and
+// exchanges with the user thread again only when it's done. Out of
+// process user code, whose park state the simulation thread can't see,
+// retries here at each cycle instead.
+// -------------------------------------------------------------------------
+
+static void VMboxPark (const unsigned node)
+{
+    do
+    {
+        VTick(1, node);
+    }
+    while (VMboxParked(node));
+}
+
+// =========================================================================
+// Internal functions
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VMboxParked()
+//
+// Retry a parked node's operation. Returns 1 if the node is still
+// parked (and is to tick another cycle), else 0.
+// -------------------------------------------------------------------------
+
+int VMboxParked (const unsigned node)
+{
+    VMboxPark_t *p = &mboxPark[node];
+    int          done;
+
+    switch (p->op)
+    {
+    case VMBOX_OP_NONE:
+        return 0;
+
+    case VMBOX_OP_SEND:
+        done = VMboxPut(&mbox[p->id], p->data, node);
+        break;
+
+    case VMBOX_OP_RECV:
+        done = VMboxTake(&mbox[p->id], p->msg);
+        break;
+
+    default:
+        done = __atomic_load_n(&barrier[p->id].gen, __ATOMIC_ACQUIRE) != p->gen;
+        break;
+    }
+
+    if (done)
+    {
+        p->op = VMBOX_OP_NONE;
+    }
+
+    return !done;
+}
+
+// =========================================================================
+// User API
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VMboxTrySend()
+//
+// Send data to a mailbox if not full
+// -------------------------------------------------------------------------
+
+int VMboxTrySend (const unsigned mbox, const uint64_t data, const unsigned node)
+{
+    return VMboxPut(VMboxGet(mbox), data, node);
+}
+
+// -------------------------------------------------------------------------
+// VMboxTryRecv()
+//
+// Receive a message from a mailbox if not empty
+// -------------------------------------------------------------------------
+
+int VMboxTryRecv (const unsigned mbox, VMboxMsg_t *msg, const unsigned node)
+{
+    return VMboxTake(VMboxGet(mbox), msg);
+}
+
+// -------------------------------------------------------------------------
+// VMboxSend()
+//
+// Send data to a mailbox, waiting while it's full
+// -------------------------------------------------------------------------
+
+int VMboxSend (const unsigned mbox, const uint64_t data, const unsigned node)
+{
+    if (!VMboxPut(VMboxGet(mbox), data, node))
+    {
+        mboxPark[node].id   = mbox;
+        mboxPark[node].data = data;
+        mboxPark[node].op   = VMBOX_OP_SEND;
+
+        VMboxPark(node);
+    }
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// VMboxRecv()
+//
+// Receive a message from a mailbox, waiting while it's empty
+// -------------------------------------------------------------------------
+
+int VMboxRecv (const unsigned mbox, VMboxMsg_t *msg, const unsigned node)
+{
+    if (!VMboxTake(VMboxGet(mbox), msg))
+    {
+        mboxPark[node].id   = mbox;
+        mboxPark[node].msg  = msg;
+        mboxPark[node].op   = VMBOX_OP_RECV;
+
+        VMboxPark(node);
+    }
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// VBarrier()
+//
+// Wait at a barrier until parties nodes have arrived
+// -------------------------------------------------------------------------
+
+uint64_t VBarrier (const unsigned id, const unsigned parties, const unsigned node)
+{
+    VBarrier_t *b;
+    uint32_t    gen;
+
+    if (id >= VP_MAX_BARRIER)
+    {
+        VPrint("***Error: VBarrier barrier %d out of range (VP_MAX_BARRIER is %d)\n", id, VP_MAX_BARRIER);
+        exit(1);
+    }
+
+    b   = &barrier[id];
+    gen = __atomic_load_n(&b->gen, __ATOMIC_ACQUIRE);
+
+    if (__atomic_add_fetch(&b->count, 1, __ATOMIC_ACQ_REL) >= parties)
+    {
+        // Last to arrive, so reset the count for the next generation
+        // and release the waiting nodes
+        __atomic_store_n(&b->count, 0, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&b->gen, 1, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        mboxPark[node].id   = id;
+        mboxPark[node].gen  = gen;
+        mboxPark[node].op   = VMBOX_OP_BARRIER;
+
+        VMboxPark(node);
+    }
+
+    return ns[node]->stats.s.cycle;
+}
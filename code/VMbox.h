@@ -0,0 +1,83 @@
+//=====================================================================
+//
+// VMbox.h                                            Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Node to node mailboxes and barriers, for nodes in the same
+// simulation (and process) to coordinate without HDL shared
+// registers. A mailbox is a bounded queue of VMBOX_DEPTH messages,
+// each stamped with the sending node and its clock cycle, which any
+// node may send to or receive from. A barrier releases all the nodes
+// waiting at it when the given number of nodes have arrived.
+//
+// Mailboxes and barriers are lock-free. When a node must wait (a full
+// or empty mailbox, or a barrier not yet complete) it is parked: the
+// user thread is blocked and the node idles, with the simulation
+// thread retrying the operation at each clock cycle, without switching
+// to the user thread, until it completes.
+//
+//=====================================================================
+
+#ifndef _VMBOX_H_
+#define _VMBOX_H_
+
+#include <stdint.h>
+
+// Number of mailboxes and barriers
+#ifndef VP_MAX_MBOX
+#define VP_MAX_MBOX             64
+#endif
+
+#ifndef VP_MAX_BARRIER
+#define VP_MAX_BARRIER          16
+#endif
+
+// Messages held by each mailbox (a power of 2)
+#ifndef VMBOX_DEPTH
+#define VMBOX_DEPTH             16
+#endif
+
+// Mailbox message
+typedef struct {
+    uint64_t            data;
+    uint64_t            cycle;          // Sending node's clock cycle when sent
+    unsigned            src;            // Sending node
+} VMboxMsg_t;
+
+// Send data to a mailbox, parking the node while the mailbox is full
+extern int  VMboxSend       (const unsigned mbox, const uint64_t data, const unsigned node);
+
+// Receive a message from a mailbox, parking the node while the mailbox is empty
+extern int  VMboxRecv       (const unsigned mbox, VMboxMsg_t *msg, const unsigned node);
+
+// Non-blocking send and receive, returning 1 on success, or 0 if the
+// mailbox is full or empty
+extern int  VMboxTrySend    (const unsigned mbox, const uint64_t data, const unsigned node);
+extern int  VMboxTryRecv    (const unsigned mbox, VMboxMsg_t *msg, const unsigned node);
+
+// Wait at a barrier until parties nodes (including this one) have
+// arrived. Returns the cycle at which the node was released.
+extern uint64_t VBarrier    (const unsigned barrier, const unsigned parties, const unsigned node);
+
+// Internal function called from VSched.c
+extern int  VMboxParked     (const unsigned node);
+
+#endif
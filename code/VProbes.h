@@ -0,0 +1,79 @@
+//=====================================================================
+//
+// VProbes.h                                          Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// USDT static tracepoints (provider "vproc") for use with perf and
+// bpftrace. Probes are compiled in when <sys/sdt.h> is available
+// (e.g. from the systemtap-sdt-dev package) and are a single nop
+// instruction until attached to. Define VPROC_NO_USDT to remove them.
+//
+// Probes and arguments:
+//
+//   txn_issue    (node, op, addr, len)   VExch() entry, user thread
+//   txn_complete (node, op, addr, len)   VExch() return, user thread
+//   sched_post   (node, cycle)           VSched() releasing user thread
+//   sched_wake   (node, op, addr, len)   VSched() woken with a new command
+//   burst_beat   (node, idx, out, in)    VAccess() for each burst word
+//   irq          (node, value)           VIrq() delivering an interrupt
+//
+// The op argument is one of the VTRACE_OP_xxx values and len is the
+// burst length (0 for single word accesses and ticks).
+//
+//=====================================================================
+
+#ifndef _VPROBES_H_
+#define _VPROBES_H_
+
+#if !defined(VPROC_NO_USDT) && defined(__has_include)
+# if __has_include(<sys/sdt.h>)
+#  include <sys/sdt.h>
+#  define VPROC_USDT
+# endif
+#endif
+
+// Decode rw exchange field into a VTRACE_OP_xxx value and a burst length
+#define VPROBE_LEN(_rw)         (((_rw) >> 2) & 0xfff)
+#define VPROBE_OP(_rw)          (((_rw) & 1) ? (VPROBE_LEN(_rw) ? VTRACE_OP_BURST_WRITE : VTRACE_OP_WRITE) : \
+                                 ((_rw) & 2) ? (VPROBE_LEN(_rw) ? VTRACE_OP_BURST_READ  : VTRACE_OP_READ)  : \
+                                 VTRACE_OP_TICK)
+
+#ifdef VPROC_USDT
+
+# define VPROBE_TXN_ISSUE(_node, _rw, _addr)    DTRACE_PROBE4(vproc, txn_issue,    _node, VPROBE_OP(_rw), _addr, VPROBE_LEN(_rw))
+# define VPROBE_TXN_COMPLETE(_node, _rw, _addr) DTRACE_PROBE4(vproc, txn_complete, _node, VPROBE_OP(_rw), _addr, VPROBE_LEN(_rw))
+# define VPROBE_SCHED_POST(_node, _cycle)       DTRACE_PROBE2(vproc, sched_post,   _node, _cycle)
+# define VPROBE_SCHED_WAKE(_node, _rw, _addr)   DTRACE_PROBE4(vproc, sched_wake,   _node, VPROBE_OP(_rw), _addr, VPROBE_LEN(_rw))
+# define VPROBE_BURST_BEAT(_node, _idx, _out, _in) DTRACE_PROBE4(vproc, burst_beat, _node, _idx, _out, _in)
+# define VPROBE_IRQ(_node, _value)              DTRACE_PROBE2(vproc, irq,          _node, _value)
+
+#else
+
+# define VPROBE_TXN_ISSUE(_node, _rw, _addr)
+# define VPROBE_TXN_COMPLETE(_node, _rw, _addr)
+# define VPROBE_SCHED_POST(_node, _cycle)
+# define VPROBE_SCHED_WAKE(_node, _rw, _addr)
+# define VPROBE_BURST_BEAT(_node, _idx, _out, _in)
+# define VPROBE_IRQ(_node, _value)
+
+#endif
+
+#endif
@@ -34,6 +34,13 @@
 #include <dlfcn.h>
 #include <pthread.h>
 #include <semaphore.h>
+#include "VStats.h"
+#include "VTrace.h"
+#include "VTimeline.h"
+#include "VProbes.h"
+#include "VLive.h"
+#include "VRemote.h"
+#include "VReplay.h"
 
 #define VERSION_STRING         "VProc version 1.13.4. Copyright (c) 2004-2025 Simon Southwell."
 
@@ -58,10 +65,11 @@
 #define VPINTERRUPT_ARG         2
 #define VPVALUE_ARG             2
 #define VPDATAIN_ARG            2
-#define VPDATAOUT_ARG           3
-#define VPADDR_ARG              4
-#define VPRW_ARG                5
-#define VPTICKS_ARG             6
+#define VPCYCLE_ARG             3
+#define VPDATAOUT_ARG           4
+#define VPADDR_ARG              5
+#define VPRW_ARG                6
+#define VPTICKS_ARG             7
 
 #define VPINDEX_ARG             2
 #define VPACCESSIN_ARG          3   
@@ -86,9 +94,24 @@ typedef struct {
     uint32_t burstlen : 12;
     uint32_t fbe      : 4;
     uint32_t lbe      : 4;
-    uint32_t rsvd     : 10;
+    uint32_t reset    : 1;
+    uint32_t nowait   : 1;
+    uint32_t sig      : 2;
+    uint32_t rsvd     : 6;
 } rw_t;
 
+// Delta cycle command vector entry (see VDeltaVec())
+typedef struct {
+    unsigned int        addr;
+    unsigned int        data;
+    unsigned int        flags;
+} VDeltaCmd_t;
+
+// VDeltaCmd_t flags
+#define VDELTA_WRITE            0x1
+#define VDELTA_READ             0x2
+#define VDELTA_NOWAIT           0x4     // HDL not to wait for UpdateResponse
+
 
 // User thread to simulation exchange structure
 typedef struct {
@@ -128,6 +151,13 @@ typedef struct {
     pPyIrqCB_t          PyIrqCB;
     vecIrqState_t       irqState;
     pVUserCB_t          VUserCB;
+    VStatsState_t       stats;
+    VTraceState_t*      trace;
+    VRemoteSeg_t*       remote;
+    VReplayState_t*     replay;
+    VDeltaCmd_t*        vec;
+    unsigned            vec_len;
+    unsigned            vec_idx;
 } SchedState_t, *pSchedState_t;
 
 // Reference to node state array
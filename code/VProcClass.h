@@ -29,6 +29,7 @@
 extern "C"
 {
 #include "VUser.h"
+#include "VMbox.h"
 }
 
 class VProc
@@ -63,8 +64,22 @@ public:
     int  burstWrite      (const unsigned   addr,           void    *data, const unsigned wordlen)    {return VBurstWrite     (addr,      data, wordlen, node);};
     int  burstRead       (const unsigned   addr,           void    *data, const unsigned wordlen)    {return VBurstRead      (addr,      data, wordlen, node);};
     int  tick            (const unsigned   ticks)                                                    {return VTick           (ticks,                    node);};
+    int  reset           (const unsigned   ticks)                                                    {return VReset          (ticks,                    node);};
+    int  deltaVec        (VDeltaCmd_t     *cmds,     const unsigned num)                             {return VDeltaVec       (cmds,      num,           node);};
+#ifdef VSIGNAL_SUPPORTED
+# ifndef VPROC_SV
+    int  signalIdx       (const char      *name)                                                     {return VSignalIdx      (name,                     node);};
+# endif
+    int  setSignal       (const int        idx,      const unsigned value)                           {return VSetSignal      (idx,       value,         node);};
+    int  getSignal       (const int        idx,            unsigned *value)                          {return VGetSignal      (idx,       value,         node);};
+    int  waitSignal      (const int        idx,      const unsigned value)                           {return VWaitSignal     (idx,       value,         node);};
+#endif
+    int  mboxSend        (const unsigned   mbox,     const uint64_t data)                            {return VMboxSend       (mbox,      data,          node);};
+    int  mboxRecv        (const unsigned   mbox,           VMboxMsg_t *msg)                          {return VMboxRecv       (mbox,      msg,           node);};
+    uint64_t barrier     (const unsigned   id,       const unsigned parties)                         {return VBarrier        (id,        parties,       node);};
     void regIrq          (const pVUserIrqCB_t func)                                                  {       VRegIrq         (func,                     node);};
     void regUser         (const pVUserCB_t func)                                                     {       VRegUser        (func,                     node);};
+    int  getStats        (pVStats_t        stats)                                                    {return VGetStats       (node,  stats);};
 
 
     int  burstWriteBytes (const unsigned   byteaddr,       void    *data, const unsigned bytelen) {unsigned foff, loff;
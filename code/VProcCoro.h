@@ -0,0 +1,326 @@
+//=====================================================================
+//
+// VProcCoro.h                                        Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// C++20 coroutine API, for running many independent stimulus
+// sequences on one node's user thread. Sequences are coroutines
+// returning VProcTask, which co_await the transactions of a VProcCoro
+// executor for the node:
+//
+//   VProcTask seq (VProcCoro &vp, unsigned base)
+//   {
+//       co_await vp.write(base, 0x1234);
+//       unsigned data = co_await vp.read(base);
+//       co_await vp.tick(10);
+//   }
+//
+//   VProcCoro vp(node);
+//   vp.spawn(seq(vp, 0x1000));
+//   vp.spawn(seq(vp, 0x2000));
+//   vp.run();
+//
+// Awaiting a transaction suspends the coroutine, and the executor
+// issues the transactions of all the suspended coroutines in turn, on
+// the node, resuming each when its transaction completes. Awaiting a
+// tick suspends the coroutine until the node's clock has advanced by
+// that many cycles, while other coroutines' transactions are issued,
+// with the node ticking only when no transactions are waiting. A
+// coroutine may also co_await another VProcTask, to run it as a sub-
+// sequence. All of this runs on the node's user thread. Requires
+// -std=c++20.
+//
+//=====================================================================
+
+#ifndef _VPROCCORO_H_
+#define _VPROCCORO_H_
+
+#if __cplusplus < 202002L
+#error "VProcCoro.h requires C++20 (-std=c++20)"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+#include <vector>
+#include <deque>
+#include <queue>
+#include <cstdint>
+
+extern "C"
+{
+#include "VUser.h"
+}
+
+class VProcCoro;
+
+// -------------------------------------------------------------------------
+// Coroutine task type, for sequences and sub-sequences
+// -------------------------------------------------------------------------
+
+class VProcTask
+{
+public:
+    struct promise_type
+    {
+        std::coroutine_handle<> cont = nullptr;     // Awaiting coroutine, if a sub-sequence
+        VProcCoro*              exec = nullptr;     // Executor, if spawned
+        std::exception_ptr      exc  = nullptr;
+
+        VProcTask           get_return_object()   {return VProcTask(std::coroutine_handle<promise_type>::from_promise(*this));};
+        std::suspend_always initial_suspend()     noexcept {return {};};
+        void                return_void()         {};
+        void                unhandled_exception() {exc = std::current_exception();};
+
+        // On completion, continue any awaiting coroutine, else return to the executor
+        struct final_awaiter
+        {
+            bool                    await_ready()  noexcept {return false;};
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept;
+            void                    await_resume() noexcept {};
+        };
+
+        final_awaiter       final_suspend()       noexcept {return {};};
+    };
+
+         VProcTask  (VProcTask &&t) noexcept : hdl(std::exchange(t.hdl, nullptr)) {};
+         VProcTask  (const VProcTask&) = delete;
+        ~VProcTask  ()                         {if (hdl) hdl.destroy();};
+
+    // Await a task as a sub-sequence, starting it, and resuming when it completes
+    auto operator co_await() && noexcept
+    {
+        struct awaiter
+        {
+            std::coroutine_handle<promise_type> h;
+
+            bool                    await_ready()  noexcept {return h.done();};
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {h.promise().cont = caller; return h;};
+            void                    await_resume()          {if (h.promise().exc) std::rethrow_exception(h.promise().exc);};
+        };
+
+        return awaiter{hdl};
+    };
+
+private:
+    friend class VProcCoro;
+
+    explicit VProcTask (std::coroutine_handle<promise_type> h) : hdl(h) {};
+
+    std::coroutine_handle<promise_type> hdl;
+};
+
+// -------------------------------------------------------------------------
+// Per-node executor
+// -------------------------------------------------------------------------
+
+class VProcCoro
+{
+public:
+    // Transaction awaitable. Suspends the coroutine with the transaction queued
+    // for the executor, resuming with any read data when it's complete.
+    struct Txn
+    {
+        enum op_t {WRITE, READ, BURST_WRITE, BURST_READ};
+
+        VProcCoro*              vp;
+        op_t                    op;
+        unsigned                addr;
+        unsigned                data;
+        void*                   buf;
+        unsigned                len;
+        int                     delta;
+        std::coroutine_handle<> h = nullptr;
+
+        bool     await_ready()                           noexcept {return false;};
+        void     await_suspend(std::coroutine_handle<> c)         {h = c; vp->txns.push_back(this);};
+        unsigned await_resume()                          noexcept {return data;};
+    };
+
+    // Tick awaitable. Suspends the coroutine until the given number of cycles
+    // have passed (with zero, until the other ready coroutines have run).
+    struct Tick
+    {
+        VProcCoro*              vp;
+        unsigned                ticks;
+
+        bool     await_ready()                           noexcept {return false;};
+        void     await_suspend(std::coroutine_handle<> c)         {vp->wait(c, ticks);};
+        void     await_resume()                          noexcept {};
+    };
+
+         VProcCoro    (const unsigned nodeIn) : node(nodeIn) {};
+        ~VProcCoro    ()                                     {for (auto h : tasks) h.destroy();};
+
+    // Awaitable transactions
+    Txn  write        (const unsigned addr, const unsigned data, const int delta=0)    {return Txn{this, Txn::WRITE,       addr, data, nullptr, 0,   delta};};
+    Txn  read         (const unsigned addr,                      const int delta=0)    {return Txn{this, Txn::READ,        addr, 0,    nullptr, 0,   delta};};
+    Txn  burstWrite   (const unsigned addr, void *data, const unsigned wordlen)        {return Txn{this, Txn::BURST_WRITE, addr, 0,    data,    wordlen, 0};};
+    Txn  burstRead    (const unsigned addr, void *data, const unsigned wordlen)        {return Txn{this, Txn::BURST_READ,  addr, 0,    data,    wordlen, 0};};
+    Tick tick         (const unsigned ticks)                                           {return Tick{this, ticks};};
+
+    // Add a sequence to run, taking ownership of it
+    void spawn        (VProcTask &&t)                                                  {auto h = std::exchange(t.hdl, nullptr);
+                                                                                        h.promise().exec = this;
+                                                                                        tasks.push_back(h);
+                                                                                        ready.push_back(h);
+                                                                                        live++;};
+
+    // Current clock cycle of the node
+    uint64_t cycle    ()                                                               {return ns[node]->stats.s.cycle;};
+
+    // Number of spawned sequences not yet complete
+    unsigned running  ()                                                               {return live;};
+
+    // Run the spawned sequences until all are complete, rethrowing the first
+    // exception thrown by one of them
+    void run ()
+    {
+        while (live)
+        {
+            // Run each ready coroutine until it awaits or completes
+            while (!ready.empty())
+            {
+                std::coroutine_handle<> h = ready.front();
+                ready.pop_front();
+                h.resume();
+            }
+
+            if (exc)
+            {
+                std::rethrow_exception(std::exchange(exc, nullptr));
+            }
+
+            if (!txns.empty())
+            {
+                // Issue the next transaction, and resume its coroutine
+                Txn *t = txns.front();
+                txns.pop_front();
+
+                issue(t);
+                ready.push_back(t->h);
+            }
+            else if (!timers.empty())
+            {
+                // Nothing to issue, so tick to the next wake up
+                uint64_t now = cycle();
+
+                if (timers.top().wake > now)
+                {
+                    VTick((unsigned)(timers.top().wake - now), node);
+                }
+            }
+            else if (live && ready.empty())
+            {
+                VPrint("***Error: VProcCoro node %d has %d sequences awaiting nothing\n", node, live);
+                exit(1);
+            }
+
+            wakeTimers();
+        }
+    };
+
+private:
+    friend struct VProcTask::promise_type::final_awaiter;
+
+    struct Timer
+    {
+        uint64_t                wake;
+        uint64_t                seq;
+        std::coroutine_handle<> h = nullptr;
+
+        bool operator> (const Timer &t) const {return wake > t.wake || (wake == t.wake && seq > t.seq);};
+    };
+
+    void issue (Txn *t)
+    {
+        switch (t->op)
+        {
+        case Txn::WRITE:       VWrite      (t->addr, t->data,  t->delta, node); break;
+        case Txn::READ:        VRead       (t->addr, &t->data, t->delta, node); break;
+        case Txn::BURST_WRITE: VBurstWrite (t->addr, t->buf,   t->len,   node); break;
+        case Txn::BURST_READ:  VBurstRead  (t->addr, t->buf,   t->len,   node); break;
+        }
+    };
+
+    void wait (std::coroutine_handle<> h, const unsigned ticks)
+    {
+        if (ticks == 0)
+        {
+            ready.push_back(h);
+        }
+        else
+        {
+            timers.push(Timer{cycle() + ticks, timerSeq++, h});
+        }
+    };
+
+    // Make ready the coroutines whose ticks have passed
+    void wakeTimers ()
+    {
+        uint64_t now = cycle();
+
+        while (!timers.empty() && timers.top().wake <= now)
+        {
+            ready.push_back(timers.top().h);
+            timers.pop();
+        }
+    };
+
+    // Called when a spawned sequence completes
+    void done (std::exception_ptr e)
+    {
+        live--;
+
+        if (e && !exc)
+        {
+            exc = e;
+        }
+    };
+
+    unsigned                                                     node;
+    unsigned                                                     live     = 0;
+    uint64_t                                                     timerSeq = 0;
+    std::exception_ptr                                           exc      = nullptr;
+    std::vector<std::coroutine_handle<VProcTask::promise_type>>  tasks;
+    std::deque<std::coroutine_handle<>>                          ready;
+    std::deque<Txn*>                                             txns;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers;
+};
+
+inline std::coroutine_handle<> VProcTask::promise_type::final_awaiter::await_suspend(std::coroutine_handle<promise_type> h) noexcept
+{
+    promise_type &p = h.promise();
+
+    if (p.cont)
+    {
+        return p.cont;
+    }
+
+    if (p.exec)
+    {
+        p.exec->done(p.exc);
+    }
+
+    return std::noop_coroutine();
+}
+
+#endif
@@ -0,0 +1,431 @@
+//=====================================================================
+//
+// VProcVpi.c                                         Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Pure VPI transactor. Used with the port shell VProc module in
+// f_VProcVpi.v, which calls $vprocvpi(Node, BURST_ADDR_INCR) once at
+// start up. The module's ports are then driven and sampled here from a
+// value change callback on its clock, running the same state machine
+// as the main process of f_VProc.v, so that the simulator does no
+// behavioural HDL or task calls per clock cycle. Outputs are updated
+// in a read-write synch callback at the end of the time step, giving
+// the same timing as the non-blocking assignments of f_VProc.v.
+//
+// Each command is applied in full (there is no Update/UpdateResponse
+// delta cycle handshake, as for DISABLE_DELTA), and the module's ports
+// are found by name, with absent ports (e.g. BE or Burst when not
+// configured) ignored.
+//
+//=====================================================================
+
+#include "VProc.h"
+#include "VUser.h"
+#include "VSched_pli.h"
+
+#if !defined(VPROC_VHDL) && !defined(VPROC_SV)
+
+// Number of $vprocvpi arguments (plus one, as for VSched.c's argument arrays)
+#define VPVPI_ARGS_SIZE     3
+
+// Port handles
+typedef enum {
+    VPVPI_ADDR = 0,
+    VPVPI_BE,
+    VPVPI_WE,
+    VPVPI_RD,
+    VPVPI_DATAOUT,
+    VPVPI_BURST,
+    VPVPI_BURSTFIRST,
+    VPVPI_BURSTLAST,
+    VPVPI_RESET,
+    VPVPI_NUM_OUTPUTS
+} VProcVpiOut_t;
+
+static const char* vpiOutNames[VPVPI_NUM_OUTPUTS] = {
+    "Addr", "BE", "WE", "RD", "DataOut", "Burst", "BurstFirst", "BurstLast", "Reset"
+};
+
+// Per node transactor state
+typedef struct {
+    int                 node;
+    int                 addr_incr;
+
+    vpiHandle           clk;
+    vpiHandle           datain;
+    vpiHandle           wrack;
+    vpiHandle           rdack;
+    vpiHandle           interrupt;
+    vpiHandle           out[VPVPI_NUM_OUTPUTS];
+
+    vpiHandle           clk_cb;
+    vpiHandle           int_cb;
+
+    // Output values, as last driven (-1 for none) and as to be driven at the
+    // end of the time step
+    int                 out_val[VPVPI_NUM_OUTPUTS];
+    int                 out_next[VPVPI_NUM_OUTPUTS];
+    int                 update_pending;
+
+    // State, as for f_VProc.v
+    int                 tick_count;
+    int                 blk_count;
+    int                 acc_idx;
+    int                 lbe;
+    int                 int_samp_last;
+    int                 cycle;
+    int                 sleeping;
+} VProcVpiState_t;
+
+static PLI_INT32 VProcVpiClkCb (p_cb_data cb_data);
+
+// -------------------------------------------------------------------------
+// VProcVpiGet()
+//
+// Get an integer value of a port
+// -------------------------------------------------------------------------
+
+static int VProcVpiGet (const vpiHandle hdl)
+{
+    s_vpi_value value;
+
+    value.format        = vpiIntVal;
+    vpi_get_value(hdl, &value);
+
+    return value.value.integer;
+}
+
+// -------------------------------------------------------------------------
+// VProcVpiRegCb()
+//
+// Register a value change callback on a port
+// -------------------------------------------------------------------------
+
+static vpiHandle VProcVpiRegCb (const vpiHandle hdl, PLI_INT32 (*cb_rtn)(p_cb_data), VProcVpiState_t* vs)
+{
+    static s_vpi_time  time  = {vpiSuppressTime};
+    static s_vpi_value value = {vpiScalarVal};
+    s_cb_data          cb_data;
+
+    cb_data.reason      = cbValueChange;
+    cb_data.cb_rtn      = cb_rtn;
+    cb_data.obj         = hdl;
+    cb_data.time        = &time;
+    cb_data.value       = &value;
+    cb_data.index       = 0;
+    cb_data.user_data   = (PLI_BYTE8*)vs;
+
+    return vpi_register_cb(&cb_data);
+}
+
+// -------------------------------------------------------------------------
+// VProcVpiUpdateCb()
+//
+// Read-write synch callback, driving changed outputs at the end of
+// the time step
+// -------------------------------------------------------------------------
+
+static PLI_INT32 VProcVpiUpdateCb (p_cb_data cb_data)
+{
+    VProcVpiState_t* vs = (VProcVpiState_t*)cb_data->user_data;
+    s_vpi_value      value;
+
+    value.format        = vpiIntVal;
+
+    for (int idx = 0; idx < VPVPI_NUM_OUTPUTS; idx++)
+    {
+        if (vs->out_next[idx] != vs->out_val[idx] && vs->out[idx] != NULL)
+        {
+            value.value.integer = vs->out_next[idx];
+            vpi_put_value(vs->out[idx], &value, NULL, vpiNoDelay);
+        }
+
+        vs->out_val[idx] = vs->out_next[idx];
+    }
+
+    vs->update_pending  = 0;
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// VProcVpiIntCb()
+//
+// Interrupt value change callback while the node is sleeping. The
+// clock callback is restored to process the change at the next edge.
+// -------------------------------------------------------------------------
+
+static PLI_INT32 VProcVpiIntCb (p_cb_data cb_data)
+{
+    VProcVpiState_t* vs = (VProcVpiState_t*)cb_data->user_data;
+
+    vpi_remove_cb(vs->int_cb);
+
+    vs->int_cb          = NULL;
+    vs->clk_cb          = VProcVpiRegCb(vs->clk, VProcVpiClkCb, vs);
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// VProcVpiClkCb()
+//
+// Clock value change callback, running the node's state machine on
+// rising edges
+// -------------------------------------------------------------------------
+
+static PLI_INT32 VProcVpiClkCb (p_cb_data cb_data)
+{
+    VProcVpiState_t* vs   = (VProcVpiState_t*)cb_data->user_data;
+    int              node = vs->node;
+    int             *out  = vs->out_next;
+    int              rd   = out[VPVPI_RD];
+    int              we   = out[VPVPI_WE];
+    int              rdack, wrack, int_samp, datain;
+    int              dataout, addr, rw;
+    int              ticks = DELTA_CYCLE;
+
+    if (cb_data->value->value.scalar != vpi1)
+    {
+        return 0;
+    }
+
+    VTL_START(tl_clk);
+
+    if (VTimelineEnabled)
+    {
+        VTimelineSimEntry(tl_clk);
+    }
+
+    // Cleanly sample the inputs
+    rdack               = VProcVpiGet(vs->rdack);
+    wrack               = VProcVpiGet(vs->wrack);
+    int_samp            = VProcVpiGet(vs->interrupt);
+
+    // Count clock cycles (modulo 2^31) for passing to VSchedNode
+    vs->cycle           = (vs->cycle + 1) & 0x7fffffff;
+
+    // Call VIrqNode when interrupt value changes
+    if (int_samp != vs->int_samp_last)
+    {
+        VIrqNode(node, int_samp);
+        vs->int_samp_last = int_samp;
+    }
+
+    // If tick, write or a read has completed (or in last cycle)...
+    if ((!rd && !we && vs->tick_count == 0) || (rd && rdack) || (we && wrack))
+    {
+        out[VPVPI_BURSTFIRST] = 0;
+        out[VPVPI_BURSTLAST]  = 0;
+
+        // Loop accessing new commands until ticks is not a delta cycle update
+        while (ticks < 0)
+        {
+            datain      = VProcVpiGet(vs->datain);
+
+            if (vs->blk_count <= 1)
+            {
+                // If this is the last transfer in a burst, send the last data input sample
+                if (vs->blk_count == 1)
+                {
+                    vs->blk_count = 0;
+
+                    if (rd)
+                    {
+                        VAccessNode(node, ++vs->acc_idx, datain);
+                    }
+                }
+
+                // Get new access command
+                VSchedNode(node, datain, vs->cycle, &dataout, &addr, &rw, &ticks);
+
+                out[VPVPI_BURST]   = (rw >> 2)  & 0xfff;
+                out[VPVPI_WE]      =  rw        & 1;
+                out[VPVPI_RD]      = (rw >> 1)  & 1;
+                out[VPVPI_BE]      = (rw >> 14) & 0xf;
+                out[VPVPI_RESET]   = (rw >> 22) & 1;
+                out[VPVPI_ADDR]    = addr;
+                vs->lbe            = (rw >> 18) & 0xf;
+
+                rd                 = out[VPVPI_RD];
+                we                 = out[VPVPI_WE];
+
+                // If new burst count is non-zero, setup burst transfer
+                if (out[VPVPI_BURST] != 0)
+                {
+                    out[VPVPI_BURSTFIRST] = 1;
+                    vs->blk_count         = out[VPVPI_BURST];
+
+                    if (vs->blk_count == 1)
+                    {
+                        out[VPVPI_BURSTLAST] = 1;
+                    }
+
+                    // On writes, get the data from the burst buffer at index 0
+                    if (we)
+                    {
+                        vs->acc_idx = 0;
+                        dataout     = VAccessNode(node, 0, 0);
+                    }
+                    else
+                    {
+                        vs->acc_idx = -1;
+                    }
+                }
+
+                out[VPVPI_DATAOUT] = dataout;
+            }
+            // If a burst is in progress, get the next data out/send back latest sample
+            else
+            {
+                out[VPVPI_DATAOUT] = VAccessNode(node, ++vs->acc_idx, datain);
+                vs->blk_count--;
+
+                if (vs->blk_count == 1)
+                {
+                    out[VPVPI_BURSTLAST] = 1;
+                    out[VPVPI_BE]        = vs->lbe;
+                }
+                else
+                {
+                    out[VPVPI_BE]        = 0xf;
+                }
+
+                out[VPVPI_ADDR]   += vs->addr_incr;
+
+                // When bursting, reassert non-delta ticks value to break out of loop
+                ticks              = 0;
+            }
+
+            if (ticks > 0)
+            {
+                vs->tick_count     = ticks - 1;
+            }
+        }
+
+        vs->sleeping    = (ticks >= GO_TO_SLEEP);
+
+        if (!vs->update_pending)
+        {
+            static s_vpi_time time = {vpiSimTime, 0, 0};
+            s_cb_data         upd_cb;
+
+            upd_cb.reason    = cbReadWriteSynch;
+            upd_cb.cb_rtn    = VProcVpiUpdateCb;
+            upd_cb.obj       = NULL;
+            upd_cb.time      = &time;
+            upd_cb.value     = NULL;
+            upd_cb.index     = 0;
+            upd_cb.user_data = (PLI_BYTE8*)vs;
+
+            vpi_free_object(vpi_register_cb(&upd_cb));
+            vs->update_pending = 1;
+        }
+    }
+    else
+    {
+        // Count down to zero and stop
+        vs->tick_count  = (vs->tick_count > 0) ? vs->tick_count - 1 : 0;
+
+        // A sleeping node waits only for an interrupt change, without a clock callback
+        if (vs->sleeping && !rd && !we)
+        {
+            vpi_remove_cb(vs->clk_cb);
+
+            vs->clk_cb  = NULL;
+            vs->int_cb  = VProcVpiRegCb(vs->interrupt, VProcVpiIntCb, vs);
+        }
+    }
+
+    if (VTimelineEnabled)
+    {
+        VTimelineSpan(VTIMELINE_SIM_TID, "VProcVpi", node, tl_clk, VStatsNowNs());
+        VTimelineSimExit();
+    }
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// VProcVpiPort()
+//
+// Get a handle to a port of the calling module
+// -------------------------------------------------------------------------
+
+static vpiHandle VProcVpiPort (const char* name, const vpiHandle scope, const int node, const int required)
+{
+    vpiHandle hdl = vpi_handle_by_name((PLI_BYTE8*)name, scope);
+
+    if (hdl == NULL && required)
+    {
+        VPrint("***Error: VProcVpi() node %d failed to find port %s\n", node, name);
+        exit(VP_USER_ERR);
+    }
+
+    return hdl;
+}
+
+// -------------------------------------------------------------------------
+// VProcVpi()
+//
+// Called on the $vprocvpi(Node, BURST_ADDR_INCR) task from the initial
+// block of the port shell VProc module. Initialises the node, and
+// registers the clock callback.
+// -------------------------------------------------------------------------
+
+int VProcVpi (char* userdata)
+{
+    int              args[VPVPI_ARGS_SIZE];
+    vpiHandle        taskHdl = vpi_handle(vpiSysTfCall, NULL);
+    vpiHandle        scope   = vpi_handle(vpiScope, taskHdl);
+    VProcVpiState_t* vs      = (VProcVpiState_t*)calloc(1, sizeof(VProcVpiState_t));
+
+    getArgs(taskHdl, &args[1]);
+
+    vs->node            = args[VPNODENUM_ARG];
+    vs->addr_incr       = args[VPNODENUM_ARG+1];
+    vs->tick_count      = 1;
+    vs->out_next[VPVPI_BE] = 0xf;
+
+    for (int idx = 0; idx < VPVPI_NUM_OUTPUTS; idx++)
+    {
+        vs->out_val[idx] = -1;
+    }
+
+    VInitNode(vs->node);
+
+    vs->clk             = VProcVpiPort("Clk",       scope, vs->node, 1);
+    vs->datain          = VProcVpiPort("DataIn",    scope, vs->node, 1);
+    vs->wrack           = VProcVpiPort("WRAck",     scope, vs->node, 1);
+    vs->rdack           = VProcVpiPort("RDAck",     scope, vs->node, 1);
+    vs->interrupt       = VProcVpiPort("Interrupt", scope, vs->node, 1);
+
+    for (int idx = 0; idx < VPVPI_NUM_OUTPUTS; idx++)
+    {
+        vs->out[idx]    = VProcVpiPort(vpiOutNames[idx], scope, vs->node, idx <= VPVPI_DATAOUT && idx != VPVPI_BE);
+    }
+
+    vs->clk_cb          = VProcVpiRegCb(vs->clk, VProcVpiClkCb, vs);
+
+    return 0;
+}
+
+#endif
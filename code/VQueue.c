@@ -0,0 +1,441 @@
+//=====================================================================
+//
+// VQueue.c                                           Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Node transaction queues (see VQueue.h). Each client has its own list
+// of queued requests and completion condition. A single mutex protects
+// the clients of all nodes, with one condition on which serving nodes
+// wait for requests.
+//
+//=====================================================================
+
+#include "VProc.h"
+#include "VUser.h"
+#include "VQueue.h"
+
+// Queue client
+typedef struct {
+    int                 used;
+    int                 open;
+    unsigned            node;
+    unsigned            priority;
+    VQueueReq_t        *head;
+    VQueueReq_t        *tail;
+    unsigned            inflight;       // Requests taken by the server, and not yet complete
+    pthread_cond_t      done;           // Signalled when one of the client's requests completes
+} VQueueClient_t;
+
+static pthread_mutex_t  queueLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   queueWork = PTHREAD_COND_INITIALIZER;     // Signalled when a request is queued or a client closes
+static VQueueClient_t   queueClient[VP_MAX_QUEUE_CLIENTS];
+static unsigned         queueOpen[VP_MAX_NODES];                  // Open clients per node
+static int              queueLast[VP_MAX_NODES];                  // Last client served, for round robin
+static unsigned long long queueSeq = 0;
+
+// -------------------------------------------------------------------------
+// VQueueGetClient()
+//
+// Get an open client, checking its number
+// -------------------------------------------------------------------------
+
+static VQueueClient_t *VQueueGetClient (const int client)
+{
+    if (client < 0 || client >= VP_MAX_QUEUE_CLIENTS || !queueClient[client].open)
+    {
+        VPrint("***Error: VQueue client %d is not open\n", client);
+        exit(1);
+    }
+
+    return &queueClient[client];
+}
+
+// -------------------------------------------------------------------------
+// VQueueSelect()
+//
+// Choose the client with the next request to serve for a node, by the
+// policy, returning -1 if there is none. Called with the lock held.
+// -------------------------------------------------------------------------
+
+static int VQueueSelect (const int policy, const unsigned node)
+{
+    int best  = -1;
+    int start = ((policy & VQUEUE_ARB_MASK) == VQUEUE_ARB_RR) ? queueLast[node] + 1 : 0;
+
+    for (int n = 0; n < VP_MAX_QUEUE_CLIENTS; n++)
+    {
+        int             idx = (start + n) % VP_MAX_QUEUE_CLIENTS;
+        VQueueClient_t *c   = &queueClient[idx];
+
+        if (!c->used || c->node != node)
+        {
+            continue;
+        }
+
+        if (c->head == NULL)
+        {
+            // In sync mode, wait for all open clients to have a request
+            if ((policy & VQUEUE_SYNC) && c->open)
+            {
+                return -1;
+            }
+
+            continue;
+        }
+
+        if (best < 0)
+        {
+            best = idx;
+        }
+        else
+        {
+            VQueueClient_t *b = &queueClient[best];
+
+            switch (policy & VQUEUE_ARB_MASK)
+            {
+            case VQUEUE_ARB_PRIORITY:
+                if (c->priority < b->priority || (c->priority == b->priority && c->head->seq < b->head->seq))
+                {
+                    best = idx;
+                }
+                break;
+
+            case VQUEUE_ARB_FIFO:
+                if (c->head->seq < b->head->seq)
+                {
+                    best = idx;
+                }
+                break;
+
+            default:
+                // Round robin takes the first found after the last served
+                break;
+            }
+        }
+    }
+
+    return best;
+}
+
+// -------------------------------------------------------------------------
+// VQueueExec()
+//
+// Issue a request's transaction on the node
+// -------------------------------------------------------------------------
+
+static void VQueueExec (VQueueReq_t *req, const unsigned node)
+{
+    switch (req->op)
+    {
+    case VQUEUE_OP_WRITE:
+        req->status = VWrite(req->addr, req->data, req->delta, node);
+        break;
+
+    case VQUEUE_OP_READ:
+        req->status = VRead(req->addr, &req->data, req->delta, node);
+        break;
+
+    case VQUEUE_OP_BURST_WRITE:
+        req->status = VBurstWrite(req->addr, req->buf, req->len, node);
+        break;
+
+    case VQUEUE_OP_BURST_READ:
+        req->status = VBurstRead(req->addr, req->buf, req->len, node);
+        break;
+
+    case VQUEUE_OP_TICK:
+        req->status = VTick(req->data, node);
+        break;
+
+    default:
+        VPrint("***Error: VQueue client %d submitted bad operation %d\n", req->client, req->op);
+        exit(1);
+    }
+}
+
+// -------------------------------------------------------------------------
+// VQueueDo()
+//
+// Submit a request and wait for it to complete
+// -------------------------------------------------------------------------
+
+static int VQueueDo (const int client, VQueueReq_t *req)
+{
+    VQueueSubmit(client, req);
+
+    return VQueueWait(req);
+}
+
+// =========================================================================
+// User API
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VQueueOpen()
+//
+// Open a client of a node's queue
+// -------------------------------------------------------------------------
+
+int VQueueOpen (const unsigned priority, const unsigned node)
+{
+    int client = -1;
+
+    pthread_mutex_lock(&queueLock);
+
+    for (int idx = 0; idx < VP_MAX_QUEUE_CLIENTS; idx++)
+    {
+        VQueueClient_t *c = &queueClient[idx];
+
+        if (!c->used)
+        {
+            c->used     = 1;
+            c->open     = 1;
+            c->node     = node;
+            c->priority = priority;
+            c->head     = NULL;
+            c->tail     = NULL;
+            c->inflight = 0;
+            pthread_cond_init(&c->done, NULL);
+
+            queueOpen[node]++;
+            client = idx;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&queueLock);
+
+    if (client < 0)
+    {
+        VPrint("***Error: VQueueOpen no free clients for node %d (VP_MAX_QUEUE_CLIENTS is %d)\n", node, VP_MAX_QUEUE_CLIENTS);
+    }
+
+    return client;
+}
+
+// -------------------------------------------------------------------------
+// VQueueClose()
+//
+// Close a client, waiting for its requests to complete
+// -------------------------------------------------------------------------
+
+void VQueueClose (const int client)
+{
+    VQueueClient_t *c = VQueueGetClient(client);
+
+    pthread_mutex_lock(&queueLock);
+
+    c->open = 0;
+    queueOpen[c->node]--;
+
+    // Wake the server, which may be waiting for this client in sync mode,
+    // or for the last client to close
+    pthread_cond_broadcast(&queueWork);
+
+    while (c->head != NULL || c->inflight)
+    {
+        pthread_cond_wait(&c->done, &queueLock);
+    }
+
+    pthread_cond_destroy(&c->done);
+    c->used = 0;
+
+    pthread_mutex_unlock(&queueLock);
+}
+
+// -------------------------------------------------------------------------
+// VQueueSubmit()
+//
+// Queue a request, without waiting for it to complete
+// -------------------------------------------------------------------------
+
+void VQueueSubmit (const int client, VQueueReq_t *req)
+{
+    VQueueClient_t *c = VQueueGetClient(client);
+
+    req->next   = NULL;
+    req->client = client;
+    req->done   = 0;
+
+    pthread_mutex_lock(&queueLock);
+
+    req->seq = queueSeq++;
+
+    if (c->tail == NULL)
+    {
+        c->head = req;
+    }
+    else
+    {
+        c->tail->next = req;
+    }
+
+    c->tail = req;
+
+    pthread_cond_broadcast(&queueWork);
+    pthread_mutex_unlock(&queueLock);
+}
+
+// -------------------------------------------------------------------------
+// VQueueWait()
+//
+// Wait for a submitted request to complete
+// -------------------------------------------------------------------------
+
+int VQueueWait (VQueueReq_t *req)
+{
+    VQueueClient_t *c = &queueClient[req->client];
+
+    pthread_mutex_lock(&queueLock);
+
+    while (!req->done)
+    {
+        pthread_cond_wait(&c->done, &queueLock);
+    }
+
+    pthread_mutex_unlock(&queueLock);
+
+    return req->status;
+}
+
+// -------------------------------------------------------------------------
+// VQueueWrite()
+//
+// Write a word, waiting for completion
+// -------------------------------------------------------------------------
+
+int VQueueWrite (const int client, const unsigned addr, const unsigned data, const int delta)
+{
+    VQueueReq_t req = {VQUEUE_OP_WRITE, addr, data, delta};
+
+    return VQueueDo(client, &req);
+}
+
+// -------------------------------------------------------------------------
+// VQueueRead()
+//
+// Read a word, waiting for completion
+// -------------------------------------------------------------------------
+
+int VQueueRead (const int client, const unsigned addr, unsigned *data, const int delta)
+{
+    VQueueReq_t req = {VQUEUE_OP_READ, addr, 0, delta};
+    int         status;
+
+    status = VQueueDo(client, &req);
+    *data  = req.data;
+
+    return status;
+}
+
+// -------------------------------------------------------------------------
+// VQueueBurstWrite()
+//
+// Write a burst of words, waiting for completion
+// -------------------------------------------------------------------------
+
+int VQueueBurstWrite (const int client, const unsigned addr, void *data, const unsigned wordlen)
+{
+    VQueueReq_t req = {VQUEUE_OP_BURST_WRITE, addr, 0, 0, data, wordlen};
+
+    return VQueueDo(client, &req);
+}
+
+// -------------------------------------------------------------------------
+// VQueueBurstRead()
+//
+// Read a burst of words, waiting for completion
+// -------------------------------------------------------------------------
+
+int VQueueBurstRead (const int client, const unsigned addr, void *data, const unsigned wordlen)
+{
+    VQueueReq_t req = {VQUEUE_OP_BURST_READ, addr, 0, 0, data, wordlen};
+
+    return VQueueDo(client, &req);
+}
+
+// -------------------------------------------------------------------------
+// VQueueTick()
+//
+// Tick the node for a number of cycles, waiting for completion
+// -------------------------------------------------------------------------
+
+int VQueueTick (const int client, const unsigned ticks)
+{
+    VQueueReq_t req = {VQUEUE_OP_TICK, 0, ticks};
+
+    return VQueueDo(client, &req);
+}
+
+// -------------------------------------------------------------------------
+// VQueueServe()
+//
+// Serve a node's queue until all its clients have closed
+// -------------------------------------------------------------------------
+
+unsigned long long VQueueServe (const int policy, const unsigned node)
+{
+    unsigned long long served = 0;
+    int                client;
+
+    pthread_mutex_lock(&queueLock);
+
+    for (;;)
+    {
+        VQueueReq_t    *req;
+        VQueueClient_t *c;
+
+        while ((client = VQueueSelect(policy, node)) < 0)
+        {
+            if (queueOpen[node] == 0)
+            {
+                pthread_mutex_unlock(&queueLock);
+                return served;
+            }
+
+            pthread_cond_wait(&queueWork, &queueLock);
+        }
+
+        c       = &queueClient[client];
+        req     = c->head;
+        c->head = req->next;
+
+        if (c->head == NULL)
+        {
+            c->tail = NULL;
+        }
+
+        c->inflight++;
+        queueLast[node] = client;
+
+        pthread_mutex_unlock(&queueLock);
+
+        VQueueExec(req, node);
+
+        pthread_mutex_lock(&queueLock);
+
+        req->done = 1;
+        c->inflight--;
+        served++;
+
+        pthread_cond_broadcast(&c->done);
+    }
+}
@@ -0,0 +1,117 @@
+//=====================================================================
+//
+// VQueue.h                                           Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Sharing of a node by several software threads. The VProc API calls
+// for a node may only be made from the node's own user thread, so
+// other threads open a client of the node's transaction queue, and
+// submit transactions to it. The node's user thread serves the queue
+// with VQueueServe(), choosing the next transaction by one of these
+// arbitration policies:
+//
+//   VQUEUE_ARB_FIFO     : in order of submission
+//   VQUEUE_ARB_RR       : round robin between clients
+//   VQUEUE_ARB_PRIORITY : client with the lowest priority value first,
+//                         in order of submission for equal priorities
+//
+// With VQUEUE_SYNC or'ed into the policy, a transaction is chosen only
+// when every open client has one queued, so that the order doesn't
+// depend on host thread scheduling. A client then idles with
+// VQueueTick(), and must close when it has finished.
+//
+// Each client has its own completion notification, and may wait for
+// each transaction (the blocking calls) or submit several and wait
+// for them later. While no transaction is available, the node's user
+// thread waits, and simulation time does not advance.
+//
+//=====================================================================
+
+#ifndef _VQUEUE_H_
+#define _VQUEUE_H_
+
+// Number of clients, across all nodes
+#ifndef VP_MAX_QUEUE_CLIENTS
+#define VP_MAX_QUEUE_CLIENTS    64
+#endif
+
+// Arbitration policies
+#define VQUEUE_ARB_FIFO         0
+#define VQUEUE_ARB_RR           1
+#define VQUEUE_ARB_PRIORITY     2
+#define VQUEUE_ARB_MASK         0xff
+
+#define VQUEUE_SYNC             0x100
+
+// Transaction operations
+#define VQUEUE_OP_WRITE         0
+#define VQUEUE_OP_READ          1
+#define VQUEUE_OP_BURST_WRITE   2
+#define VQUEUE_OP_BURST_READ    3
+#define VQUEUE_OP_TICK          4
+
+// Transaction request. The user sets op, addr, data, and, for bursts,
+// buf and len (for ticks, data is the number of ticks), and gets the
+// read data in data and the status in status when done. The request
+// must remain valid until complete.
+typedef struct VQueueReq {
+    int                 op;
+    unsigned            addr;
+    unsigned            data;
+    int                 delta;
+    void               *buf;
+    unsigned            len;
+    int                 status;
+
+    // Internal
+    struct VQueueReq   *next;
+    unsigned long long  seq;
+    int                 client;
+    int                 done;
+} VQueueReq_t;
+
+// Open a client of a node's queue, with a priority for
+// VQUEUE_ARB_PRIORITY (lowest first), returning the client number, or
+// -1 if there are no free clients. Clients must be opened before the
+// node serves the queue.
+extern int  VQueueOpen        (const unsigned priority, const unsigned node);
+
+// Close a client, once its submitted transactions are complete
+extern void VQueueClose       (const int client);
+
+// Submit a transaction, without waiting for it to complete
+extern void VQueueSubmit      (const int client, VQueueReq_t *req);
+
+// Wait for a submitted transaction to complete, returning its status
+extern int  VQueueWait        (VQueueReq_t *req);
+
+// Blocking transactions
+extern int  VQueueWrite       (const int client, const unsigned addr, const unsigned data, const int delta);
+extern int  VQueueRead        (const int client, const unsigned addr, unsigned *data, const int delta);
+extern int  VQueueBurstWrite  (const int client, const unsigned addr, void *data, const unsigned wordlen);
+extern int  VQueueBurstRead   (const int client, const unsigned addr, void *data, const unsigned wordlen);
+extern int  VQueueTick        (const int client, const unsigned ticks);
+
+// Serve the node's queue, from the node's user thread, until all its
+// clients have closed, returning the number of transactions served
+extern unsigned long long VQueueServe (const int policy, const unsigned node);
+
+#endif
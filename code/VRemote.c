@@ -0,0 +1,542 @@
+//=====================================================================
+//
+// VRemote.c                                          Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Out-of-process user code transport. The simulation side functions
+// replace the semaphore exchange in VSched() for remote nodes, and
+// forward VIrq() and VProcUser() calls as events. The user process
+// side functions replace the exchange in VExch(), and attach to the
+// simulation's segments and start the user threads (see
+// remote/VRemoteMain.c). Both sides are linked from this file.
+//
+//=====================================================================
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <fcntl.h>
+#include <signal.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#include "VProc.h"
+#include "VUser.h"
+#include "VRestart.h"
+
+// Seconds between checks that the other process is still alive
+#define VREMOTE_POLL_SECS       1
+
+// Time between attempts to attach to a simulation segment
+#define VREMOTE_ATTACH_NS       100000000
+
+#ifdef __linux__
+
+static int      remoteInitialised = 0;
+static char    *remotePrefix      = NULL;
+static uint64_t remoteMask        = ~0ULL;
+static int      remoteWaitMsg[VP_MAX_NODES];
+
+// -------------------------------------------------------------------------
+// VRemoteName()
+//
+// Construct a node's segment name from the prefix
+// -------------------------------------------------------------------------
+
+static void VRemoteName (char *name, const size_t size, const char *prefix, const unsigned node)
+{
+    snprintf(name, size, "%s%s.%d", prefix[0] == '/' ? "" : "/", prefix, node);
+}
+
+// -------------------------------------------------------------------------
+// VRemotePost()
+//
+// Increment a sequence number and wake the other side if it is
+// sleeping on it
+// -------------------------------------------------------------------------
+
+static void VRemotePost (uint32_t *seq, uint32_t *waiting)
+{
+    __atomic_add_fetch(seq, 1, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(waiting, __ATOMIC_SEQ_CST))
+    {
+        syscall(SYS_futex, seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+// -------------------------------------------------------------------------
+// VRemoteWaitChange()
+//
+// Wait for a sequence number to change from the given value, polling
+// for a while before sleeping on the futex. Returns 1 when changed,
+// or 0 on a poll period timeout or if the simulation has closed.
+// -------------------------------------------------------------------------
+
+static int VRemoteWaitChange (VRemoteSeg_t *seg, uint32_t *seq, uint32_t *waiting, const uint32_t old)
+{
+    struct timespec to = {VREMOTE_POLL_SECS, 0};
+
+    for (int idx = 0; idx < VP_REMOTE_SPIN; idx++)
+    {
+        if (__atomic_load_n(seq, __ATOMIC_ACQUIRE) != old)
+        {
+            return 1;
+        }
+    }
+
+    __atomic_store_n(waiting, 1, __ATOMIC_SEQ_CST);
+
+    while (__atomic_load_n(seq, __ATOMIC_SEQ_CST) == old)
+    {
+        if (__atomic_load_n(&seg->closed, __ATOMIC_ACQUIRE) ||
+            (syscall(SYS_futex, seq, FUTEX_WAIT, old, &to, NULL, 0) == -1 && errno == ETIMEDOUT))
+        {
+            __atomic_store_n(waiting, 0, __ATOMIC_RELAXED);
+            return 0;
+        }
+    }
+
+    __atomic_store_n(waiting, 0, __ATOMIC_RELAXED);
+
+    return 1;
+}
+
+// -------------------------------------------------------------------------
+// VRemoteSimWait()
+//
+// Simulation side wait for the user process to post, reporting
+// when no user process is attached.
+// -------------------------------------------------------------------------
+
+static void VRemoteSimWait (const unsigned node, const uint32_t old)
+{
+    VRemoteSeg_t *seg = ns[node]->remote;
+
+    while (!VRemoteWaitChange(seg, &seg->usr_seq, &seg->sim_waiting, old))
+    {
+        int pid = __atomic_load_n(&seg->usr_pid, __ATOMIC_ACQUIRE);
+
+        if (pid != 0 && kill(pid, 0) == -1 && errno == ESRCH)
+        {
+            VPrint("VSched(): remote user process %d for node %d has exited\n", pid, node);
+            __atomic_store_n(&seg->usr_pid, 0, __ATOMIC_RELEASE);
+            pid = 0;
+            remoteWaitMsg[node] = 0;
+        }
+
+        if (pid == 0 && !remoteWaitMsg[node])
+        {
+            VPrint("VSched(): node %d waiting for remote user process on %s.%d\n", node, remotePrefix, node);
+            remoteWaitMsg[node] = 1;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+// VRemoteSimPost()
+//
+// Simulation side hand over to the user process, and wait for it
+// to hand back
+// -------------------------------------------------------------------------
+
+static void VRemoteSimPost (const unsigned node)
+{
+    VRemoteSeg_t *seg = ns[node]->remote;
+    uint32_t      old = seg->usr_seq;
+
+    VRemotePost(&seg->sim_seq, &seg->usr_waiting);
+    VRemoteSimWait(node, old);
+}
+
+// -------------------------------------------------------------------------
+// VRemoteAtExit()
+//
+// Flag to attached user processes that the simulation has ended
+// and remove the segment names
+// -------------------------------------------------------------------------
+
+static void VRemoteAtExit (void)
+{
+    char name[DEFAULT_STR_BUF_SIZE*4];
+
+    for (int node = 0; node < VP_MAX_NODES; node++)
+    {
+        VRemoteSeg_t *seg;
+
+        if (ns[node] != NULL && (seg = ns[node]->remote) != NULL)
+        {
+            __atomic_store_n(&seg->closed, 1, __ATOMIC_RELEASE);
+            syscall(SYS_futex, &seg->sim_seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+
+            VRemoteName(name, sizeof(name), remotePrefix, node);
+            shm_unlink(name);
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+// VRemoteClientWait()
+//
+// User process side wait for a response from the simulation,
+// handling any events sent while waiting. Exits if the simulation
+// has ended.
+// -------------------------------------------------------------------------
+
+static void VRemoteClientWait (const unsigned node)
+{
+    VRemoteSeg_t *seg = ns[node]->remote;
+
+    while (1)
+    {
+        uint32_t old = seg->usr_seq;
+
+        if (!VRemoteWaitChange(seg, &seg->sim_seq, &seg->usr_waiting, old))
+        {
+            if (seg->closed || kill(seg->sim_pid, 0) == -1)
+            {
+                VPrint("VRemote: simulation has ended, exiting\n");
+                exit(0);
+            }
+            continue;
+        }
+
+        switch (seg->ev_type)
+        {
+        case VREMOTE_EV_NONE:
+            return;
+
+        case VREMOTE_EV_IRQ:
+            if (ns[node]->VUserIrqCB != NULL)
+            {
+                (*(ns[node]->VUserIrqCB))(seg->ev_value);
+            }
+            break;
+
+        case VREMOTE_EV_USER:
+            if (ns[node]->VUserCB != NULL)
+            {
+                (*(ns[node]->VUserCB))(seg->ev_value);
+            }
+            break;
+        }
+
+        // Acknowledge the event and carry on waiting
+        seg->ev_type = VREMOTE_EV_NONE;
+        VRemotePost(&seg->usr_seq, &seg->sim_waiting);
+    }
+}
+
+// -------------------------------------------------------------------------
+// VRemoteUserThread()
+//
+// User process thread for a node. Waits for the first message from
+// the simulation and calls the node's user code.
+// -------------------------------------------------------------------------
+
+static void *VRemoteUserThread (void *arg)
+{
+    unsigned     node = (unsigned)((nodecast_t)arg);
+    char         funcname[DEFAULT_STR_BUF_SIZE];
+    pVUserMain_t VUserMain_func;
+
+    sprintf(funcname, "%s%d", "VUserMain", node);
+
+    if ((VUserMain_func = (pVUserMain_t) dlsym(RTLD_DEFAULT, funcname)) == NULL && !VRestartListed(node))
+    {
+        VPrint("***Error: failed to find user code symbol %s (VRemoteUserThread)\n", funcname);
+        exit(1);
+    }
+
+    VRemoteClientWait(node);
+
+    VRestartRun(node, VUserMain_func);
+
+    return NULL;
+}
+
+#endif
+
+// =========================================================================
+// Simulation side internal functions
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VRemoteInit()
+//
+// Called from VInit() for each node. If remote user code is
+// configured for the node, creates its segment and returns 1, so
+// that no local user thread is started. Otherwise returns 0.
+// -------------------------------------------------------------------------
+
+int VRemoteInit (const unsigned node)
+{
+#ifdef __linux__
+    char          name[DEFAULT_STR_BUF_SIZE*4];
+    VRemoteSeg_t *seg;
+    int           fd;
+
+    if (!remoteInitialised)
+    {
+        char *mask = getenv(VREMOTE_NODES_ENV);
+
+        remoteInitialised = 1;
+        remotePrefix      = getenv(VREMOTE_ENV);
+
+        if (remotePrefix != NULL && remotePrefix[0] != '\0')
+        {
+            if (mask != NULL && mask[0] != '\0')
+            {
+                remoteMask = strtoull(mask, NULL, 16);
+            }
+
+            atexit(VRemoteAtExit);
+        }
+        else
+        {
+            remotePrefix = NULL;
+        }
+    }
+
+    if (remotePrefix == NULL || node >= 64 || !((remoteMask >> node) & 1))
+    {
+        return 0;
+    }
+
+    VRemoteName(name, sizeof(name), remotePrefix, node);
+
+    // Remove any segment left by a previous run
+    shm_unlink(name);
+
+    if ((fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600)) == -1)
+    {
+        VPrint("***Error: VRemoteInit() failed to create shared memory %s\n", name);
+        exit(1);
+    }
+
+    if (ftruncate(fd, sizeof(VRemoteSeg_t)) == -1 ||
+        (seg = (VRemoteSeg_t *) mmap(NULL, sizeof(VRemoteSeg_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED)
+    {
+        VPrint("***Error: VRemoteInit() failed to map shared memory %s\n", name);
+        exit(1);
+    }
+
+    close(fd);
+
+    memset(seg, 0, sizeof(VRemoteSeg_t));
+    memcpy(seg->magic, VREMOTE_MAGIC, strlen(VREMOTE_MAGIC));
+    seg->version = VREMOTE_VERSION;
+    seg->node    = node;
+    seg->sim_pid = getpid();
+
+    ns[node]->remote = seg;
+
+    VPrint("VInit(%d): user code is remote, on %s\n", node, name);
+
+    return 1;
+#else
+    if (getenv(VREMOTE_ENV) != NULL)
+    {
+        VPrint("***Error: VRemoteInit() remote user code not supported on this platform\n");
+    }
+
+    return 0;
+#endif
+}
+
+// -------------------------------------------------------------------------
+// VRemoteSchedExch()
+//
+// Called from VSched() for remote nodes in place of the semaphore
+// exchange. Sends the input data to the user process, and waits for
+// the next command, which is copied to the node's send buffer with
+// the burst data pointing at the shared segment.
+// -------------------------------------------------------------------------
+
+void VRemoteSchedExch (const unsigned node)
+{
+#ifdef __linux__
+    VRemoteSeg_t *seg  = ns[node]->remote;
+    psend_buf_t   sbuf = &ns[node]->send_buf;
+
+    seg->data_in = ns[node]->rcv_buf.data_in;
+    seg->cycle   = ns[node]->stats.s.cycle;
+    seg->ev_type = VREMOTE_EV_NONE;
+
+    VRemoteSimPost(node);
+
+    sbuf->addr     = seg->addr;
+    sbuf->data_out = seg->data_out;
+    sbuf->rw       = seg->rw;
+    sbuf->ticks    = seg->ticks;
+    sbuf->data_p   = seg->burst;
+#endif
+}
+
+// -------------------------------------------------------------------------
+// VRemoteEvent()
+//
+// Called from VIrq() and VProcUser() for remote nodes, to run the
+// user process's callback. Returns when the callback has completed.
+// -------------------------------------------------------------------------
+
+void VRemoteEvent (const unsigned node, const uint32_t type, const int value)
+{
+#ifdef __linux__
+    VRemoteSeg_t *seg = ns[node]->remote;
+
+    seg->ev_type  = type;
+    seg->ev_value = value;
+
+    VRemoteSimPost(node);
+#endif
+}
+
+// =========================================================================
+// User process side functions
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VRemoteConnect()
+//
+// Attach to a node's segment, waiting for the simulation to create
+// it, and start a thread to run the node's user code. Returns 0 on
+// success.
+// -------------------------------------------------------------------------
+
+int VRemoteConnect (const unsigned node, const char *prefix)
+{
+#ifdef __linux__
+    char            name[DEFAULT_STR_BUF_SIZE*4];
+    struct timespec ts = {0, VREMOTE_ATTACH_NS};
+    VRemoteSeg_t   *seg;
+    pthread_t       thread;
+    int             fd, pid;
+
+    VRemoteName(name, sizeof(name), prefix, node);
+
+    VPrint("VRemote: node %d attaching to %s\n", node, name);
+
+    while ((fd = shm_open(name, O_RDWR, 0)) == -1)
+    {
+        nanosleep(&ts, NULL);
+    }
+
+    if ((seg = (VRemoteSeg_t *) mmap(NULL, sizeof(VRemoteSeg_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED)
+    {
+        VPrint("***Error: VRemoteConnect() failed to map shared memory %s\n", name);
+        return 1;
+    }
+
+    close(fd);
+
+    if (memcmp(seg->magic, VREMOTE_MAGIC, strlen(VREMOTE_MAGIC)) || seg->version != VREMOTE_VERSION)
+    {
+        VPrint("***Error: VRemoteConnect() %s is not a compatible VProc segment\n", name);
+        return 1;
+    }
+
+    if ((pid = seg->usr_pid) != 0 && kill(pid, 0) == 0)
+    {
+        VPrint("***Error: VRemoteConnect() node %d already has user process %d attached\n", node, pid);
+        return 1;
+    }
+
+    __atomic_store_n(&seg->usr_pid, getpid(), __ATOMIC_RELEASE);
+
+    ns[node]->remote = seg;
+
+    if (pthread_create(&thread, NULL, VRemoteUserThread, (void *)((nodecast_t)node)))
+    {
+        VPrint("***Error: VRemoteConnect() failed to create user thread for node %d\n", node);
+        return 1;
+    }
+
+    return 0;
+#else
+    VPrint("***Error: VRemoteConnect() remote user code not supported on this platform\n");
+    return 1;
+#endif
+}
+
+// -------------------------------------------------------------------------
+// VRemoteClientExch()
+//
+// Called from VExch() in the user process in place of the semaphore
+// exchange. Burst data is copied to and from the segment, unless the
+// user buffer is the segment's own burst buffer.
+// -------------------------------------------------------------------------
+
+void VRemoteClientExch (const unsigned node)
+{
+#ifdef __linux__
+    VRemoteSeg_t *seg  = ns[node]->remote;
+    psend_buf_t   sbuf = &ns[node]->send_buf;
+    rw_t         *p_rw = (rw_t *)&sbuf->rw;
+    int           copy = p_rw->burstlen && sbuf->data_p != seg->burst;
+
+    seg->addr     = sbuf->addr;
+    seg->data_out = sbuf->data_out;
+    seg->rw       = sbuf->rw;
+    seg->ticks    = sbuf->ticks;
+
+    if (copy && p_rw->write)
+    {
+        memcpy(seg->burst, sbuf->data_p, p_rw->burstlen * sizeof(uint32_t));
+    }
+
+    VRemotePost(&seg->usr_seq, &seg->sim_waiting);
+
+    VRemoteClientWait(node);
+
+    ns[node]->rcv_buf.data_in = seg->data_in;
+    ns[node]->stats.s.cycle   = seg->cycle;
+
+    if (copy && p_rw->read)
+    {
+        memcpy(sbuf->data_p, seg->burst, p_rw->burstlen * sizeof(uint32_t));
+    }
+#endif
+}
+
+// =========================================================================
+// User API functions
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VRemoteBurstBuf()
+//
+// Returns the node's burst buffer in the shared segment, or NULL if
+// the node is not remote
+// -------------------------------------------------------------------------
+
+void *VRemoteBurstBuf (const unsigned node)
+{
+    if (node >= VP_MAX_NODES || ns[node] == NULL || ns[node]->remote == NULL)
+    {
+        return NULL;
+    }
+
+    return ns[node]->remote->burst;
+}
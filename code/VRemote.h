@@ -0,0 +1,110 @@
+//=====================================================================
+//
+// VRemote.h                                          Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Out-of-process user code. For each remote node the simulation
+// creates a shared memory segment holding the send_buf_t/rcv_buf_t
+// exchange fields, an event slot for interrupts and $vprocuser calls,
+// and a burst data page. The two sides hand over control by
+// incrementing a sequence number and waking the other with a futex
+// (Linux only). The simulation increments sim_seq when a response or
+// event is ready, and the user process increments usr_seq when a new
+// command is ready or an event has been handled, so the user process
+// owns the exchange fields whenever sim_seq != usr_seq.
+//
+//=====================================================================
+
+#ifndef _VREMOTE_H_
+#define _VREMOTE_H_
+
+#include <stdint.h>
+
+// Environment variable enabling remote user code. Its value is the
+// segment name prefix (e.g. "/myproj"), with each node's segment
+// named "<prefix>.<node>". A hex mask of the remote nodes can be
+// given in VPROC_REMOTE_NODES (default all nodes).
+#define VREMOTE_ENV             "VPROC_REMOTE"
+#define VREMOTE_NODES_ENV       "VPROC_REMOTE_NODES"
+
+#define VREMOTE_MAGIC           "VPREMOT"
+#define VREMOTE_VERSION         1
+
+// Size of burst data page, in words
+#define VREMOTE_BURST_WORDS     4096
+
+// Polls of a sequence number before sleeping on the futex
+#ifndef VP_REMOTE_SPIN
+#define VP_REMOTE_SPIN          2000
+#endif
+
+// Event types
+#define VREMOTE_EV_NONE         0
+#define VREMOTE_EV_IRQ          1       // VIrq() called, with value
+#define VREMOTE_EV_USER         2       // VProcUser() called, with value
+
+// Shared segment layout, one per node
+typedef struct {
+    char                magic[8];
+    uint32_t            version;
+    uint32_t            node;
+    int32_t             sim_pid;
+    int32_t             usr_pid;        // Attached user process (0 if none)
+    uint32_t            closed;         // Set when the simulation exits
+
+    // Futex words, each on their own cache line
+    uint32_t            sim_seq     __attribute__((aligned(64)));
+    uint32_t            sim_waiting;
+    uint32_t            usr_seq     __attribute__((aligned(64)));
+    uint32_t            usr_waiting;
+
+    // Exchange fields
+    uint32_t            addr        __attribute__((aligned(64)));
+    uint32_t            data_out;
+    uint32_t            rw;
+    int32_t             ticks;
+    uint32_t            data_in;
+    uint32_t            ev_type;        // VREMOTE_EV_xxx, valid with sim_seq
+    int32_t             ev_value;
+    uint64_t            cycle;          // Simulation cycle of response
+
+    // Burst data, used directly by VAccess()
+    uint32_t            burst[VREMOTE_BURST_WORDS] __attribute__((aligned(4096)));
+} VRemoteSeg_t;
+
+#ifndef VREMOTE_NO_PROTOTYPES
+
+// Internal functions called from VSched.c
+extern int   VRemoteInit       (const unsigned node);
+extern void  VRemoteSchedExch  (const unsigned node);
+extern void  VRemoteEvent      (const unsigned node, const uint32_t type, const int value);
+
+// User process functions
+extern int   VRemoteConnect    (const unsigned node, const char *prefix);
+extern void  VRemoteClientExch (const unsigned node);
+
+// User API: burst buffer in the shared segment. Bursts to or from this
+// buffer are not copied.
+extern void* VRemoteBurstBuf   (const unsigned node);
+
+#endif
+
+#endif
@@ -0,0 +1,352 @@
+//=====================================================================
+//
+// VReplay.c                                          Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Record and replay of node command streams (see VReplay.h). All
+// functions are called on the simulation thread.
+//
+//=====================================================================
+
+#include <string.h>
+#include "VProc.h"
+#include "VUser.h"
+
+static int      replayInitialised = 0;
+static int      replayMode        = 0;
+static char    *replayName        = NULL;
+static uint64_t replayMask        = ~0ULL;
+
+// -------------------------------------------------------------------------
+// VReplayWrite()
+//
+// Write a completed command record, and any burst data, to file
+// -------------------------------------------------------------------------
+
+static void VReplayWrite (VReplayState_t *rp)
+{
+    rw_t *p_rw = (rw_t *)&rp->pending.rw;
+
+    fwrite(&rp->pending, sizeof(VReplayRec_t), 1, rp->fp);
+
+    if (p_rw->burstlen)
+    {
+        fwrite(rp->burst, sizeof(uint32_t), p_rw->burstlen, rp->fp);
+    }
+
+    rp->pending_valid = 0;
+}
+
+// -------------------------------------------------------------------------
+// VReplayAtExit()
+//
+// Write any outstanding recorded command that doesn't need read
+// data, report replay results, and close the files
+// -------------------------------------------------------------------------
+
+static void VReplayAtExit (void)
+{
+    for (int node = 0; node < VP_MAX_NODES; node++)
+    {
+        VReplayState_t *rp;
+
+        if (ns[node] == NULL || (rp = ns[node]->replay) == NULL)
+        {
+            continue;
+        }
+
+        if (rp->mode == VREPLAY_MODE_RECORD)
+        {
+            rw_t *p_rw = (rw_t *)&rp->pending.rw;
+
+            if (rp->pending_valid && !p_rw->read)
+            {
+                VReplayWrite(rp);
+            }
+        }
+        else
+        {
+            VPrint("VReplay: node %d replayed %llu commands with %llu read mismatches (%llu issued on a different cycle)\n",
+                   node, (unsigned long long)rp->commands, (unsigned long long)rp->mismatches,
+                   (unsigned long long)rp->retimed);
+        }
+
+        fclose(rp->fp);
+    }
+}
+
+// -------------------------------------------------------------------------
+// VReplayCheck()
+//
+// Compare a replayed read's data with that recorded
+// -------------------------------------------------------------------------
+
+static void VReplayCheck (const unsigned node, VReplayState_t *rp, const uint32_t addr, const unsigned word, const uint32_t got, const uint32_t exp)
+{
+    if (got != exp)
+    {
+        if (rp->mismatches < VREPLAY_MAX_REPORTS)
+        {
+            VPrint("***Error: VReplay node %d command %llu: read at 0x%08x (word %d) returned 0x%08x, recorded 0x%08x\n",
+                   node, (unsigned long long)rp->commands, addr, word, got, exp);
+        }
+
+        rp->mismatches++;
+    }
+}
+
+// =========================================================================
+// Internal functions
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VReplayInit()
+//
+// Called from VInit() for each node. Opens the node's record or
+// replay file if configured. Returns 1 when replaying, so that no
+// user thread is started.
+// -------------------------------------------------------------------------
+
+int VReplayInit (const unsigned node)
+{
+    char            fname[DEFAULT_STR_BUF_SIZE*8];
+    VReplayHdr_t    hdr;
+    VReplayState_t *rp;
+
+    if (!replayInitialised)
+    {
+        char *record = getenv(VREPLAY_RECORD_ENV);
+        char *replay = getenv(VREPLAY_REPLAY_ENV);
+        char *mask   = getenv(VREPLAY_NODES_ENV);
+
+        replayInitialised = 1;
+
+        if (record != NULL && record[0] != '\0' && replay != NULL && replay[0] != '\0')
+        {
+            VPrint("***Error: VReplayInit() both %s and %s set\n", VREPLAY_RECORD_ENV, VREPLAY_REPLAY_ENV);
+            exit(1);
+        }
+
+        if (replay != NULL && replay[0] != '\0')
+        {
+            replayMode = VREPLAY_MODE_REPLAY;
+            replayName = replay;
+        }
+        else if (record != NULL && record[0] != '\0')
+        {
+            replayMode = VREPLAY_MODE_RECORD;
+            replayName = record;
+        }
+        else
+        {
+            return 0;
+        }
+
+        if (mask != NULL && mask[0] != '\0')
+        {
+            replayMask = strtoull(mask, NULL, 16);
+        }
+
+        atexit(VReplayAtExit);
+    }
+
+    if (replayMode == 0 || node >= 64 || !((replayMask >> node) & 1))
+    {
+        return 0;
+    }
+
+    snprintf(fname, sizeof(fname), "%s.%d", replayName, node);
+
+    rp       = (VReplayState_t *) calloc(1, sizeof(VReplayState_t));
+    rp->mode = replayMode;
+
+    if ((rp->fp = fopen(fname, replayMode == VREPLAY_MODE_RECORD ? "wb" : "rb")) == NULL)
+    {
+        VPrint("***Error: VReplayInit() failed to open %s\n", fname);
+        exit(1);
+    }
+
+    if (replayMode == VREPLAY_MODE_RECORD)
+    {
+        memset(&hdr, 0, sizeof(hdr));
+        memcpy(hdr.magic, VREPLAY_MAGIC, strlen(VREPLAY_MAGIC));
+        hdr.version = VREPLAY_VERSION;
+        hdr.node    = node;
+        fwrite(&hdr, sizeof(hdr), 1, rp->fp);
+
+        VPrint("VInit(%d): recording commands to %s\n", node, fname);
+    }
+    else
+    {
+        if (fread(&hdr, sizeof(hdr), 1, rp->fp) != 1 || memcmp(hdr.magic, VREPLAY_MAGIC, strlen(VREPLAY_MAGIC)) ||
+            hdr.version != VREPLAY_VERSION)
+        {
+            VPrint("***Error: VReplayInit() %s is not a VProc record file\n", fname);
+            exit(1);
+        }
+
+        VPrint("VInit(%d): replaying commands from %s\n", node, fname);
+    }
+
+    ns[node]->replay = rp;
+
+    return replayMode == VREPLAY_MODE_REPLAY;
+}
+
+// -------------------------------------------------------------------------
+// VReplaySchedIn()
+//
+// Called from VSched() on entry, to complete the outstanding command.
+// When recording, the read data is added and the record written. When
+// replaying, the read data is checked.
+// -------------------------------------------------------------------------
+
+void VReplaySchedIn (const unsigned node, const uint32_t data_in)
+{
+    VReplayState_t *rp   = ns[node]->replay;
+    rw_t           *p_rw = (rw_t *)&rp->pending.rw;
+    uint32_t       *rbuf = (uint32_t *)ns[node]->send_buf.data_p;
+
+    if (!rp->pending_valid)
+    {
+        return;
+    }
+
+    if (rp->mode == VREPLAY_MODE_RECORD)
+    {
+        if (p_rw->read)
+        {
+            if (p_rw->burstlen)
+            {
+                memcpy(rp->burst, rbuf, p_rw->burstlen * sizeof(uint32_t));
+            }
+            else
+            {
+                rp->pending.data = data_in;
+            }
+        }
+
+        VReplayWrite(rp);
+    }
+    else
+    {
+        if (p_rw->read)
+        {
+            if (p_rw->burstlen)
+            {
+                for (unsigned idx = 0; idx < p_rw->burstlen; idx++)
+                {
+                    VReplayCheck(node, rp, rp->pending.addr, idx, rbuf[idx], rp->burst[idx]);
+                }
+            }
+            else
+            {
+                VReplayCheck(node, rp, rp->pending.addr, 0, data_in, rp->pending.data);
+            }
+        }
+
+        rp->pending_valid = 0;
+    }
+}
+
+// -------------------------------------------------------------------------
+// VReplaySchedOut()
+//
+// Called from VSched() when a new command has been received. When
+// recording, starts a new record.
+// -------------------------------------------------------------------------
+
+void VReplaySchedOut (const unsigned node)
+{
+    VReplayState_t *rp   = ns[node]->replay;
+    psend_buf_t     sbuf = &ns[node]->send_buf;
+    rw_t           *p_rw = (rw_t *)&sbuf->rw;
+
+    if (rp->mode != VREPLAY_MODE_RECORD)
+    {
+        return;
+    }
+
+    rp->pending.cycle = ns[node]->stats.s.cycle;
+    rp->pending.rw    = sbuf->rw;
+    rp->pending.addr  = sbuf->addr;
+    rp->pending.data  = sbuf->data_out;
+    rp->pending.ticks = sbuf->ticks;
+
+    if (p_rw->burstlen && p_rw->write)
+    {
+        memcpy(rp->burst, sbuf->data_p, p_rw->burstlen * sizeof(uint32_t));
+    }
+
+    rp->pending_valid = 1;
+    rp->commands++;
+}
+
+// -------------------------------------------------------------------------
+// VReplaySchedExch()
+//
+// Called from VSched() for replayed nodes in place of the exchange
+// with the user thread. Fills the node's send buffer with the next
+// recorded command, or with a tick forever at the end of the file.
+// -------------------------------------------------------------------------
+
+void VReplaySchedExch (const unsigned node)
+{
+    VReplayState_t *rp   = ns[node]->replay;
+    psend_buf_t     sbuf = &ns[node]->send_buf;
+    VReplayRec_t   *rec  = &rp->pending;
+    rw_t           *p_rw = (rw_t *)&rec->rw;
+
+    if (!rp->done && fread(rec, sizeof(VReplayRec_t), 1, rp->fp) == 1 &&
+        (p_rw->burstlen == 0 || fread(rp->burst, sizeof(uint32_t), p_rw->burstlen, rp->fp) == p_rw->burstlen))
+    {
+        if (rec->cycle != ns[node]->stats.s.cycle)
+        {
+            rp->retimed++;
+        }
+
+        sbuf->addr        = rec->addr;
+        sbuf->data_out    = rec->data;
+        sbuf->rw          = rec->rw;
+        sbuf->ticks       = rec->ticks;
+        sbuf->data_p      = p_rw->read ? rp->rdata : rp->burst;
+
+        rp->pending_valid = 1;
+        rp->commands++;
+    }
+    else
+    {
+        if (!rp->done)
+        {
+            VPrint("VReplay: node %d reached end of recording at cycle %llu\n", node,
+                   (unsigned long long)ns[node]->stats.s.cycle);
+            rp->done = 1;
+        }
+
+        sbuf->addr        = 0;
+        sbuf->data_out    = 0;
+        sbuf->rw          = V_IDLE;
+        sbuf->ticks       = GO_TO_SLEEP;
+        sbuf->data_p      = NULL;
+
+        rp->pending_valid = 0;
+    }
+}
@@ -0,0 +1,97 @@
+//=====================================================================
+//
+// VReplay.h                                          Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Record and replay of node command streams. In record mode every
+// command received from the user thread is written, when complete,
+// to a per-node file along with its issue cycle and the read data
+// returned. In replay mode no user thread is started, and VSched()
+// takes commands from the file instead, checking the read data
+// against that recorded.
+//
+//=====================================================================
+
+#ifndef _VREPLAY_H_
+#define _VREPLAY_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Longest burst, as in VUser.h (this file is included by VProc.h first)
+#ifndef MAXBURSTLEN
+#define MAXBURSTLEN             4096
+#endif
+
+// Environment variables giving the file name base for record or
+// replay (each node's file is "<name>.<node>"), and an optional hex
+// mask of the nodes to record or replay (default all)
+#define VREPLAY_RECORD_ENV      "VPROC_RECORD_FILE"
+#define VREPLAY_REPLAY_ENV      "VPROC_REPLAY_FILE"
+#define VREPLAY_NODES_ENV       "VPROC_REPLAY_NODES"
+
+#define VREPLAY_MAGIC           "VPRECRD"
+#define VREPLAY_VERSION         1
+
+// Number of read mismatches reported in full for each node
+#define VREPLAY_MAX_REPORTS     10
+
+#define VREPLAY_MODE_RECORD     1
+#define VREPLAY_MODE_REPLAY     2
+
+// File header (16 bytes)
+typedef struct {
+    char                magic[8];
+    uint32_t            version;
+    uint32_t            node;
+} VReplayHdr_t;
+
+// Command record (24 bytes, little endian in file), followed by the
+// write data for burst writes, or the read data for burst reads
+typedef struct {
+    uint64_t            cycle;          // Cycle the command was issued
+    uint32_t            rw;             // send_buf_t rw field
+    uint32_t            addr;
+    uint32_t            data;           // Write data, or read data returned
+    int32_t             ticks;
+} VReplayRec_t;
+
+// Internal per-node state
+typedef struct {
+    int                 mode;
+    FILE               *fp;
+    VReplayRec_t        pending;        // Outstanding command
+    int                 pending_valid;
+    uint32_t            burst[MAXBURSTLEN]; // Burst data for outstanding command
+    uint32_t            rdata[MAXBURSTLEN]; // Burst read buffer when replaying
+    uint64_t            commands;
+    uint64_t            mismatches;
+    uint64_t            retimed;        // Commands issued on a different cycle
+    int                 done;           // Replay file exhausted
+} VReplayState_t;
+
+// Internal functions called from VSched.c
+extern int  VReplayInit      (const unsigned node);
+extern void VReplaySchedIn   (const unsigned node, const uint32_t data_in);
+extern void VReplaySchedOut  (const unsigned node);
+extern void VReplaySchedExch (const unsigned node);
+
+#endif
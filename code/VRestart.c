@@ -0,0 +1,294 @@
+//=====================================================================
+//
+// VRestart.c                                         Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Restarting of nodes at new test entry points (see VRestart.h).
+// VRestartRun() is called on each node's user thread in place of a
+// direct call to VUserMainN.
+//
+//=====================================================================
+
+#include <string.h>
+#include <ctype.h>
+#include "VProc.h"
+#include "VUser.h"
+#include "VRestart.h"
+
+typedef struct {
+    unsigned            node;
+    char               *name;
+} VRestartEntry_t;
+
+static pthread_mutex_t           restartLock       = PTHREAD_MUTEX_INITIALIZER;
+static int                       restartParsed     = 0;
+static const char               *restartListStr    = NULL;
+static VRestartEntry_t           restartList[VP_MAX_TESTS];
+static int                       restartNumEntries = 0;
+static unsigned                  restartResetTicks = 0;
+static volatile pVUserMain_t     restartNext[VP_MAX_NODES];
+
+// -------------------------------------------------------------------------
+// VRestartParseStr()
+//
+// Add the entries in a string to the test list
+// -------------------------------------------------------------------------
+
+static void VRestartParseStr (char *str)
+{
+    char *save;
+
+    for (char *tok = strtok_r(str, ", \t\r\n", &save); tok != NULL; tok = strtok_r(NULL, ", \t\r\n", &save))
+    {
+        char     *colon = strchr(tok, ':');
+        unsigned  node  = 0;
+
+        if (colon != NULL)
+        {
+            node = (unsigned)strtoul(tok, NULL, 0);
+            tok  = colon + 1;
+        }
+
+        if (node >= VP_MAX_NODES || tok[0] == '\0')
+        {
+            VPrint("***Error: VRestart bad test list entry \"%s\"\n", tok);
+            exit(1);
+        }
+
+        if (restartNumEntries == VP_MAX_TESTS)
+        {
+            VPrint("***Error: VRestart test list has more than %d entries\n", VP_MAX_TESTS);
+            exit(1);
+        }
+
+        restartList[restartNumEntries].node   = node;
+        restartList[restartNumEntries++].name = strdup(tok);
+    }
+}
+
+// -------------------------------------------------------------------------
+// VRestartParse()
+//
+// Get the test list and reset settings, once only
+// -------------------------------------------------------------------------
+
+static void VRestartParse (void)
+{
+    pthread_mutex_lock(&restartLock);
+
+    if (!restartParsed)
+    {
+        const char *list  = restartListStr ? restartListStr : getenv(VRESTART_TESTS_ENV);
+        const char *reset = getenv(VRESTART_RESET_ENV);
+
+        restartParsed = 1;
+
+        if (reset != NULL)
+        {
+            restartResetTicks = (unsigned)strtoul(reset, NULL, 0);
+        }
+
+        if (list != NULL && list[0] == '@')
+        {
+            char  line[DEFAULT_STR_BUF_SIZE*4];
+            FILE *fp;
+
+            if ((fp = fopen(list + 1, "r")) == NULL)
+            {
+                VPrint("***Error: VRestart failed to open test list %s\n", list + 1);
+                exit(1);
+            }
+
+            while (fgets(line, sizeof(line), fp) != NULL)
+            {
+                char *comment = strchr(line, '#');
+
+                if (comment != NULL)
+                {
+                    *comment = '\0';
+                }
+
+                VRestartParseStr(line);
+            }
+
+            fclose(fp);
+        }
+        else if (list != NULL)
+        {
+            char *str = strdup(list);
+
+            VRestartParseStr(str);
+            free(str);
+        }
+    }
+
+    pthread_mutex_unlock(&restartLock);
+}
+
+// -------------------------------------------------------------------------
+// VRestartReset()
+//
+// Clear a node's state before re-entering, and pulse the HDL reset
+// if configured
+// -------------------------------------------------------------------------
+
+static void VRestartReset (const unsigned node)
+{
+    ns[node]->VUserIrqCB = NULL;
+    ns[node]->VUserCB    = NULL;
+    memset(&ns[node]->irqState, 0, sizeof(vecIrqState_t));
+
+    if (restartResetTicks)
+    {
+        VReset(restartResetTicks, node);
+    }
+}
+
+// =========================================================================
+// Internal functions
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VRestartSetList()
+//
+// Set the test list in place of the environment variable (e.g. from
+// a plusarg). Must be called before any user thread starts.
+// -------------------------------------------------------------------------
+
+void VRestartSetList (const char *list)
+{
+    if (list != NULL)
+    {
+        restartListStr = list;
+    }
+}
+
+// -------------------------------------------------------------------------
+// VRestartListed()
+//
+// Returns 1 if the node has entries in the test list
+// -------------------------------------------------------------------------
+
+int VRestartListed (const unsigned node)
+{
+    VRestartParse();
+
+    for (int idx = 0; idx < restartNumEntries; idx++)
+    {
+        if (restartList[idx].node == node)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// VRestartRun()
+//
+// Run the node's entry points in turn, then put the node to sleep.
+// Does not return.
+// -------------------------------------------------------------------------
+
+void VRestartRun (const unsigned node, const pVUserMain_t main_func)
+{
+    int          listed = VRestartListed(node);
+    int          idx    = 0;
+    int          count  = 0;
+    pVUserMain_t entry  = listed ? NULL : main_func;
+    const char  *name   = "VUserMain";
+
+    for (;;)
+    {
+        if (entry == NULL)
+        {
+            if ((entry = restartNext[node]) != NULL)
+            {
+                restartNext[node] = NULL;
+                name              = "restart entry";
+            }
+            else
+            {
+                while (idx < restartNumEntries && restartList[idx].node != node)
+                {
+                    idx++;
+                }
+
+                if (idx == restartNumEntries)
+                {
+                    break;
+                }
+
+                name = restartList[idx++].name;
+
+                if ((entry = (pVUserMain_t) dlsym(RTLD_DEFAULT, name)) == NULL)
+                {
+                    VPrint("***Error: failed to find test entry point %s for node %d (VRestartRun)\n", name, node);
+                    exit(1);
+                }
+            }
+        }
+
+        if (count)
+        {
+            VRestartReset(node);
+        }
+
+        if (listed || count)
+        {
+            VPrint("VRestart: node %d running %s at cycle %llu\n", node, name,
+                   (unsigned long long)ns[node]->stats.s.cycle);
+        }
+
+        entry(node);
+
+        entry = NULL;
+        count++;
+    }
+
+    if (listed || count > 1)
+    {
+        VPrint("VRestart: node %d completed %d tests at cycle %llu\n", node, count,
+               (unsigned long long)ns[node]->stats.s.cycle);
+    }
+
+    // Retire the node. The HDL waits only for interrupts while sleeping.
+    for (;;)
+    {
+        VTick(GO_TO_SLEEP, node);
+    }
+}
+
+// =========================================================================
+// User API
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VRestart()
+//
+// Set the next entry point for a node
+// -------------------------------------------------------------------------
+
+void VRestart (const unsigned node, const pVUserMain_t entry)
+{
+    restartNext[node] = entry;
+}
@@ -0,0 +1,67 @@
+//=====================================================================
+//
+// VRestart.h                                         Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Running a sequence of test entry points on a node within a single
+// simulation. When a node's entry point returns, the node is
+// re-entered at the next one, either set by VRestart() or taken from
+// a test list, with the node's callbacks and interrupt state cleared
+// and, optionally, the HDL's reset output pulsed.
+//
+// The test list is a comma separated list of entry point names, each
+// optionally prefixed with "<node>:" (default node 0), or "@<file>"
+// for a file of such entries (one or more per line, with # comments).
+// It is taken from the VPROC_TESTS environment variable or, for
+// Verilog with VPI, a +VPROC_TESTS=<list> plusarg. Entry points have
+// the same prototype as VUserMainN, and must be exported from the
+// executable. When a node has a test list its VUserMainN is not run
+// (unless listed). When a node's entry points are complete (with or
+// without a test list) the node sleeps.
+//
+//=====================================================================
+
+#ifndef _VRESTART_H_
+#define _VRESTART_H_
+
+#include "VUser.h"
+
+#define VRESTART_TESTS_ENV      "VPROC_TESTS"
+
+// Clock cycles the HDL reset output is asserted before each restart
+// (default 0 for none)
+#define VRESTART_RESET_ENV      "VPROC_TEST_RESET"
+
+// Maximum number of entries in a test list
+#ifndef VP_MAX_TESTS
+#define VP_MAX_TESTS            1024
+#endif
+
+// Set the entry point to run when the node's current entry point
+// returns, in preference to the next in any test list
+extern void VRestart        (const unsigned node, const pVUserMain_t entry);
+
+// Internal functions
+extern void VRestartSetList (const char *list);
+extern int  VRestartListed  (const unsigned node);
+extern void VRestartRun     (const unsigned node, const pVUserMain_t main_func);
+
+#endif
@@ -42,6 +42,8 @@
 #include "VProc.h"
 #include "VUser.h"
 #include "VSched_pli.h"
+#include "VRestart.h"
+#include "VMbox.h"
 
 #define ARGS_ARRAY_SIZE     10
 
@@ -185,6 +187,62 @@ void (*vlog_startup_routines[])() =
 
 # endif
 
+// Cached argument handles of a system task call
+typedef struct {
+  int                  num;
+  vpiHandle            arg[1];
+} VpiArgCache_t;
+
+// -------------------------------------------------------------------------
+// getArgHdls()
+//
+// Get the argument handles of a system task call. These are found
+// by iterating over the arguments on the first call from a given
+// call site only, and then kept with the call's handle as its user
+// data. The returned cache must be freed if not kept (*kept is 0).
+// -------------------------------------------------------------------------
+
+static VpiArgCache_t* getArgHdls (const vpiHandle taskHdl, int* kept)
+{
+  VpiArgCache_t*       cache;
+  vpiHandle            argh;
+  vpiHandle            args_iter;
+  int                  max = ARGS_ARRAY_SIZE;
+
+#ifndef VPROC_NO_ARG_CACHE
+  if ((cache = (VpiArgCache_t*) vpi_get_userdata(taskHdl)) != NULL)
+  {
+    *kept              = 1;
+    return cache;
+  }
+#endif
+
+  cache                = (VpiArgCache_t*) malloc(sizeof(VpiArgCache_t) + max * sizeof(vpiHandle));
+  cache->num           = 0;
+
+  if ((args_iter = vpi_iterate(vpiArgument, taskHdl)) != NULL)
+  {
+    while (argh = vpi_scan(args_iter))
+    {
+      if (cache->num == max)
+      {
+        max           *= 2;
+        cache          = (VpiArgCache_t*) realloc(cache, sizeof(VpiArgCache_t) + max * sizeof(vpiHandle));
+      }
+
+      cache->arg[cache->num++] = argh;
+    }
+  }
+
+#ifndef VPROC_NO_ARG_CACHE
+  *kept                = vpi_put_userdata(taskHdl, cache) != 0;
+#else
+  *kept                = 0;
+#endif
+
+  return cache;
+}
+
 // -------------------------------------------------------------------------
 // getArgs()
 //
@@ -193,20 +251,25 @@ void (*vlog_startup_routines[])() =
 
 int getArgs (const vpiHandle taskHdl, int value[])
 {
-  int                  idx = 0;
+  int                  idx;
+  int                  kept;
   struct t_vpi_value   argval;
-  vpiHandle            argh;
 
-  vpiHandle            args_iter = vpi_iterate(vpiArgument, taskHdl);
+  VpiArgCache_t*       cache = getArgHdls(taskHdl, &kept);
 
-  while (argh = vpi_scan(args_iter))
+  for (idx = 0; idx < cache->num; idx++)
   {
     argval.format      = vpiIntVal;
 
-    vpi_get_value(argh, &argval);
+    vpi_get_value(cache->arg[idx], &argval);
     value[idx]         = argval.value.integer;
 
-    debug_io_printf("VPI routine received %x at offset %d\n", value[idx++], idx);
+    debug_io_printf("VPI routine received %x at offset %d\n", value[idx], idx);
+  }
+
+  if (!kept)
+  {
+    free(cache);
   }
 
   return idx;
@@ -220,29 +283,126 @@ int getArgs (const vpiHandle taskHdl, int value[])
 
 int updateArgs (const vpiHandle taskHdl, const int value[])
 {
-  int                 idx = 0;
+  int                 idx;
+  int                 kept;
   struct t_vpi_value  argval;
-  vpiHandle           argh;
 
-  vpiHandle           args_iter = vpi_iterate(vpiArgument, taskHdl);
+  VpiArgCache_t*      cache = getArgHdls(taskHdl, &kept);
 
-  while (argh = vpi_scan(args_iter))
+  for (idx = 0; idx < cache->num; idx++)
   {
     argval.format        = vpiIntVal;
-    argval.value.integer = value[idx++];
+    argval.value.integer = value[idx];
 
-    vpi_put_value(argh, &argval, NULL, vpiNoDelay);
+    vpi_put_value(cache->arg[idx], &argval, NULL, vpiNoDelay);
+  }
+
+  if (!kept)
+  {
+    free(cache);
   }
 
   return idx;
 }
 
+// -------------------------------------------------------------------------
+// getPlusArg()
+//
+// Get the value of a +<name>=<value> plusarg, or NULL if absent
+// -------------------------------------------------------------------------
+
+static char* getPlusArg (const char* name)
+{
+  s_vpi_vlog_info info;
+  size_t          len = strlen(name);
+
+  if (vpi_get_vlog_info(&info))
+  {
+    for (int idx = 1; idx < info.argc; idx++)
+    {
+      char* arg = info.argv[idx];
+
+      if (arg[0] == '+' && strncmp(&arg[1], name, len) == 0 && arg[len+1] == '=')
+      {
+        return &arg[len+2];
+      }
+    }
+  }
+
+  return NULL;
+}
+
 #endif
 
 // =========================================================================
 // Foreign procedure C functions
 // =========================================================================
 
+// -------------------------------------------------------------------------
+// VInitNode()
+//
+// Initialise a node's state and start its user code, once the node
+// number has been obtained from the simulator
+// -------------------------------------------------------------------------
+
+void VInitNode (const int node)
+{
+    // Range check node number
+    if (node < 0 || node >= VP_MAX_NODES)
+    {
+        VPrint("***Error: VInit() got out of range node number (%d)\n", node);
+        exit(VP_USER_ERR);
+    }
+
+    // Print message displaying node number, programming interface, and VProc version
+    VPrint("VInit(%d): initialising %s interface\n  %s\n", node, PLI_STRING, VERSION_STRING);
+
+    //----------------------------------------------
+    // Initialise state
+    //----------------------------------------------
+
+    // Allocate some space for the node state and update pointer
+    ns[node] = (pSchedState_t) calloc(1, sizeof(SchedState_t));
+
+    // Set up semaphores for this node
+    debug_io_printf("VInit(): initialising semaphores for node %d\n", node);
+
+    if (sem_init(&(ns[node]->snd), 0, 0) == -1)
+    {
+        VPrint("***Error: VInit() failed to initialise semaphore\n");
+        exit(1);
+    }
+    if (sem_init(&(ns[node]->rcv), 0, 0) == -1)
+    {
+        VPrint("***Error: VInit() failed to initialise semaphore\n");
+        exit(1);
+    }
+
+    debug_io_printf("VInit(): initialising semaphores for node %d---Done\n", node);
+
+    // Clear statistics and set up tracing for this node
+    VStatsInit(node);
+    VTraceInit(node);
+    VTimelineInit(node);
+    VLiveInit(node);
+
+#if !defined(VPROC_VHDL) && !defined(VPROC_SV)
+    // A test list may be given as a plusarg (here rather than in VInit(),
+    // so that it's also read for nodes started by $vprocvpi)
+    VRestartSetList(getPlusArg(VRESTART_TESTS_ENV));
+#endif
+
+    //----------------------------------------------
+    // Issue a new thread to run the user code, unless
+    // it runs in a separate process or is replayed
+    //----------------------------------------------
+
+    if (!VReplayInit(node) && !VRemoteInit(node))
+    {
+        VUser(node);
+    }
+}
+
 // -------------------------------------------------------------------------
 // VInit()
 //
@@ -285,48 +445,163 @@ VPROC_RTN_TYPE VInit (VINIT_PARAMS)
 # endif
 #endif
 
-    // Range check node number
-    if (node < 0 || node >= VP_MAX_NODES)
+    VInitNode(node);
+
+#if !defined(VPROC_VHDL) && !defined(VPROC_SV)
+    return 0;
+#endif
+}
+
+// -------------------------------------------------------------------------
+// VSchedVec()
+//
+// Complete the current command of a node's delta command vector, and
+// load the next. Returns 0 when the vector is complete, and the user
+// thread is to be resumed.
+// -------------------------------------------------------------------------
+
+static int VSchedVec (const int node)
+{
+    pSchedState_t s   = ns[node];
+    VDeltaCmd_t*  cmd = &s->vec[s->vec_idx];
+
+    if (cmd->flags & VDELTA_READ)
     {
-        VPrint("***Error: VInit() got out of range node number (%d)\n", node);
-        exit(VP_USER_ERR);
+        cmd->data = s->rcv_buf.data_in;
     }
 
-    // Print message displaying node number, programming interface, and VProc version
-    VPrint("VInit(%d): initialising %s interface\n  %s\n", node, PLI_STRING, VERSION_STRING);
+    if (++s->vec_idx == s->vec_len)
+    {
+        s->vec = NULL;
+        return 0;
+    }
 
-    //----------------------------------------------
-    // Initialise state
-    //----------------------------------------------
+    VDeltaLoad(&s->vec[s->vec_idx], &s->send_buf);
 
-    // Allocate some space for the node state and update pointer
-    ns[node] = (pSchedState_t) calloc(1, sizeof(SchedState_t));
+    return 1;
+}
 
-    // Set up semaphores for this node
-    debug_io_printf("VInit(): initialising semaphores for node %d\n", node);
+// -------------------------------------------------------------------------
+// VSchedUserExch()
+//
+// Exchange with a node's user thread, sending the input data and
+// getting the next command
+// -------------------------------------------------------------------------
 
-    if (sem_init(&(ns[node]->snd), 0, 0) == -1)
+static void VSchedUserExch (const int node)
+{
+    if (ns[node]->remote != NULL)
     {
-        VPrint("***Error: VInit() failed to initialise semaphore\n");
-        exit(1);
+        // Exchange with user code in a separate process
+        VRemoteSchedExch(node);
     }
-    if (sem_init(&(ns[node]->rcv), 0, 0) == -1)
+    else
     {
-        VPrint("***Error: VInit() failed to initialise semaphore\n");
-        exit(1);
+        // Send message to VUser with VPDataIn value
+        debug_io_printf("VSched(): setting rcv[%d] semaphore\n", node);
+        sem_post(&(ns[node]->rcv));
+
+        //----------------------------------------------
+        // Get get updates from user thread
+        //----------------------------------------------
+
+        // Wait for a message from VUser process with output data
+        debug_io_printf("VSched(): waiting for snd[%d] semaphore\n", node);
+        sem_wait(&(ns[node]->snd));
     }
+}
 
-    debug_io_printf("VInit(): initialising semaphores for node %d---Done\n", node);
+// -------------------------------------------------------------------------
+// VSchedNode()
+//
+// Exchange with a node's user code for a scheduled cycle, returning
+// the node's next command outputs
+// -------------------------------------------------------------------------
+
+void VSchedNode (const int node, const int VPDataIn, const int VPCycle, int* VPDataOut, int* VPAddr, int* VPRw, int* VPTicks)
+{
+    // Sample inputs and update node state
+    ns[node]->rcv_buf.data_in   = VPDataIn;
+
+    // Update statistics with current cycle, completing any outstanding transaction
+    VStatsSchedIn(node, (uint32_t)VPCycle);
+
+    if (VTraceEnabled)
+    {
+        VTraceSchedIn(node, (uint32_t)VPDataIn);
+    }
+
+    if (VLiveSeg != NULL)
+    {
+        VLiveSchedIn(node);
+    }
+
+    if (ns[node]->replay != NULL)
+    {
+        VReplaySchedIn(node, (uint32_t)VPDataIn);
+    }
 
     //----------------------------------------------
-    // Issue a new thread to run the user code
+    // Send inputs to user thread
     //----------------------------------------------
 
-    VUser(node);
+    VPROBE_SCHED_POST(node, VPCycle);
+    VTL_START(tl_user);
 
-#if !defined(VPROC_VHDL) && !defined(VPROC_SV)
-    return 0;
-#endif
+    if (ns[node]->replay != NULL && ns[node]->replay->mode == VREPLAY_MODE_REPLAY)
+    {
+        // Next command comes from a recording
+        VReplaySchedExch(node);
+    }
+    else if (ns[node]->vec != NULL && VSchedVec(node))
+    {
+        // Next command comes from a delta command vector
+    }
+    else if (VMboxParked(node))
+    {
+        // Parked on a mailbox or barrier, so tick again
+    }
+    else if (VSignalWaiting(node))
+    {
+        // Still waiting for a sideband signal value, so tick again
+    }
+    else
+    {
+        VSchedUserExch(node);
+
+        // Make any sideband signal accesses in zero time, exchanging
+        // again for the user thread's next command
+        while (VSignalSchedOp(node))
+        {
+            VSchedUserExch(node);
+        }
+    }
+
+    VTL_END(VTIMELINE_SIM_TID, "wait user", node, tl_user);
+
+    // Update outputs of $vsched task
+    if (ns[node]->send_buf.ticks >= DELTA_CYCLE)
+    {
+        *VPDataOut    = ns[node]->send_buf.data_out;
+        *VPAddr       = ns[node]->send_buf.addr;
+        *VPRw         = ns[node]->send_buf.rw;
+        *VPTicks      = ns[node]->send_buf.ticks;
+        debug_io_printf("VSched(): VPTicks=%08x\n", *VPTicks);
+
+        VPROBE_SCHED_WAKE(node, *VPRw, *VPAddr);
+
+        VStatsSchedOut(node, *VPRw);
+
+        if (VTraceEnabled)
+        {
+            VTraceSchedOut(node);
+        }
+
+        if (ns[node]->replay != NULL)
+        {
+            VReplaySchedOut(node);
+        }
+    }
 }
 
 // -------------------------------------------------------------------------
@@ -341,6 +616,13 @@ VPROC_RTN_TYPE VSched (VSCHED_PARAMS)
     int VPDataOut_int, VPAddr_int, VPRw_int, VPTicks_int;
     int args[ARGS_ARRAY_SIZE];
 
+    VTL_START(tl_sched);
+
+    if (VTimelineEnabled)
+    {
+        VTimelineSimEntry(tl_sched);
+    }
+
     //----------------------------------------------
     // Get input arguments
     //----------------------------------------------
@@ -348,19 +630,25 @@ VPROC_RTN_TYPE VSched (VSCHED_PARAMS)
 #if !defined(VPROC_VHDL) && !defined(VPROC_SV)
     int node;
     int VPDataIn;
+    int VPCycle;
 
     vpiHandle    taskHdl;
 
     // Obtain a handle to the argument list
     taskHdl      = vpi_handle(vpiSysTfCall, NULL);
 
+    VTL_START(tl_args);
     getArgs(taskHdl, &args[1]);
+    VTL_END(VTIMELINE_SIM_TID, "getArgs", args[VPNODENUM_ARG], tl_args);
 #else
 # ifdef VPROC_VHDL_VHPI
     int node;
     int VPDataIn;
+    int VPCycle;
 
+    VTL_START(tl_args);
     getVhpiParams(cb, &args[1], VSCHED_NUM_ARGS);
+    VTL_END(VTIMELINE_SIM_TID, "getVhpiParams", args[VPNODENUM_ARG], tl_args);
 # endif
 #endif
 
@@ -371,36 +659,10 @@ VPROC_RTN_TYPE VSched (VSCHED_PARAMS)
     // Get argument value of $vsched call
     node         = args[VPNODENUM_ARG];
     VPDataIn     = args[VPDATAIN_ARG];
+    VPCycle      = args[VPCYCLE_ARG];
 #endif
 
-    // Sample inputs and update node state
-    ns[node]->rcv_buf.data_in   = VPDataIn;
-
-    //----------------------------------------------
-    // Send inputs to user thread
-    //----------------------------------------------
-
-    // Send message to VUser with VPDataIn value
-    debug_io_printf("VSched(): setting rcv[%d] semaphore\n", node);
-    sem_post(&(ns[node]->rcv));
-
-    //----------------------------------------------
-    // Get get updates from user thread
-    //----------------------------------------------
-
-    // Wait for a message from VUser process with output data
-    debug_io_printf("VSched(): waiting for snd[%d] semaphore\n", node);
-    sem_wait(&(ns[node]->snd));
-
-    // Update outputs of $vsched task
-    if (ns[node]->send_buf.ticks >= DELTA_CYCLE)
-    {
-        VPDataOut_int = ns[node]->send_buf.data_out;
-        VPAddr_int    = ns[node]->send_buf.addr;
-        VPRw_int      = ns[node]->send_buf.rw;
-        VPTicks_int   = ns[node]->send_buf.ticks;
-        debug_io_printf("VSched(): VPTicks=%08x\n", VPTicks_int);
-    }
+    VSchedNode(node, VPDataIn, VPCycle, &VPDataOut_int, &VPAddr_int, &VPRw_int, &VPTicks_int);
 
     debug_io_printf("VSched(): returning to simulation from node %d\n\n", node);
 
@@ -426,16 +688,27 @@ VPROC_RTN_TYPE VSched (VSCHED_PARAMS)
     *VPTicks            = VPTicks_int;
 # else
     // Update VHPI procedure outputs from argument array
+    VTL_START(tl_upd);
     setVhpiParams(cb, &args[1], VPDATAOUT_ARG-1, VSCHED_NUM_ARGS);
+    VTL_END(VTIMELINE_SIM_TID, "setVhpiParams", node, tl_upd);
 # endif
 #else
 
     // Update VPI task outputs from argument array
+    VTL_START(tl_upd);
     updateArgs(taskHdl, &args[1]);
+    VTL_END(VTIMELINE_SIM_TID, "updateArgs", node, tl_upd);
+#endif
+
+    if (VTimelineEnabled)
+    {
+        VTimelineSpan(VTIMELINE_SIM_TID, "VSched", node, tl_sched, VStatsNowNs());
+        VTimelineSimExit();
+    }
 
+#if !defined(VPROC_VHDL) && !defined(VPROC_SV)
     return 0;
 #endif
-
 }
 
 // -------------------------------------------------------------------------
@@ -480,7 +753,11 @@ VPROC_RTN_TYPE VProcUser(VPROCUSER_PARAMS)
 #endif
 
     // Call any registered user callback function
-    if (ns[node]->VUserCB != NULL)
+    if (ns[node]->remote != NULL)
+    {
+        VRemoteEvent(node, VREMOTE_EV_USER, value);
+    }
+    else if (ns[node]->VUserCB != NULL)
     {
         (*(ns[node]->VUserCB))(value);
     }
@@ -490,6 +767,31 @@ VPROC_RTN_TYPE VProcUser(VPROCUSER_PARAMS)
 #endif
 }
 
+// -------------------------------------------------------------------------
+// VIrqNode()
+//
+// Pass a change of a node's interrupt inputs to its user code
+// -------------------------------------------------------------------------
+
+void VIrqNode (const int node, const int value)
+{
+    VPROBE_IRQ(node, value);
+
+    // Call any registered callback function. VUserIrqCB and PyIrqCB are mutually exclusive.
+    if (ns[node]->remote != NULL)
+    {
+        VRemoteEvent(node, VREMOTE_EV_IRQ, value);
+    }
+    else if (ns[node]->VUserIrqCB != NULL)
+    {
+        (*(ns[node]->VUserIrqCB))(value);
+    }
+    else if (ns[node]->PyIrqCB != NULL)
+    {
+        (*(ns[node]->PyIrqCB))(value, node);
+    }
+}
+
 // -------------------------------------------------------------------------
 // VIrq()
 //
@@ -501,6 +803,13 @@ VPROC_RTN_TYPE VIrq(VIRQ_PARAMS)
 {
     int       args[ARGS_ARRAY_SIZE];
 
+    VTL_START(tl_irq);
+
+    if (VTimelineEnabled)
+    {
+        VTimelineSimEntry(tl_irq);
+    }
+
 #if !defined(VPROC_VHDL) && !defined(VPROC_SV)
 
     int node, value;
@@ -528,14 +837,12 @@ VPROC_RTN_TYPE VIrq(VIRQ_PARAMS)
 # endif
 #endif
 
-    // Call any registered callback function. VUserIrqCB and PyIrqCB are mutually exclusive.
-    if (ns[node]->VUserIrqCB != NULL)
-    {
-        (*(ns[node]->VUserIrqCB))(value);
-    }
-    else if (ns[node]->PyIrqCB != NULL)
+    VIrqNode(node, value);
+
+    if (VTimelineEnabled)
     {
-        (*(ns[node]->PyIrqCB))(value, node);
+        VTimelineSpan(VTIMELINE_SIM_TID, "VIrq", node, tl_irq, VStatsNowNs());
+        VTimelineSimExit();
     }
 
 #if !defined(VPROC_VHDL) && !defined(VPROC_SV)
@@ -543,6 +850,23 @@ VPROC_RTN_TYPE VIrq(VIRQ_PARAMS)
 #endif
 }
 
+// -------------------------------------------------------------------------
+// VAccessNode()
+//
+// Exchange a word of a node's burst data, returning the word to be
+// written and storing the word read
+// -------------------------------------------------------------------------
+
+int VAccessNode (const int node, const int idx, const int VPDataIn)
+{
+    int VPDataOut                            = ((int *) ns[node]->send_buf.data_p)[idx];
+    ((int *) ns[node]->send_buf.data_p)[idx] = VPDataIn;
+
+    VPROBE_BURST_BEAT(node, idx, VPDataOut, VPDataIn);
+
+    return VPDataOut;
+}
+
 // -------------------------------------------------------------------------
 // VAccess()
 //
@@ -554,10 +878,16 @@ VPROC_RTN_TYPE VAccess(VACCESS_PARAMS)
 {
     int       args[ARGS_ARRAY_SIZE];
 
+    VTL_START(tl_access);
+
+    if (VTimelineEnabled)
+    {
+        VTimelineSimEntry(tl_access);
+    }
+
 #if defined(VPROC_VHDL) || defined(VPROC_SV)
 # ifndef VPROC_VHDL_VHPI
-    *VPDataOut                               = ((int *) ns[node]->send_buf.data_p)[idx];
-    ((int *) ns[node]->send_buf.data_p)[idx] = VPDataIn;
+    *VPDataOut = VAccessNode(node, idx, VPDataIn);
 # else
     int node, idx;
 
@@ -566,9 +896,7 @@ VPROC_RTN_TYPE VAccess(VACCESS_PARAMS)
     node      = args[VPNODENUM_ARG];
     idx       = args[VPINDEX_ARG];
 
-    args[VACCESSOUT_ARG] = ((int *) ns[node]->send_buf.data_p)[idx];
-
-    ((int *) ns[node]->send_buf.data_p)[idx] = args[VPACCESSIN_ARG];
+    args[VACCESSOUT_ARG] = VAccessNode(node, idx, args[VPACCESSIN_ARG]);
 
     setVhpiParams(cb, &args[1], VACCESSOUT_ARG-1, VACCESS_NUM_ARGS);
 # endif
@@ -585,16 +913,141 @@ VPROC_RTN_TYPE VAccess(VACCESS_PARAMS)
     node      = args[VPNODENUM_ARG];
     idx       = args[VPINDEX_ARG];
 
-    args[VACCESSOUT_ARG] = ((int *) ns[node]->send_buf.data_p)[idx];
-
-    ((int *) ns[node]->send_buf.data_p)[idx] = args[VPACCESSIN_ARG];
+    args[VACCESSOUT_ARG] = VAccessNode(node, idx, args[VPACCESSIN_ARG]);
 
     updateArgs(taskHdl, &args[1]);
+#endif
+
+    if (VTimelineEnabled)
+    {
+        VTimelineSpan(VTIMELINE_SIM_TID, "VAccess", node, tl_access, VStatsNowNs());
+        VTimelineSimExit();
+    }
 
+#if !defined(VPROC_VHDL) && !defined(VPROC_SV)
     return 0;
 #endif
 }
 
+#if (defined(VPROC_SV) && defined(VPROC_BURST_ARRAY)) || (defined(VPROC_VHDL) && defined(VPROC_NO_PLI))
+// -------------------------------------------------------------------------
+// VBurstCopy()
+//
+// Copy a whole burst's data between a node's burst buffer and an HDL
+// array, if one is given. For writes (rd = 0) the write data is copied
+// to the array at the start of the burst, and for reads (rd = 1) the
+// read data is copied from it at the end.
+// -------------------------------------------------------------------------
+
+static void VBurstCopy (const int node, const int rd, const int len, int *arr)
+{
+    int *buf = (int *) ns[node]->send_buf.data_p;
+
+    if (rd)
+    {
+        memcpy(buf, arr, len * sizeof(int));
+    }
+    else
+    {
+        memcpy(arr, buf, len * sizeof(int));
+    }
+}
+#endif
+
+#if defined(VPROC_SV) && defined(VPROC_BURST_ARRAY)
+// -------------------------------------------------------------------------
+// VBurstArray()
+//
+// Called from the SystemVerilog VProc module to transfer a whole
+// burst's data in a single call, in place of a VAccess call per
+// word.
+// -------------------------------------------------------------------------
+
+void VBurstArray (int node, int rd, int len, const svOpenArrayHandle data)
+{
+    int *buf = (int *) ns[node]->send_buf.data_p;
+    int *arr = (int *) svGetArrayPtr(data);
+
+    VTL_START(tl_access);
+
+    if (VTimelineEnabled)
+    {
+        VTimelineSimEntry(tl_access);
+    }
+
+    if (arr != NULL)
+    {
+        VBurstCopy(node, rd, len, arr);
+    }
+    else
+    {
+        // Simulator's array not in C layout, so access by element
+        for (int idx = 0; idx < len; idx++)
+        {
+            int *elem = (int *) svGetArrElemPtr1(data, idx);
+
+            if (rd)
+            {
+                buf[idx] = *elem;
+            }
+            else
+            {
+                *elem    = buf[idx];
+            }
+        }
+    }
+
+    if (VTimelineEnabled)
+    {
+        VTimelineSpan(VTIMELINE_SIM_TID, "VBurstArray", node, tl_access, VStatsNowNs());
+        VTimelineSimExit();
+    }
+}
+
+#endif
+
+#if defined(VPROC_VHDL) && defined(VPROC_NO_PLI)
+// -------------------------------------------------------------------------
+// VBurstArray()
+//
+// Called from the VHDL VProc component (GHDL or NVC with VHPIDIRECT) to
+// transfer a whole burst's data in a single call, in place of a VAccess
+// call per word. The constrained VHDL array is passed as a pointer to
+// its first element.
+// -------------------------------------------------------------------------
+
+void VBurstArray (int node, int rd, int len, int* data)
+{
+    VTL_START(tl_access);
+
+    if (VTimelineEnabled)
+    {
+        VTimelineSimEntry(tl_access);
+    }
+
+    VBurstCopy(node, rd, len, data);
+
+    if (VTimelineEnabled)
+    {
+        VTimelineSpan(VTIMELINE_SIM_TID, "VBurstArray", node, tl_access, VStatsNowNs());
+        VTimelineSimExit();
+    }
+}
+
+// -------------------------------------------------------------------------
+// VSchedRec()
+//
+// VSched() with the outputs returned in a single VHDL record, passed
+// as a pointer, rather than as four separate output arguments
+// -------------------------------------------------------------------------
+
+void VSchedRec (int node, int VPDataIn, int VPCycle, VSchedOut_t* out)
+{
+    VSched(node, VPDataIn, VPCycle, &out->dataout, &out->addr, &out->rw, &out->ticks);
+}
+
+#endif
+
 // -------------------------------------------------------------------------
 // PyIrqCB()
 //
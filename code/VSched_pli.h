@@ -97,7 +97,7 @@
 #define VHALT_PARAMS       int, int
 
 #define VINIT_NUM_ARGS     1
-#define VSCHED_NUM_ARGS    6
+#define VSCHED_NUM_ARGS    7
 #define VPROCUSER_NUM_ARGS 2
 #define VIRQ_NUM_ARGS      2
 #define VACCESS_NUM_ARGS   4
@@ -117,7 +117,7 @@
 #   endif
 
 #define VINIT_PARAMS       int  node
-#define VSCHED_PARAMS      int  node, int VPDataIn, int* VPDataOut, int* VPAddr, int* VPRw, int* VPTicks
+#define VSCHED_PARAMS      int  node, int VPDataIn, int VPCycle, int* VPDataOut, int* VPAddr, int* VPRw, int* VPTicks
 #define VPROCUSER_PARAMS   int  node, int value
 #define VIRQ_PARAMS        int  node, int value
 #define VACCESS_PARAMS     int  node, int idx, int VPDataIn, int* VPDataOut
@@ -139,7 +139,9 @@
                       {vpiSysTask, 0, "$vsched",    VSched,    0, 0, 0}, \
                       {vpiSysTask, 0, "$vaccess",   VAccess,   0, 0, 0}, \
                       {vpiSysTask, 0, "$vprocuser", VProcUser, 0, 0, 0}, \
-                      {vpiSysTask, 0, "$virq",      VIrq,      0, 0, 0},
+                      {vpiSysTask, 0, "$virq",      VIrq,      0, 0, 0}, \
+                      {vpiSysTask, 0, "$vprocvpi",  VProcVpi,  0, 0, 0}, \
+                      {vpiSysTask, 0, "$vprocsignal", VSignalReg, 0, 0, 0},
 
 #define VINIT_PARAMS      char* userdata
 #define VSCHED_PARAMS     char* userdata
@@ -154,6 +156,12 @@
 extern int            getArgs    (const vpiHandle taskHdl,       int value[]);
 extern int            updateArgs (const vpiHandle taskHdl, const int value[]);
 
+// Pure VPI transactor, for the port shell VProc module (see VProcVpi.c)
+extern int            VProcVpi   (char* userdata);
+
+// Sideband signal registration (see VSignal.c)
+extern int            VSignalReg (char* userdata);
+
 # endif
 
 extern VPROC_RTN_TYPE VInit      (VINIT_PARAMS);
@@ -163,3 +171,38 @@ extern VPROC_RTN_TYPE VIrq       (VIRQ_PARAMS);
 extern VPROC_RTN_TYPE VAccess    (VACCESS_PARAMS);
 extern int            VHalt      (VHALT_PARAMS);
 
+// Programming interface independent node functions, called by the above
+extern void           VInitNode  (const int node);
+extern void           VSchedNode (const int node, const int VPDataIn, const int VPCycle, int* VPDataOut, int* VPAddr, int* VPRw, int* VPTicks);
+extern void           VIrqNode   (const int node, const int value);
+extern int            VAccessNode(const int node, const int idx, const int VPDataIn);
+
+// Whole burst transfer with a DPI-C open array
+#if defined(VPROC_SV) && defined(VPROC_BURST_ARRAY)
+#include "svdpi.h"
+extern void           VBurstArray(int node, int rd, int len, const svOpenArrayHandle data);
+#endif
+
+// Sideband signal module registration, with DPI-C
+#if defined(VPROC_SV) && defined(VPROC_SIGNAL_IF)
+#include "svdpi.h"
+extern void           VSignalRegBank(int node, int num);
+#endif
+
+// Whole burst transfer with a VHDL array, and VSched outputs in a
+// single VHDL record, for VHPIDIRECT (GHDL and NVC)
+#if defined(VPROC_VHDL) && defined(VPROC_NO_PLI)
+# ifndef _VSCHEDOUT_T_
+# define _VSCHEDOUT_T_
+typedef struct {
+    int                 dataout;
+    int                 addr;
+    int                 rw;
+    int                 ticks;
+} VSchedOut_t;
+# endif
+
+extern void           VBurstArray(int node, int rd, int len, int* data);
+extern void           VSchedRec  (int node, int VPDataIn, int VPCycle, VSchedOut_t* out);
+#endif
+
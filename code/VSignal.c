@@ -0,0 +1,465 @@
+//=====================================================================
+//
+// VSignal.c                                          Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Sideband signal access (see VSignal.h). User code sends an access
+// as a message with the rw sig field set, with the signal index in
+// addr and any value in data_out. VSchedNode() passes these to
+// VSignalSchedOp() on the simulation thread, which makes the access
+// and returns the value read in data_in, before exchanging again for
+// the user thread's next command.
+//
+// With VPI the accesses use the signals' VPI handles. With DPI-C they
+// call the functions exported from the node's VProcSignal module, in
+// the module's scope.
+//
+//=====================================================================
+
+#include <string.h>
+#include "VProc.h"
+#include "VUser.h"
+#include "VSignal.h"
+
+// Registered signal
+typedef struct {
+    char               *name;           // Name, as registered (NULL if unused)
+    char               *full_name;      // Full hierarchical name, when known
+#if !defined(VPROC_VHDL) && !defined(VPROC_SV)
+    vpiHandle           hdl;
+#endif
+} VSignal_t;
+
+// Per-node state
+typedef struct {
+    VSignal_t           sig[VP_MAX_SIGNALS];
+    int                 waiting;        // Waiting for a signal value
+    int                 wait_idx;
+    unsigned            wait_value;
+#if defined(VPROC_SV) && defined(VPROC_SIGNAL_IF)
+    svScope             scope;          // Scope of the node's VProcSignal module
+    int                 num;            // Number of signals in the module
+#endif
+} VSignalNode_t;
+
+static VSignalNode_t    signalNode[VP_MAX_NODES];
+
+#if !defined(VPROC_VHDL) && !defined(VPROC_SV)
+static pthread_mutex_t  signalLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+#if !defined(VPROC_VHDL) && !defined(VPROC_SV)
+
+// -------------------------------------------------------------------------
+// VSignalHdl()
+//
+// Get a signal's handle, looking it up by name on first use
+// -------------------------------------------------------------------------
+
+static vpiHandle VSignalHdl (const unsigned node, const int idx)
+{
+    VSignal_t *s;
+
+    if (idx < 0 || idx >= VP_MAX_SIGNALS || (s = &signalNode[node].sig[idx])->name == NULL)
+    {
+        VPrint("***Error: VSignal node %d access to unregistered signal %d\n", node, idx);
+        exit(1);
+    }
+
+    if (s->hdl == NULL && (s->hdl = vpi_handle_by_name(s->name, NULL)) == NULL)
+    {
+        VPrint("***Error: VSignal node %d failed to find signal %s\n", node, s->name);
+        exit(1);
+    }
+
+    return s->hdl;
+}
+
+// -------------------------------------------------------------------------
+// VSignalValue()
+//
+// Get a signal's current value
+// -------------------------------------------------------------------------
+
+static unsigned VSignalValue (const unsigned node, const int idx)
+{
+    s_vpi_value value;
+
+    value.format        = vpiIntVal;
+    vpi_get_value(VSignalHdl(node, idx), &value);
+
+    return (unsigned)value.value.integer;
+}
+
+// -------------------------------------------------------------------------
+// VSignalSet()
+//
+// Set a signal's value
+// -------------------------------------------------------------------------
+
+static void VSignalSet (const unsigned node, const int idx, const unsigned val)
+{
+    s_vpi_value value;
+
+    value.format        = vpiIntVal;
+    value.value.integer = (PLI_INT32)val;
+    vpi_put_value(VSignalHdl(node, idx), &value, NULL, vpiNoDelay);
+}
+
+// -------------------------------------------------------------------------
+// VSignalReg()
+//
+// Called on $vprocsignal(node, index, signal) to register a signal
+// -------------------------------------------------------------------------
+
+int VSignalReg (char* userdata)
+{
+    vpiHandle   taskHdl = vpi_handle(vpiSysTfCall, NULL);
+    vpiHandle   iter    = vpi_iterate(vpiArgument, taskHdl);
+    vpiHandle   arg[3];
+    s_vpi_value value;
+    int         node, idx;
+
+    for (int n = 0; n < 3; n++)
+    {
+        if (iter == NULL || (arg[n] = vpi_scan(iter)) == NULL)
+        {
+            VPrint("***Error: $vprocsignal expects (node, index, signal) arguments\n");
+            exit(1);
+        }
+    }
+
+    vpi_free_object(iter);
+
+    value.format        = vpiIntVal;
+    vpi_get_value(arg[0], &value);
+    node                = value.value.integer;
+    vpi_get_value(arg[1], &value);
+    idx                 = value.value.integer;
+
+    if (node < 0 || node >= VP_MAX_NODES || idx < 0 || idx >= VP_MAX_SIGNALS)
+    {
+        VPrint("***Error: $vprocsignal node (%d) or index (%d) out of range\n", node, idx);
+        exit(1);
+    }
+
+    pthread_mutex_lock(&signalLock);
+
+    signalNode[node].sig[idx].hdl       = arg[2];
+    signalNode[node].sig[idx].name      = strdup(vpi_get_str(vpiName,     arg[2]));
+    signalNode[node].sig[idx].full_name = strdup(vpi_get_str(vpiFullName, arg[2]));
+
+    pthread_mutex_unlock(&signalLock);
+
+    return 0;
+}
+
+#elif defined(VPROC_SV) && defined(VPROC_SIGNAL_IF)
+
+// Functions exported from VProcSignal
+extern void VProcSignalSet (int idx, int value);
+extern int  VProcSignalGet (int idx);
+
+// -------------------------------------------------------------------------
+// VSignalScope()
+//
+// Set the scope to the node's VProcSignal module, checking the index,
+// and returning the previous scope
+// -------------------------------------------------------------------------
+
+static svScope VSignalScope (const unsigned node, const int idx)
+{
+    VSignalNode_t *sn = &signalNode[node];
+
+    if (sn->scope == NULL)
+    {
+        VPrint("***Error: VSignal node %d has no VProcSignal module\n", node);
+        exit(1);
+    }
+
+    if (idx < 0 || idx >= sn->num)
+    {
+        VPrint("***Error: VSignal node %d access to signal %d, with %d signals\n", node, idx, sn->num);
+        exit(1);
+    }
+
+    return svSetScope(sn->scope);
+}
+
+// -------------------------------------------------------------------------
+// VSignalValue()
+//
+// Get a signal's current value
+// -------------------------------------------------------------------------
+
+static unsigned VSignalValue (const unsigned node, const int idx)
+{
+    svScope  old   = VSignalScope(node, idx);
+    unsigned value = (unsigned)VProcSignalGet(idx);
+
+    svSetScope(old);
+
+    return value;
+}
+
+// -------------------------------------------------------------------------
+// VSignalSet()
+//
+// Set a signal's value
+// -------------------------------------------------------------------------
+
+static void VSignalSet (const unsigned node, const int idx, const unsigned value)
+{
+    svScope old = VSignalScope(node, idx);
+
+    VProcSignalSet(idx, (int)value);
+
+    svSetScope(old);
+}
+
+// -------------------------------------------------------------------------
+// VSignalRegBank()
+//
+// Called from the initial block of a VProcSignal module to register
+// it for a node, with the number of signals in its port arrays
+// -------------------------------------------------------------------------
+
+void VSignalRegBank (int node, int num)
+{
+    if (node < 0 || node >= VP_MAX_NODES || num < 0)
+    {
+        VPrint("***Error: VProcSignal node (%d) out of range\n", node);
+        exit(1);
+    }
+
+    signalNode[node].scope = svGetScope();
+    signalNode[node].num   = num;
+}
+
+#endif
+
+#ifdef VSIGNAL_SUPPORTED
+
+// -------------------------------------------------------------------------
+// VSignalAccess()
+//
+// Send a sideband access message
+// -------------------------------------------------------------------------
+
+static int VSignalAccess (const int op, const int idx, const unsigned value, unsigned *rdata, const unsigned node)
+{
+    send_buf_t sbuf;
+    rw_t*      p_rw = (rw_t*)&sbuf.rw;
+    unsigned   data;
+
+    sbuf.addr     = idx;
+    sbuf.data_out = value;
+    sbuf.ticks    = 0;
+
+    sbuf.rw       = 0;  // clear RW fields
+    p_rw->sig     = op;
+
+    data          = VUserExch(&sbuf, node);
+
+    if (rdata != NULL)
+    {
+        *rdata    = data;
+    }
+
+    return 0;
+}
+
+#endif
+
+// =========================================================================
+// Internal functions
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VSignalSchedOp()
+//
+// Make any sideband access sent by the node's user thread. Returns 1
+// if an access was made, and the user thread is to be exchanged with
+// again, else 0 (including when a wait for a signal value is not
+// yet satisfied, when the node is set to tick a cycle).
+// -------------------------------------------------------------------------
+
+int VSignalSchedOp (const unsigned node)
+{
+    psend_buf_t psbuf = &ns[node]->send_buf;
+    rw_t*       p_rw  = (rw_t*)&psbuf->rw;
+
+    if (p_rw->sig == VSIGNAL_OP_NONE)
+    {
+        return 0;
+    }
+
+#ifdef VSIGNAL_SUPPORTED
+    switch (p_rw->sig)
+    {
+    case VSIGNAL_OP_SET:
+        VSignalSet(node, psbuf->addr, psbuf->data_out);
+        break;
+
+    case VSIGNAL_OP_GET:
+        ns[node]->rcv_buf.data_in = VSignalValue(node, psbuf->addr);
+        break;
+
+    case VSIGNAL_OP_WAIT:
+        if ((ns[node]->rcv_buf.data_in = VSignalValue(node, psbuf->addr)) != psbuf->data_out)
+        {
+            signalNode[node].waiting    = 1;
+            signalNode[node].wait_idx   = psbuf->addr;
+            signalNode[node].wait_value = psbuf->data_out;
+
+            // Tick a cycle, checking again at the next
+            psbuf->rw    = V_IDLE;
+            psbuf->ticks = 1;
+
+            return 0;
+        }
+        break;
+    }
+#endif
+
+    return 1;
+}
+
+// -------------------------------------------------------------------------
+// VSignalWaiting()
+//
+// Returns 1 if the node is still waiting for a signal value (and is to
+// tick another cycle), else 0, with the value in data_in when it has
+// just been matched.
+// -------------------------------------------------------------------------
+
+int VSignalWaiting (const unsigned node)
+{
+    VSignalNode_t *sn = &signalNode[node];
+
+    if (!sn->waiting)
+    {
+        return 0;
+    }
+
+#ifdef VSIGNAL_SUPPORTED
+    if (VSignalValue(node, sn->wait_idx) != sn->wait_value)
+    {
+        return 1;
+    }
+#endif
+
+    sn->waiting               = 0;
+    ns[node]->rcv_buf.data_in = sn->wait_value;
+
+    return 0;
+}
+
+// =========================================================================
+// User API
+// =========================================================================
+
+#ifdef VSIGNAL_SUPPORTED
+
+#ifndef VPROC_SV
+
+// -------------------------------------------------------------------------
+// VSignalIdx()
+//
+// Get the index of a signal for a node by name (either as registered by
+// $vprocsignal, or a full hierarchical name), registering it by full
+// hierarchical name if not already registered. Returns -1 if there is
+// no room to register it.
+// -------------------------------------------------------------------------
+
+int VSignalIdx (const char *name, const unsigned node)
+{
+    VSignalNode_t *sn   = &signalNode[node];
+    int            free = -1;
+
+    pthread_mutex_lock(&signalLock);
+
+    for (int idx = 0; idx < VP_MAX_SIGNALS; idx++)
+    {
+        VSignal_t *s = &sn->sig[idx];
+
+        if (s->name == NULL)
+        {
+            free = (free < 0) ? idx : free;
+        }
+        else if (strcmp(s->name, name) == 0 || (s->full_name != NULL && strcmp(s->full_name, name) == 0))
+        {
+            pthread_mutex_unlock(&signalLock);
+            return idx;
+        }
+    }
+
+    if (free < 0)
+    {
+        VPrint("***Error: VSignalIdx node %d has no room to register %s\n", node, name);
+    }
+    else
+    {
+        sn->sig[free].name      = strdup(name);
+        sn->sig[free].full_name = strdup(name);
+    }
+
+    pthread_mutex_unlock(&signalLock);
+
+    return free;
+}
+
+#endif
+
+// -------------------------------------------------------------------------
+// VSetSignal()
+//
+// Set a signal's value
+// -------------------------------------------------------------------------
+
+int VSetSignal (const int idx, const unsigned value, const unsigned node)
+{
+    return VSignalAccess(VSIGNAL_OP_SET, idx, value, NULL, node);
+}
+
+// -------------------------------------------------------------------------
+// VGetSignal()
+//
+// Get a signal's value
+// -------------------------------------------------------------------------
+
+int VGetSignal (const int idx, unsigned *value, const unsigned node)
+{
+    return VSignalAccess(VSIGNAL_OP_GET, idx, 0, value, node);
+}
+
+// -------------------------------------------------------------------------
+// VWaitSignal()
+//
+// Wait until a signal has a given value, checked at each clock cycle
+// -------------------------------------------------------------------------
+
+int VWaitSignal (const int idx, const unsigned value, const unsigned node)
+{
+    return VSignalAccess(VSIGNAL_OP_WAIT, idx, value, NULL, node);
+}
+
+#endif
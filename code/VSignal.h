@@ -0,0 +1,78 @@
+//=====================================================================
+//
+// VSignal.h                                          Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Direct access to sideband HDL signals (resets, GPIO, strap pins
+// etc.) from user code, without bus transactions. Signals are
+// registered for a node either from the HDL, with
+//
+//   $vprocsignal(<node>, <index>, <signal>)
+//
+// or from user code by hierarchical name with VSignalIdx(). Accesses
+// are made by the simulation thread, with cached VPI handles, within
+// the node's current scheduling call, and so take no simulation time.
+// A wait for a signal value is a single exchange, with the signal
+// checked by the simulation thread on each clock cycle until matched.
+//
+// With SystemVerilog and DPI-C, VPROC_SIGNAL_IF is defined for both
+// the C code and the HDL, and the signals are connected to the ports
+// of a VProcSignal module (f_VProcSignal.sv) for the node, with the
+// index being that of the port array. Accesses are then made with
+// functions exported from the module. VSignalIdx() is not available.
+// Sideband access is not available for VHDL.
+//
+//=====================================================================
+
+#ifndef _VSIGNAL_H_
+#define _VSIGNAL_H_
+
+// Maximum number of signals per node
+#ifndef VP_MAX_SIGNALS
+#define VP_MAX_SIGNALS          64
+#endif
+
+// Builds with sideband access
+#if !defined(VPROC_VHDL) && (!defined(VPROC_SV) || defined(VPROC_SIGNAL_IF))
+#define VSIGNAL_SUPPORTED
+#endif
+
+// Sideband operations (rw_t sig field)
+#define VSIGNAL_OP_NONE         0
+#define VSIGNAL_OP_SET          1
+#define VSIGNAL_OP_GET          2
+#define VSIGNAL_OP_WAIT         3
+
+// User API
+#ifdef VSIGNAL_SUPPORTED
+# ifndef VPROC_SV
+extern int  VSignalIdx      (const char *name, const unsigned node);
+# endif
+extern int  VSetSignal      (const int idx, const unsigned value, const unsigned node);
+extern int  VGetSignal      (const int idx, unsigned *value, const unsigned node);
+extern int  VWaitSignal     (const int idx, const unsigned value, const unsigned node);
+#endif
+
+// Internal functions called from VSched.c
+extern int  VSignalSchedOp  (const unsigned node);
+extern int  VSignalWaiting  (const unsigned node);
+
+#endif
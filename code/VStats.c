@@ -0,0 +1,338 @@
+//=====================================================================
+//
+// VStats.c                                           Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Per-node transaction statistics gathering, query and end of
+// simulation JSON reporting.
+//
+//=====================================================================
+
+#include <string.h>
+#include "VProc.h"
+#include "VUser.h"
+
+// Flag to indicate end of simulation reporting has been registered
+static int statsAtExitRegistered = 0;
+
+// -------------------------------------------------------------------------
+// VStatsAtExit()
+//
+// Called at process exit to dump statistics, if a file was
+// configured in the environment
+// -------------------------------------------------------------------------
+
+static void VStatsAtExit (void)
+{
+    char *fname = getenv(VSTATS_FILE_ENV);
+
+    if (fname != NULL && fname[0] != '\0')
+    {
+        VDumpStats(fname);
+    }
+}
+
+// -------------------------------------------------------------------------
+// VStatsHeat()
+//
+// Update the top-N address heatmap using the space-saving
+// algorithm, so that the table is bounded and the hottest
+// addresses are retained.
+// -------------------------------------------------------------------------
+
+static void VStatsHeat (VStats_t *s, uint32_t addr)
+{
+    unsigned idx, min_idx = 0;
+
+    addr >>= VP_STATS_ADDR_SHIFT;
+
+    for (idx = 0; idx < VP_STATS_HEAT_ENTRIES; idx++)
+    {
+        if (s->heat[idx].count && s->heat[idx].addr == addr)
+        {
+            s->heat[idx].count++;
+            return;
+        }
+
+        if (s->heat[idx].count < s->heat[min_idx].count)
+        {
+            min_idx = idx;
+        }
+    }
+
+    // Evict the least frequent entry, inheriting its count
+    s->heat[min_idx].addr = addr;
+    s->heat[min_idx].count++;
+}
+
+// -------------------------------------------------------------------------
+// VStatsPrintHist()
+//
+// Print a histogram as a JSON array, with trailing zero bins removed
+// -------------------------------------------------------------------------
+
+static void VStatsPrintHist (FILE *fp, const char *name, const uint64_t hist[])
+{
+    int last = VSTATS_HIST_BINS-1;
+
+    while (last > 0 && hist[last] == 0)
+    {
+        last--;
+    }
+
+    fprintf(fp, "      \"%s\": [", name);
+
+    for (int idx = 0; idx <= last; idx++)
+    {
+        fprintf(fp, "%s%llu", idx ? ", " : "", (unsigned long long)hist[idx]);
+    }
+
+    fprintf(fp, "]");
+}
+
+// -------------------------------------------------------------------------
+// VStatsCmpHeat()
+//
+// qsort comparison function to order heatmap entries by
+// descending count
+// -------------------------------------------------------------------------
+
+static int VStatsCmpHeat (const void *a, const void *b)
+{
+    uint64_t ca = ((const VStatsHeat_t *)a)->count;
+    uint64_t cb = ((const VStatsHeat_t *)b)->count;
+
+    return (ca < cb) ? 1 : (ca > cb) ? -1 : 0;
+}
+
+// =========================================================================
+// Internal functions
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VStatsInit()
+//
+// Initialise statistics for a node. Called from VInit()
+// -------------------------------------------------------------------------
+
+void VStatsInit (const unsigned node)
+{
+    memset(&ns[node]->stats, 0, sizeof(VStatsState_t));
+
+    if (!statsAtExitRegistered)
+    {
+        atexit(VStatsAtExit);
+        statsAtExitRegistered = 1;
+    }
+}
+
+// -------------------------------------------------------------------------
+// VStatsSchedIn()
+//
+// Called from VSched() just before releasing the user thread. Updates
+// the node's cycle count and completes the timing of any outstanding
+// bus transaction.
+// -------------------------------------------------------------------------
+
+void VStatsSchedIn (const unsigned node, const uint32_t cycle)
+{
+    VStatsState_t *st = &ns[node]->stats;
+
+    st->s.cycle    += (cycle - st->last_cycle) & VSTATS_CYCLE_MASK;
+    st->last_cycle  = cycle;
+
+    if (st->cmd_is_txn)
+    {
+        st->s.cycle_hist[VStatsLog2Bin(st->s.cycle - st->cmd_cycle)]++;
+        st->cmd_is_txn = 0;
+    }
+
+    st->post_ns     = VStatsNowNs();
+}
+
+// -------------------------------------------------------------------------
+// VStatsSchedOut()
+//
+// Called from VSched() when a new command has been received
+// from the user thread.
+// -------------------------------------------------------------------------
+
+void VStatsSchedOut (const unsigned node, const unsigned rw)
+{
+    VStatsState_t *st = &ns[node]->stats;
+
+    st->cmd_cycle  = st->s.cycle;
+    st->cmd_is_txn = (rw & (V_WRITE | V_READ)) ? 1 : 0;
+}
+
+// -------------------------------------------------------------------------
+// VStatsExchStart()
+//
+// Called from VExch() on entry, before handing off to the
+// simulation thread.
+// -------------------------------------------------------------------------
+
+void VStatsExchStart (const unsigned node, const unsigned addr, const unsigned rw, const int ticks)
+{
+    VStatsState_t *st   = &ns[node]->stats;
+    uint64_t       now  = VStatsNowNs();
+    rw_t          *p_rw = (rw_t *)&rw;
+
+    if (st->last_exch_ns)
+    {
+        st->s.user_ns += now - st->last_exch_ns;
+    }
+
+    st->last_exch_ns = now;
+    st->s.exchanges++;
+
+    if (p_rw->write || p_rw->read)
+    {
+        if (p_rw->burstlen)
+        {
+            if (p_rw->write) st->s.burst_writes++; else st->s.burst_reads++;
+            st->s.words += p_rw->burstlen;
+        }
+        else
+        {
+            if (p_rw->write) st->s.writes++; else st->s.reads++;
+            st->s.words++;
+        }
+
+        VStatsHeat(&st->s, addr);
+    }
+    else
+    {
+        st->s.ticks++;
+        st->s.tick_cycles += (ticks > 0 && ticks != GO_TO_SLEEP) ? ticks : 0;
+    }
+}
+
+// -------------------------------------------------------------------------
+// VStatsExchEnd()
+//
+// Called from VExch() when the user thread has been released
+// by the simulation thread.
+// -------------------------------------------------------------------------
+
+void VStatsExchEnd (const unsigned node)
+{
+    VStatsState_t *st  = &ns[node]->stats;
+    uint64_t       now = VStatsNowNs();
+
+    st->s.blocked_ns += now - st->last_exch_ns;
+
+    if (now >= st->post_ns)
+    {
+        st->s.handoff_hist[VStatsLog2Bin(now - st->post_ns)]++;
+    }
+
+    st->last_exch_ns  = now;
+}
+
+// =========================================================================
+// User API functions
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VGetStats()
+//
+// Return a snapshot of a node's statistics. Returns 0 on success,
+// or 1 if the node is not initialised.
+// -------------------------------------------------------------------------
+
+int VGetStats (const unsigned node, pVStats_t stats)
+{
+    if (node >= VP_MAX_NODES || ns[node] == NULL)
+    {
+        return 1;
+    }
+
+    *stats = ns[node]->stats.s;
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// VDumpStats()
+//
+// Write the statistics of all initialised nodes to a file in JSON
+// format. Returns 0 on success, or 1 if the file could not be opened.
+// -------------------------------------------------------------------------
+
+int VDumpStats (const char *fname)
+{
+    FILE     *fp;
+    VStats_t  s;
+    int       first = 1;
+
+    if ((fp = fopen(fname, "w")) == NULL)
+    {
+        VPrint("***Error: VDumpStats() failed to open %s for writing\n", fname);
+        return 1;
+    }
+
+    fprintf(fp, "{\n  \"version\": \"%s\",\n  \"nodes\": [\n", VERSION_STRING);
+
+    for (unsigned node = 0; node < VP_MAX_NODES; node++)
+    {
+        if (VGetStats(node, &s))
+        {
+            continue;
+        }
+
+        qsort(s.heat, VP_STATS_HEAT_ENTRIES, sizeof(VStatsHeat_t), VStatsCmpHeat);
+
+        fprintf(fp, "%s    {\n", first ? "" : ",\n");
+        fprintf(fp, "      \"node\": %u,\n",                node);
+        fprintf(fp, "      \"cycle\": %llu,\n",             (unsigned long long)s.cycle);
+        fprintf(fp, "      \"reads\": %llu,\n",             (unsigned long long)s.reads);
+        fprintf(fp, "      \"writes\": %llu,\n",            (unsigned long long)s.writes);
+        fprintf(fp, "      \"burst_reads\": %llu,\n",       (unsigned long long)s.burst_reads);
+        fprintf(fp, "      \"burst_writes\": %llu,\n",      (unsigned long long)s.burst_writes);
+        fprintf(fp, "      \"ticks\": %llu,\n",             (unsigned long long)s.ticks);
+        fprintf(fp, "      \"tick_cycles\": %llu,\n",       (unsigned long long)s.tick_cycles);
+        fprintf(fp, "      \"words\": %llu,\n",             (unsigned long long)s.words);
+        fprintf(fp, "      \"exchanges\": %llu,\n",         (unsigned long long)s.exchanges);
+        fprintf(fp, "      \"blocked_ns\": %llu,\n",        (unsigned long long)s.blocked_ns);
+        fprintf(fp, "      \"user_ns\": %llu,\n",           (unsigned long long)s.user_ns);
+
+        VStatsPrintHist(fp, "cycle_hist_log2",      s.cycle_hist);
+        fprintf(fp, ",\n");
+        VStatsPrintHist(fp, "handoff_hist_log2_ns", s.handoff_hist);
+        fprintf(fp, ",\n");
+
+        fprintf(fp, "      \"heatmap\": [");
+        for (int idx = 0; idx < VP_STATS_HEAT_ENTRIES && s.heat[idx].count; idx++)
+        {
+            fprintf(fp, "%s{\"addr\": \"0x%08x\", \"count\": %llu}", idx ? ", " : "",
+                        s.heat[idx].addr << VP_STATS_ADDR_SHIFT, (unsigned long long)s.heat[idx].count);
+        }
+        fprintf(fp, "]\n    }");
+
+        first = 0;
+    }
+
+    fprintf(fp, "\n  ]\n}\n");
+    fclose(fp);
+
+    return 0;
+}
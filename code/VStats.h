@@ -0,0 +1,125 @@
+//=====================================================================
+//
+// VStats.h                                           Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Per-node transaction statistics definitions. The counters are
+// always enabled and are updated from VExch() (user thread) and
+// VSched() (simulation thread), which are strictly serialised by
+// the node's semaphores, so no locking is required.
+//
+//=====================================================================
+
+#ifndef _VSTATS_H_
+#define _VSTATS_H_
+
+#include <stdint.h>
+#include <time.h>
+
+// Number of log2 bins in each of the histograms
+#define VSTATS_HIST_BINS        32
+
+// Number of entries in the top-N address heatmap
+#ifndef VP_STATS_HEAT_ENTRIES
+#define VP_STATS_HEAT_ENTRIES   16
+#endif
+
+// Address right shift applied before heatmap binning (0 for exact addresses)
+#ifndef VP_STATS_ADDR_SHIFT
+#define VP_STATS_ADDR_SHIFT     0
+#endif
+
+// Environment variable naming the JSON file to dump statistics to at
+// the end of simulation. If not set, no file is written.
+#define VSTATS_FILE_ENV         "VPROC_STATS_FILE"
+
+// Mask for the 31-bit cycle count passed in from the HDL
+#define VSTATS_CYCLE_MASK       0x7fffffffU
+
+// Address heatmap entry
+typedef struct {
+    uint32_t            addr;
+    uint64_t            count;
+} VStatsHeat_t;
+
+// Externally visible per-node statistics
+typedef struct {
+    uint64_t            reads;          // Single word reads
+    uint64_t            writes;         // Single word writes
+    uint64_t            burst_reads;    // Burst read transactions
+    uint64_t            burst_writes;   // Burst write transactions
+    uint64_t            ticks;          // VTick calls
+    uint64_t            tick_cycles;    // Total cycles requested by VTick calls
+    uint64_t            words;          // Words moved, in either direction
+    uint64_t            exchanges;      // Total user to simulation handoffs
+    uint64_t            cycle;          // Last sampled simulation clock cycle
+    uint64_t            blocked_ns;     // Wall clock time user thread was blocked in VExch
+    uint64_t            user_ns;        // Wall clock time spent running user code
+    uint64_t            cycle_hist   [VSTATS_HIST_BINS];  // log2(cycles) per bus transaction
+    uint64_t            handoff_hist [VSTATS_HIST_BINS];  // log2(ns) simulation to user wake latency
+    VStatsHeat_t        heat         [VP_STATS_HEAT_ENTRIES];
+} VStats_t, *pVStats_t;
+
+// Internal per-node statistics state
+typedef struct {
+    VStats_t            s;
+    uint64_t            last_exch_ns;   // Time user code last resumed
+    uint64_t            post_ns;        // Time simulation last released user thread
+    uint64_t            cmd_cycle;      // Cycle at which the outstanding command was issued
+    uint32_t            last_cycle;     // Last raw cycle value from the HDL
+    int                 cmd_is_txn;     // Outstanding command is a bus transaction
+} VStatsState_t;
+
+// -------------------------------------------------------------------------
+// Inline helper functions
+// -------------------------------------------------------------------------
+
+static inline uint64_t VStatsNowNs (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline unsigned VStatsLog2Bin (uint64_t val)
+{
+    unsigned bin = 0;
+
+    while (val > 1 && bin < VSTATS_HIST_BINS-1)
+    {
+        val >>= 1;
+        bin++;
+    }
+
+    return bin;
+}
+
+// -------------------------------------------------------------------------
+// Internal functions called from VSched.c and VUser.c
+// -------------------------------------------------------------------------
+
+extern void VStatsInit       (const unsigned node);
+extern void VStatsSchedIn    (const unsigned node, const uint32_t cycle);
+extern void VStatsSchedOut   (const unsigned node, const unsigned rw);
+extern void VStatsExchStart  (const unsigned node, const unsigned addr, const unsigned rw, const int ticks);
+extern void VStatsExchEnd    (const unsigned node);
+
+#endif
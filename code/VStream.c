@@ -0,0 +1,355 @@
+//=====================================================================
+//
+// VStream.c                                          Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// File streaming to and from a node's address space (see VStream.h).
+// Each stream has a ring of buffers passed between the node's user
+// thread and an I/O thread with a pair of counting semaphores. A
+// buffer with zero length marks the end of the stream.
+//
+//=====================================================================
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "VProc.h"
+#include "VUser.h"
+#include "VStream.h"
+
+#define VSTREAM_TO_ADDR         0
+#define VSTREAM_TO_FILE         1
+
+// Longest burst that can be issued
+#define VSTREAM_MAX_BURST       (MAXBURSTLEN - 1)
+
+typedef struct {
+    int                 fd;
+    int                 dir;
+    uint64_t            bytes;          // Bytes to transfer (0 for to end of file)
+    size_t              bufbytes;
+    uint32_t           *buf[VP_STREAM_BUFFERS];
+    size_t              len[VP_STREAM_BUFFERS];
+    sem_t               full;           // Buffers ready for the consumer
+    sem_t               empty;          // Buffers free for the producer
+    int                 error;          // errno of any I/O thread failure
+} VStream_t;
+
+static VStreamStats_t   streamStats[VP_MAX_NODES];
+
+// -------------------------------------------------------------------------
+// VStreamIoThread()
+//
+// Fills buffers from the file, or writes filled buffers to the
+// file, until the end of the stream
+// -------------------------------------------------------------------------
+
+static void *VStreamIoThread (void *arg)
+{
+    VStream_t *s    = (VStream_t *)arg;
+    uint64_t   done = 0;
+    unsigned   idx  = 0;
+
+    for (;;)
+    {
+        ssize_t n   = 0;
+        size_t  len = 0;
+
+        if (s->dir == VSTREAM_TO_ADDR)
+        {
+            size_t want = s->bufbytes;
+
+            if (s->bytes && s->bytes - done < want)
+            {
+                want = s->bytes - done;
+            }
+
+            sem_wait(&s->empty);
+
+            while (len < want && (n = read(s->fd, (char *)s->buf[idx] + len, want - len)) > 0)
+            {
+                len += n;
+            }
+
+            if (n < 0)
+            {
+                s->error = errno;
+            }
+
+            s->len[idx] = len;
+            done       += len;
+
+            sem_post(&s->full);
+        }
+        else
+        {
+            sem_wait(&s->full);
+
+            while (len < s->len[idx] && (n = write(s->fd, (char *)s->buf[idx] + len, s->len[idx] - len)) > 0)
+            {
+                len += n;
+            }
+
+            if (n < 0)
+            {
+                s->error = errno;
+            }
+
+            sem_post(&s->empty);
+        }
+
+        // A zero length buffer ends the stream
+        if (len == 0 && (s->dir == VSTREAM_TO_ADDR || s->len[idx] == 0))
+        {
+            break;
+        }
+
+        idx = (idx + 1) % VP_STREAM_BUFFERS;
+    }
+
+    return NULL;
+}
+
+// -------------------------------------------------------------------------
+// VStreamWait()
+//
+// Wait on a semaphore, counting a stall if it has to block
+// -------------------------------------------------------------------------
+
+static void VStreamWait (sem_t *sem, const unsigned node)
+{
+    if (sem_trywait(sem) != 0)
+    {
+        streamStats[node].stalls++;
+        sem_wait(sem);
+    }
+}
+
+// -------------------------------------------------------------------------
+// VStreamBursts()
+//
+// Issue the bursts for one buffer, updating the address
+// -------------------------------------------------------------------------
+
+static void VStreamBursts (VStream_t *s, const unsigned idx, unsigned *addr, const unsigned addr_incr,
+                           const unsigned burst_words, const unsigned node)
+{
+    uint32_t *p     = s->buf[idx];
+    size_t    len   = s->len[idx];
+    unsigned  words = (unsigned)((len + 3) / 4);
+    unsigned  tail  = len & 3;
+
+    if (s->dir == VSTREAM_TO_ADDR && tail)
+    {
+        memset((char *)p + len, 0, 4 - tail);
+    }
+
+    for (unsigned off = 0; off < words; off += burst_words)
+    {
+        unsigned blen = (words - off) < burst_words ? (words - off) : burst_words;
+
+        if (s->dir == VSTREAM_TO_FILE)
+        {
+            VBurstRead(*addr, p + off, blen, node);
+        }
+        else if (tail && off + blen == words)
+        {
+            unsigned lbe = (1 << tail) - 1;
+
+            VBurstWriteBE(*addr, p + off, blen, blen == 1 ? lbe : 0xf, lbe, node);
+        }
+        else
+        {
+            VBurstWrite(*addr, p + off, blen, node);
+        }
+
+        *addr += blen * addr_incr;
+        streamStats[node].bursts++;
+    }
+
+    streamStats[node].bytes += len;
+}
+
+// -------------------------------------------------------------------------
+// VStreamRun()
+//
+// Open the file, start the I/O thread and issue the bursts for each
+// buffer as it becomes available
+// -------------------------------------------------------------------------
+
+static int64_t VStreamRun (const int dir, const char *fname, unsigned addr, const unsigned addr_incr,
+                           const uint64_t bytes, unsigned burst_words, const unsigned node)
+{
+    VStream_t s;
+    pthread_t thread;
+    unsigned  idx       = 0;
+    uint64_t  remaining = bytes;
+    int       status    = 0;
+
+    memset(&streamStats[node], 0, sizeof(VStreamStats_t));
+    memset(&s, 0, sizeof(VStream_t));
+
+    if (burst_words == 0 || burst_words > VSTREAM_MAX_BURST)
+    {
+        burst_words = VSTREAM_MAX_BURST;
+    }
+
+    s.dir      = dir;
+    s.bytes    = bytes;
+    s.bufbytes = (size_t)(VP_STREAM_BUF_WORDS > burst_words ? VP_STREAM_BUF_WORDS / burst_words : 1) * burst_words * 4;
+
+    if (dir == VSTREAM_TO_ADDR)
+    {
+        s.fd = open(fname, O_RDONLY);
+    }
+    else
+    {
+        s.fd = open(fname, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+
+    if (s.fd < 0)
+    {
+        VPrint("***Error: VStream failed to open %s (%s)\n", fname, strerror(errno));
+        return -1;
+    }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(s.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    for (idx = 0; idx < VP_STREAM_BUFFERS; idx++)
+    {
+        if ((s.buf[idx] = (uint32_t *)malloc(s.bufbytes)) == NULL)
+        {
+            VPrint("***Error: VStream failed to allocate %zu byte buffer\n", s.bufbytes);
+            exit(1);
+        }
+    }
+
+    sem_init(&s.full,  0, 0);
+    sem_init(&s.empty, 0, VP_STREAM_BUFFERS);
+
+    if (pthread_create(&thread, NULL, VStreamIoThread, (void *)&s) != 0)
+    {
+        VPrint("***Error: VStream failed to create I/O thread\n");
+        exit(1);
+    }
+
+    for (idx = 0; ; idx = (idx + 1) % VP_STREAM_BUFFERS)
+    {
+        if (dir == VSTREAM_TO_ADDR)
+        {
+            VStreamWait(&s.full, node);
+
+            if (s.len[idx] == 0)
+            {
+                break;
+            }
+
+            VStreamBursts(&s, idx, &addr, addr_incr, burst_words, node);
+
+            sem_post(&s.empty);
+        }
+        else
+        {
+            VStreamWait(&s.empty, node);
+
+            s.len[idx] = remaining < s.bufbytes ? (size_t)remaining : s.bufbytes;
+
+            if (s.len[idx])
+            {
+                VStreamBursts(&s, idx, &addr, addr_incr, burst_words, node);
+                remaining -= s.len[idx];
+            }
+
+            sem_post(&s.full);
+
+            if (s.len[idx] == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    pthread_join(thread, NULL);
+
+    if (s.error)
+    {
+        VPrint("***Error: VStream I/O error on %s (%s)\n", fname, strerror(s.error));
+        status = -1;
+    }
+
+    if (close(s.fd) != 0 && status == 0)
+    {
+        VPrint("***Error: VStream failed to close %s (%s)\n", fname, strerror(errno));
+        status = -1;
+    }
+
+    for (idx = 0; idx < VP_STREAM_BUFFERS; idx++)
+    {
+        free(s.buf[idx]);
+    }
+
+    sem_destroy(&s.full);
+    sem_destroy(&s.empty);
+
+    return status ? -1 : (int64_t)streamStats[node].bytes;
+}
+
+// =========================================================================
+// User API
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VStreamFileToAddr()
+//
+// Stream a file into the node's address space
+// -------------------------------------------------------------------------
+
+int64_t VStreamFileToAddr (const char *fname, const unsigned addr, const unsigned addr_incr,
+                           const uint64_t bytes, const unsigned burst_words, const unsigned node)
+{
+    return VStreamRun(VSTREAM_TO_ADDR, fname, addr, addr_incr, bytes, burst_words, node);
+}
+
+// -------------------------------------------------------------------------
+// VStreamAddrToFile()
+//
+// Stream from the node's address space into a file
+// -------------------------------------------------------------------------
+
+int64_t VStreamAddrToFile (const char *fname, const unsigned addr, const unsigned addr_incr,
+                           const uint64_t bytes, const unsigned burst_words, const unsigned node)
+{
+    return VStreamRun(VSTREAM_TO_FILE, fname, addr, addr_incr, bytes, burst_words, node);
+}
+
+// -------------------------------------------------------------------------
+// VStreamGetStats()
+//
+// Get the statistics of the last stream on a node
+// -------------------------------------------------------------------------
+
+void VStreamGetStats (VStreamStats_t *stats, const unsigned node)
+{
+    *stats = streamStats[node];
+}
@@ -0,0 +1,73 @@
+//=====================================================================
+//
+// VStream.h                                          Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Streaming of files to and from the address space of a node with
+// burst transactions. File reads and writes are done by an I/O
+// thread a ring of buffers ahead of (or behind) the node's bursts,
+// which are issued directly from and to the ring buffers, so that
+// the node does not wait on the disk while its buffers keep up.
+//
+//=====================================================================
+
+#ifndef _VSTREAM_H_
+#define _VSTREAM_H_
+
+#include <stdint.h>
+
+// Number of buffers in a stream's ring
+#ifndef VP_STREAM_BUFFERS
+#define VP_STREAM_BUFFERS       4
+#endif
+
+// Nominal size of each buffer in 32-bit words (rounded down to a
+// whole number of bursts)
+#ifndef VP_STREAM_BUF_WORDS
+#define VP_STREAM_BUF_WORDS     65536
+#endif
+
+// Stream statistics, for the last stream completed on a node
+typedef struct {
+    uint64_t            bytes;          // Bytes transferred
+    uint64_t            bursts;         // Bursts issued
+    uint64_t            stalls;         // Times the node waited for the I/O thread
+} VStreamStats_t;
+
+// Stream bytes bytes (or the whole file if 0) from fname into the
+// address space, in bursts of burst_words words, starting at addr
+// and incrementing by addr_incr for each word (the HDL's
+// BURST_ADDR_INCR, or 0 for a fixed address such as a FIFO). A
+// partial last word is written with byte enables. Returns the number
+// of bytes streamed, or -1 on error.
+extern int64_t VStreamFileToAddr (const char *fname, const unsigned addr, const unsigned addr_incr,
+                                  const uint64_t bytes, const unsigned burst_words, const unsigned node);
+
+// Stream bytes bytes from the address space into file fname, with
+// the same addressing. Returns the number of bytes streamed, or -1
+// on error.
+extern int64_t VStreamAddrToFile (const char *fname, const unsigned addr, const unsigned addr_incr,
+                                  const uint64_t bytes, const unsigned burst_words, const unsigned node);
+
+// Get the statistics of the last stream on a node
+extern void    VStreamGetStats   (VStreamStats_t *stats, const unsigned node);
+
+#endif
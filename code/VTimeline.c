@@ -0,0 +1,259 @@
+//=====================================================================
+//
+// VTimeline.c                                        Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Wall clock timeline recording. Spans are kept in memory in a
+// buffer per thread (the simulator thread, and one per node's user
+// thread), each written only by its own thread, and are written
+// to the file named in VPROC_TIMELINE_FILE at exit.
+//
+//=====================================================================
+
+#include <string.h>
+#include "VProc.h"
+#include "VUser.h"
+
+// Per-thread span buffer
+typedef struct {
+    VTimelineSpan_t*    spans;
+    uint32_t            num;
+    uint32_t            size;
+    uint64_t            dropped;
+    uint64_t            last_ns;        // End of last VProc call (start of HDL or user code)
+} VTimelineBuf_t;
+
+// Global timeline enable flag
+int                  VTimelineEnabled = 0;
+
+static int           timelineInitialised = 0;
+static uint64_t      timelineStartNs;
+static VTimelineBuf_t timelineBuf[VP_MAX_NODES+1];
+
+// -------------------------------------------------------------------------
+// VTimelineExchName()
+//
+// Return a span name for a VExch() call, based on the command type
+// -------------------------------------------------------------------------
+
+static const char* VTimelineExchName (const unsigned rw)
+{
+    rw_t *p_rw = (rw_t *)&rw;
+
+    if (p_rw->write)
+    {
+        return p_rw->burstlen ? "VExch burst write" : "VExch write";
+    }
+    else if (p_rw->read)
+    {
+        return p_rw->burstlen ? "VExch burst read" : "VExch read";
+    }
+
+    return "VExch tick";
+}
+
+// -------------------------------------------------------------------------
+// VTimelineAtExit()
+//
+// Write all recorded spans to the timeline file in Chrome trace
+// event JSON format, with timestamps in microseconds.
+// -------------------------------------------------------------------------
+
+static void VTimelineAtExit (void)
+{
+    char *fname = getenv(VTIMELINE_FILE_ENV);
+    FILE *fp;
+
+    VTimelineEnabled = 0;
+
+    if ((fp = fopen(fname, "w")) == NULL)
+    {
+        VPrint("***Error: VTimelineAtExit() failed to open %s for writing\n", fname);
+        return;
+    }
+
+    fprintf(fp, "{\n\"displayTimeUnit\": \"ns\",\n\"otherData\": {\"version\": \"%s\"},\n\"traceEvents\": [\n", VERSION_STRING);
+    fprintf(fp, "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, \"args\": {\"name\": \"VProc\"}}");
+
+    for (unsigned tid = 0; tid <= VP_MAX_NODES; tid++)
+    {
+        VTimelineBuf_t *buf = &timelineBuf[tid];
+
+        if (buf->num == 0)
+        {
+            continue;
+        }
+
+        if (tid == VTIMELINE_SIM_TID)
+        {
+            fprintf(fp, ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, \"args\": {\"name\": \"simulator\"}}");
+        }
+        else
+        {
+            fprintf(fp, ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, \"args\": {\"name\": \"node %u user\"}}", tid, tid-1);
+        }
+
+        for (uint32_t idx = 0; idx < buf->num; idx++)
+        {
+            VTimelineSpan_t *sp = &buf->spans[idx];
+
+            fprintf(fp, ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f, \"args\": {\"node\": %u}}",
+                        sp->name, tid,
+                        (double)(sp->start_ns - timelineStartNs) / 1000.0,
+                        (double)(sp->end_ns   - sp->start_ns)    / 1000.0,
+                        sp->node);
+        }
+
+        if (buf->dropped)
+        {
+            VPrint("VTimeline: %llu spans dropped on thread %u\n", (unsigned long long)buf->dropped, tid);
+        }
+    }
+
+    fprintf(fp, "\n]\n}\n");
+    fclose(fp);
+}
+
+// =========================================================================
+// Internal functions
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VTimelineInit()
+//
+// Called from VInit() for each node. Enables timeline recording on
+// the first call if configured in the environment.
+// -------------------------------------------------------------------------
+
+void VTimelineInit (const unsigned node)
+{
+    char *fname;
+
+    if (timelineInitialised)
+    {
+        return;
+    }
+
+    timelineInitialised = 1;
+    fname               = getenv(VTIMELINE_FILE_ENV);
+
+    if (fname != NULL && fname[0] != '\0')
+    {
+        timelineStartNs  = VStatsNowNs();
+        atexit(VTimelineAtExit);
+        VTimelineEnabled = 1;
+    }
+}
+
+// -------------------------------------------------------------------------
+// VTimelineSpan()
+//
+// Record a completed span on a thread's buffer
+// -------------------------------------------------------------------------
+
+void VTimelineSpan (const unsigned tid, const char* name, const unsigned node, const uint64_t start_ns, const uint64_t end_ns)
+{
+    VTimelineBuf_t  *buf = &timelineBuf[tid];
+    VTimelineSpan_t *sp;
+
+    if (buf->num == buf->size)
+    {
+        uint32_t newsize = buf->size ? buf->size * 2 : 4096;
+
+        if (newsize > VP_TIMELINE_MAX_SPANS ||
+            (sp = (VTimelineSpan_t *) realloc(buf->spans, newsize * sizeof(VTimelineSpan_t))) == NULL)
+        {
+            buf->dropped++;
+            return;
+        }
+
+        buf->spans = sp;
+        buf->size  = newsize;
+    }
+
+    sp           = &buf->spans[buf->num++];
+    sp->name     = name;
+    sp->node     = node;
+    sp->start_ns = start_ns;
+    sp->end_ns   = end_ns;
+}
+
+// -------------------------------------------------------------------------
+// VTimelineSimEntry()
+//
+// Called on entry to a VProc function from the simulator, to record
+// the time spent in the simulator since the last VProc call returned
+// -------------------------------------------------------------------------
+
+void VTimelineSimEntry (const uint64_t now_ns)
+{
+    VTimelineBuf_t *buf = &timelineBuf[VTIMELINE_SIM_TID];
+
+    if (buf->last_ns)
+    {
+        VTimelineSpan(VTIMELINE_SIM_TID, "HDL", 0, buf->last_ns, now_ns);
+    }
+}
+
+// -------------------------------------------------------------------------
+// VTimelineSimExit()
+//
+// Called when returning from a VProc function to the simulator
+// -------------------------------------------------------------------------
+
+void VTimelineSimExit (void)
+{
+    timelineBuf[VTIMELINE_SIM_TID].last_ns = VStatsNowNs();
+}
+
+// -------------------------------------------------------------------------
+// VTimelineExchStart()
+//
+// Called on entry to VExch(), recording the user code span since
+// the previous exchange completed
+// -------------------------------------------------------------------------
+
+void VTimelineExchStart (const unsigned node, const unsigned rw, const uint64_t now_ns)
+{
+    VTimelineBuf_t *buf = &timelineBuf[node+1];
+
+    if (buf->last_ns)
+    {
+        VTimelineSpan(node+1, "user", node, buf->last_ns, now_ns);
+    }
+}
+
+// -------------------------------------------------------------------------
+// VTimelineExchEnd()
+//
+// Called when VExch() is about to return to user code, recording
+// the time the user thread was blocked
+// -------------------------------------------------------------------------
+
+void VTimelineExchEnd (const unsigned node, const unsigned rw, const uint64_t start_ns)
+{
+    VTimelineBuf_t *buf = &timelineBuf[node+1];
+    uint64_t        now = VStatsNowNs();
+
+    VTimelineSpan(node+1, VTimelineExchName(rw), node, start_ns, now);
+
+    buf->last_ns = now;
+}
@@ -0,0 +1,73 @@
+//=====================================================================
+//
+// VTimeline.h                                        Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Wall clock timeline of simulator thread and user thread activity,
+// written at the end of simulation in Chrome trace event JSON format
+// (viewable in Perfetto or chrome://tracing).
+//
+//=====================================================================
+
+#ifndef _VTIMELINE_H_
+#define _VTIMELINE_H_
+
+#include <stdint.h>
+
+// Environment variable naming the timeline output file. Timeline
+// recording is disabled if not set.
+#define VTIMELINE_FILE_ENV      "VPROC_TIMELINE_FILE"
+
+// Maximum number of spans recorded per thread. Later spans are
+// counted but discarded.
+#ifndef VP_TIMELINE_MAX_SPANS
+#define VP_TIMELINE_MAX_SPANS   (1 << 20)
+#endif
+
+// Thread ID of the simulator thread. User threads are node+1.
+#define VTIMELINE_SIM_TID       0
+
+// Timeline span
+typedef struct {
+    const char*         name;
+    uint32_t            node;
+    uint64_t            start_ns;
+    uint64_t            end_ns;
+} VTimelineSpan_t;
+
+// Global timeline enable flag, checked in the hot path
+extern int VTimelineEnabled;
+
+// Mark start of a span, declaring a variable to hold the start time
+#define VTL_START(_t)                    uint64_t _t = VTimelineEnabled ? VStatsNowNs() : 0
+
+// Complete a span started with VTL_START()
+#define VTL_END(_tid, _name, _node, _t)  if (VTimelineEnabled) VTimelineSpan(_tid, _name, _node, _t, VStatsNowNs())
+
+// Internal functions called from VSched.c and VUser.c
+extern void VTimelineInit      (const unsigned node);
+extern void VTimelineSpan      (const unsigned tid, const char* name, const unsigned node, const uint64_t start_ns, const uint64_t end_ns);
+extern void VTimelineSimEntry  (const uint64_t now_ns);
+extern void VTimelineSimExit   (void);
+extern void VTimelineExchStart (const unsigned node, const unsigned rw, const uint64_t now_ns);
+extern void VTimelineExchEnd   (const unsigned node, const unsigned rw, const uint64_t start_ns);
+
+#endif
@@ -0,0 +1,302 @@
+//=====================================================================
+//
+// VTrace.c                                           Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Binary per-node transaction trace. Records are built on the
+// simulation thread in VSched() and pushed to a per-node lock-free
+// ring. A background thread spills the rings to the file named in
+// VPROC_TRACE_FILE. Use tools/vptrace.py to convert the file to CSV
+// or to a VCD transaction stream.
+//
+//=====================================================================
+
+#include <string.h>
+#include <sched.h>
+#include "VProc.h"
+#include "VUser.h"
+
+// Writer thread idle poll period
+#define VTRACE_POLL_NS          1000000
+
+// Global trace enable flag
+int              VTraceEnabled = 0;
+
+// Trace file state
+static int       traceInitialised = 0;
+static FILE     *traceFp;
+static pthread_t traceThread;
+static int       traceStop = 0;
+static uint64_t  traceStartNs;
+
+// -------------------------------------------------------------------------
+// VTraceDrain()
+//
+// Write out any records in the node rings. Returns the number of
+// records written. Called on the writer thread only.
+// -------------------------------------------------------------------------
+
+static int VTraceDrain (void)
+{
+    int count = 0;
+
+    for (int node = 0; node < VP_MAX_NODES; node++)
+    {
+        VTraceState_t *tr;
+        uint32_t       rd, wr, len;
+
+        if (ns[node] == NULL || (tr = ns[node]->trace) == NULL)
+        {
+            continue;
+        }
+
+        rd = tr->rd;
+        wr = __atomic_load_n(&tr->wr, __ATOMIC_ACQUIRE);
+
+        while (rd != wr)
+        {
+            // Write contiguous records up to the end of the ring buffer
+            len  = wr - rd;
+            if ((rd & VTRACE_RING_MASK) + len > VP_TRACE_RING_SIZE)
+            {
+                len = VP_TRACE_RING_SIZE - (rd & VTRACE_RING_MASK);
+            }
+
+            fwrite(&tr->ring[rd & VTRACE_RING_MASK], sizeof(VTraceRec_t), len, traceFp);
+
+            rd    += len;
+            count += len;
+            __atomic_store_n(&tr->rd, rd, __ATOMIC_RELEASE);
+        }
+    }
+
+    return count;
+}
+
+// -------------------------------------------------------------------------
+// VTraceWriter()
+//
+// Background thread spilling the trace rings to file
+// -------------------------------------------------------------------------
+
+static void *VTraceWriter (void *arg)
+{
+    struct timespec ts = {0, VTRACE_POLL_NS};
+
+    while (!__atomic_load_n(&traceStop, __ATOMIC_ACQUIRE))
+    {
+        if (VTraceDrain() == 0)
+        {
+            nanosleep(&ts, NULL);
+        }
+    }
+
+    // Final drain after stop requested
+    VTraceDrain();
+
+    return NULL;
+}
+
+// -------------------------------------------------------------------------
+// VTracePush()
+//
+// Push a record onto a node's ring. If the ring is full, waits for
+// the writer thread so that no records are lost.
+// -------------------------------------------------------------------------
+
+static void VTracePush (VTraceState_t *tr, const VTraceRec_t *rec)
+{
+    uint32_t wr = tr->wr;
+
+    while ((wr - __atomic_load_n(&tr->rd, __ATOMIC_ACQUIRE)) >= VP_TRACE_RING_SIZE)
+    {
+        sched_yield();
+    }
+
+    tr->ring[wr & VTRACE_RING_MASK] = *rec;
+
+    __atomic_store_n(&tr->wr, wr + 1, __ATOMIC_RELEASE);
+}
+
+// -------------------------------------------------------------------------
+// VTraceAtExit()
+//
+// Flush outstanding commands, stop the writer thread and close
+// the trace file.
+// -------------------------------------------------------------------------
+
+static void VTraceAtExit (void)
+{
+    for (int node = 0; node < VP_MAX_NODES; node++)
+    {
+        VTraceState_t *tr;
+
+        if (ns[node] != NULL && (tr = ns[node]->trace) != NULL && tr->pending_valid)
+        {
+            tr->pending.duration = (uint32_t)(ns[node]->stats.s.cycle - tr->pending.cycle);
+            tr->pending_valid    = 0;
+            VTracePush(tr, &tr->pending);
+        }
+    }
+
+    __atomic_store_n(&traceStop, 1, __ATOMIC_RELEASE);
+    pthread_join(traceThread, NULL);
+
+    fclose(traceFp);
+    VTraceEnabled = 0;
+}
+
+// =========================================================================
+// Internal functions
+// =========================================================================
+
+// -------------------------------------------------------------------------
+// VTraceInit()
+//
+// Called from VInit() for each node. On first call, opens the trace
+// file and starts the writer thread if tracing is configured.
+// -------------------------------------------------------------------------
+
+void VTraceInit (const unsigned node)
+{
+    if (!traceInitialised)
+    {
+        char        *fname = getenv(VTRACE_FILE_ENV);
+        VTraceHdr_t  hdr;
+
+        traceInitialised = 1;
+
+        if (fname == NULL || fname[0] == '\0')
+        {
+            return;
+        }
+
+        if ((traceFp = fopen(fname, "wb")) == NULL)
+        {
+            VPrint("***Error: VTraceInit() failed to open %s for writing\n", fname);
+            return;
+        }
+
+        memset(&hdr, 0, sizeof(hdr));
+        memcpy(hdr.magic, VTRACE_MAGIC, strlen(VTRACE_MAGIC));
+        hdr.version  = VTRACE_VERSION;
+        hdr.rec_size = sizeof(VTraceRec_t);
+        fwrite(&hdr, sizeof(hdr), 1, traceFp);
+
+        traceStartNs = VStatsNowNs();
+
+        if (pthread_create(&traceThread, NULL, VTraceWriter, NULL))
+        {
+            VPrint("***Error: VTraceInit() failed to create writer thread\n");
+            fclose(traceFp);
+            return;
+        }
+
+        atexit(VTraceAtExit);
+        VTraceEnabled = 1;
+    }
+
+    if (VTraceEnabled)
+    {
+        ns[node]->trace = (VTraceState_t *) calloc(1, sizeof(VTraceState_t));
+    }
+}
+
+// -------------------------------------------------------------------------
+// VTraceSchedIn()
+//
+// Called from VSched() on entry, after the statistics cycle count
+// has been updated. Completes and pushes the outstanding command's
+// record.
+// -------------------------------------------------------------------------
+
+void VTraceSchedIn (const unsigned node, const uint32_t data_in)
+{
+    VTraceState_t *tr = ns[node]->trace;
+
+    if (tr == NULL || !tr->pending_valid)
+    {
+        return;
+    }
+
+    tr->pending.duration = (uint32_t)(ns[node]->stats.s.cycle - tr->pending.cycle);
+
+    if (tr->pending.op == VTRACE_OP_READ)
+    {
+        tr->pending.data = data_in;
+    }
+
+    tr->pending_valid = 0;
+
+    VTracePush(tr, &tr->pending);
+}
+
+// -------------------------------------------------------------------------
+// VTraceSchedOut()
+//
+// Called from VSched() when a new command has been received from
+// the user thread, to start a new record.
+// -------------------------------------------------------------------------
+
+void VTraceSchedOut (const unsigned node)
+{
+    VTraceState_t *tr   = ns[node]->trace;
+    psend_buf_t    sbuf = &ns[node]->send_buf;
+    rw_t          *p_rw = (rw_t *)&sbuf->rw;
+    VTraceRec_t   *rec;
+
+    if (tr == NULL)
+    {
+        return;
+    }
+
+    rec           = &tr->pending;
+    rec->cycle    = ns[node]->stats.s.cycle;
+    rec->wall_ns  = VStatsNowNs() - traceStartNs;
+    rec->node     = (uint8_t)node;
+    rec->be       = (uint8_t)p_rw->fbe;
+    rec->duration = 0;
+    rec->rsvd     = 0;
+
+    if (p_rw->write || p_rw->read)
+    {
+        rec->addr = sbuf->addr;
+
+        if (p_rw->burstlen)
+        {
+            rec->op   = p_rw->write ? VTRACE_OP_BURST_WRITE : VTRACE_OP_BURST_READ;
+            rec->data = p_rw->burstlen;
+        }
+        else
+        {
+            rec->op   = p_rw->write ? VTRACE_OP_WRITE : VTRACE_OP_READ;
+            rec->data = sbuf->data_out;
+        }
+    }
+    else
+    {
+        rec->op   = VTRACE_OP_TICK;
+        rec->addr = 0;
+        rec->data = (uint32_t)sbuf->ticks;
+    }
+
+    tr->pending_valid = 1;
+}
@@ -0,0 +1,95 @@
+//=====================================================================
+//
+// VTrace.h                                           Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Binary transaction trace definitions. Each node has a lock-free
+// single producer/single consumer ring of fixed size records,
+// filled from VSched() on the simulation thread and drained to a
+// file by a background writer thread.
+//
+//=====================================================================
+
+#ifndef _VTRACE_H_
+#define _VTRACE_H_
+
+#include <stdint.h>
+
+// Environment variable naming the trace output file. Tracing is
+// disabled if not set.
+#define VTRACE_FILE_ENV         "VPROC_TRACE_FILE"
+
+// File header magic and format version
+#define VTRACE_MAGIC            "VPTRACE"
+#define VTRACE_VERSION          1
+
+// Number of records in each node's ring (must be a power of 2)
+#ifndef VP_TRACE_RING_SIZE
+#define VP_TRACE_RING_SIZE      4096
+#endif
+
+#define VTRACE_RING_MASK        (VP_TRACE_RING_SIZE - 1)
+
+// Trace record operation types
+#define VTRACE_OP_TICK          0
+#define VTRACE_OP_WRITE         1
+#define VTRACE_OP_READ          2
+#define VTRACE_OP_BURST_WRITE   3
+#define VTRACE_OP_BURST_READ    4
+
+// File header (16 bytes)
+typedef struct {
+    char                magic[8];
+    uint32_t            version;
+    uint32_t            rec_size;
+} VTraceHdr_t;
+
+// Trace record (32 bytes, little endian in file)
+typedef struct {
+    uint64_t            cycle;          // Simulation cycle when command was issued
+    uint64_t            wall_ns;        // Wall clock ns from start of trace when issued
+    uint32_t            addr;           // Address (0 for ticks)
+    uint32_t            data;           // Write or read data, burst length or tick count
+    uint32_t            duration;       // Cycles taken to complete
+    uint8_t             op;             // VTRACE_OP_xxx
+    uint8_t             be;             // Byte enables (first BE for bursts)
+    uint8_t             node;           // Node number
+    uint8_t             rsvd;
+} VTraceRec_t;
+
+// Internal per-node trace state
+typedef struct {
+    VTraceRec_t         ring[VP_TRACE_RING_SIZE];
+    uint32_t            wr;             // Written by simulation thread only
+    uint32_t            rd;             // Written by writer thread only
+    VTraceRec_t         pending;        // Outstanding command's record
+    int                 pending_valid;
+} VTraceState_t;
+
+// Global trace enable flag, checked in the hot path
+extern int VTraceEnabled;
+
+// Internal functions called from VSched.c
+extern void VTraceInit     (const unsigned node);
+extern void VTraceSchedIn  (const unsigned node, const uint32_t data_in);
+extern void VTraceSchedOut (const unsigned node);
+
+#endif
@@ -29,6 +29,7 @@
 #include <errno.h>
 #include "VProc.h"
 #include "VUser.h"
+#include "VRestart.h"
 
 // Forward declaration
 static void VUserInit (const unsigned node);
@@ -88,7 +89,7 @@ static void VUserInit (const unsigned node)
 
     // Get function pointer of user entry routine
     sprintf(funcname, "%s%d",    "VUserMain", node);
-    if ((VUserMain_func = (pVUserMain_t) dlsym(RTLD_DEFAULT, funcname)) == NULL)
+    if ((VUserMain_func = (pVUserMain_t) dlsym(RTLD_DEFAULT, funcname)) == NULL && !VRestartListed(node))
     {
 #ifndef VERILATOR
         // If the lookup failed, try loading the shared object immediately
@@ -117,10 +118,10 @@ static void VUserInit (const unsigned node)
 
     debug_io_printf("VUserInit(): calling user code for node %d\n", node);
 
-    // Call user program
+    // Call user program, and any restarts
     debug_io_printf("VUserInit(): calling VUserMain%d\n", node);
 
-    VUserMain_func(node);
+    VRestartRun(node, VUserMain_func);
 }
 
 // -------------------------------------------------------------------------
@@ -135,23 +136,60 @@ static void VUserInit (const unsigned node)
 static void VExch (const psend_buf_t psbuf, prcv_buf_t prbuf, const unsigned node)
 {
     int status;
+
+    VTL_START(tl_exch);
+
+    if (VTimelineEnabled)
+    {
+        VTimelineExchStart(node, psbuf->rw, tl_exch);
+    }
+
+    VStatsExchStart(node, psbuf->addr, psbuf->rw, psbuf->ticks);
+    VPROBE_TXN_ISSUE(node, psbuf->rw, psbuf->addr);
+
+    if (VLiveSeg != NULL)
+    {
+        VLiveExchStart(node, psbuf->addr, psbuf->rw, psbuf->ticks);
+    }
+
     // Send message to simulator
     ns[node]->send_buf = *psbuf;
 
-    debug_io_printf("VExch(): setting snd[%d] semaphore\n", node);
-
-    if ((status = sem_post(&(ns[node]->snd))) == -1)
+    if (ns[node]->remote != NULL)
     {
-        VPrint("***Error: bad sem_post status (%d) on node %d (VExch)\n", status, node);
-        exit(1);
+        // User code in a separate process from the simulator
+        VRemoteClientExch(node);
     }
+    else
+    {
+        debug_io_printf("VExch(): setting snd[%d] semaphore\n", node);
+
+        if ((status = sem_post(&(ns[node]->snd))) == -1)
+        {
+            VPrint("***Error: bad sem_post status (%d) on node %d (VExch)\n", status, node);
+            exit(1);
+        }
 
-    // Wait for response message from simulator
-    debug_io_printf("VExch(): waiting for rcv[%d] semaphore\n", node);
-    sem_wait(&(ns[node]->rcv));
+        // Wait for response message from simulator
+        debug_io_printf("VExch(): waiting for rcv[%d] semaphore\n", node);
+        sem_wait(&(ns[node]->rcv));
+    }
+
+    VStatsExchEnd(node);
+    VPROBE_TXN_COMPLETE(node, psbuf->rw, psbuf->addr);
+
+    if (VLiveSeg != NULL)
+    {
+        VLiveExchEnd(node);
+    }
 
     *prbuf = ns[node]->rcv_buf;
 
+    if (VTimelineEnabled)
+    {
+        VTimelineExchEnd(node, psbuf->rw, tl_exch);
+    }
+
     debug_io_printf("VExch(): returning to user code from node %d\n", node);
 
 }
@@ -328,6 +366,115 @@ int VTick (const unsigned ticks, const unsigned node)
     return 0;
 }
 
+// -------------------------------------------------------------------------
+// VReset()
+//
+// Invokes a tick message exchange with the HDL reset output
+// asserted, which is deasserted by the next message
+// -------------------------------------------------------------------------
+
+int VReset (const unsigned ticks, const unsigned node)
+{
+    rcv_buf_t  rbuf;
+    send_buf_t sbuf;
+    rw_t*      p_rw = (rw_t*)&sbuf.rw;
+
+    sbuf.addr      = 0;
+    sbuf.data_out  = 0;
+    sbuf.rw        = V_IDLE;
+    sbuf.ticks     = ticks;
+    p_rw->reset    = 1;
+
+    VExch(&sbuf, &rbuf, node);
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// VUserExch()
+//
+// Invokes a message exchange for a message set up elsewhere (e.g. a
+// sideband signal access), returning the input data
+// -------------------------------------------------------------------------
+
+unsigned VUserExch (const psend_buf_t psbuf, const unsigned node)
+{
+    rcv_buf_t  rbuf;
+
+    VExch(psbuf, &rbuf, node);
+
+    return rbuf.data_in;
+}
+
+// -------------------------------------------------------------------------
+// VDeltaLoad()
+//
+// Set up an exchange structure for a delta command vector entry
+// -------------------------------------------------------------------------
+
+void VDeltaLoad (const VDeltaCmd_t *cmd, const psend_buf_t psbuf)
+{
+    rw_t* p_rw = (rw_t*)&psbuf->rw;
+
+    psbuf->addr     = cmd->addr;
+    psbuf->data_out = cmd->data;
+    psbuf->ticks    = DELTA_CYCLE;
+
+    psbuf->rw       = 0;  // clear RW fields
+    p_rw->write     = (cmd->flags & VDELTA_WRITE)  ? 1 : 0;
+    p_rw->read      = (cmd->flags & VDELTA_READ)   ? 1 : 0;
+    p_rw->nowait    = (cmd->flags & VDELTA_NOWAIT) ? 1 : 0;
+    p_rw->fbe       = 0xf;
+}
+
+// -------------------------------------------------------------------------
+// VDeltaVec()
+//
+// Applies a vector of write, read or idle commands as delta cycle
+// updates within the current clock cycle, in a single message
+// exchange. The simulation side steps through the vector without
+// returning to the user thread. Read data is returned in each read
+// command's data field.
+// -------------------------------------------------------------------------
+
+int VDeltaVec (VDeltaCmd_t *cmds, const unsigned num, const unsigned node)
+{
+    rcv_buf_t  rbuf;
+    send_buf_t sbuf;
+
+    if (num == 0)
+    {
+        return 0;
+    }
+
+    // The simulation can't access the vector of user code in a separate
+    // process, so exchange each command in turn
+    if (ns[node]->remote != NULL)
+    {
+        for (unsigned idx = 0; idx < num; idx++)
+        {
+            VDeltaLoad(&cmds[idx], &sbuf);
+            VExch(&sbuf, &rbuf, node);
+
+            if (cmds[idx].flags & VDELTA_READ)
+            {
+                cmds[idx].data = rbuf.data_in;
+            }
+        }
+
+        return 0;
+    }
+
+    ns[node]->vec      = cmds;
+    ns[node]->vec_len  = num;
+    ns[node]->vec_idx  = 0;
+
+    VDeltaLoad(&cmds[0], &sbuf);
+    VExch(&sbuf, &rbuf, node);
+
+    return 0;
+}
+
 // -------------------------------------------------------------------------
 // VRegIrq()
 //
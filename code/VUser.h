@@ -69,8 +69,12 @@ extern int  VBurstWrite   (const unsigned      addr,  void           *data, cons
 extern int  VBurstWriteBE (const unsigned      addr,  void           *data, const unsigned wordlen, const unsigned fbe, const unsigned lbe, const unsigned node);
 extern int  VBurstRead    (const unsigned      addr,  void           *data, const unsigned wordlen, const unsigned node);
 extern int  VTick         (const unsigned      ticks, const unsigned  node);
+extern int  VReset        (const unsigned      ticks, const unsigned  node);
+extern int  VDeltaVec     (VDeltaCmd_t        *cmds,  const unsigned  num,  const unsigned node);
 extern void VRegUser      (const pVUserCB_t    func,  const unsigned  node);
 extern void VRegIrq       (const pVUserIrqCB_t func,  const unsigned  node);
+extern int  VGetStats     (const unsigned      node,  pVStats_t       stats);
+extern int  VDumpStats    (const char         *fname);
 
 // Internal function for Python interface
 extern void VRegIrqPy     (const pPyIrqCB_t    func,  const unsigned  node);
@@ -78,6 +82,12 @@ extern void VRegIrqPy     (const pPyIrqCB_t    func,  const unsigned  node);
 // VUser function prototype for VInit in VSched.c
 extern int  VUser         (const unsigned   node);
 
+// Internal function for loading a delta command vector entry, for VSched.c
+extern void VDeltaLoad    (const VDeltaCmd_t *cmd,    const psend_buf_t psbuf);
+
+// Internal function for exchanging a message set up elsewhere
+extern unsigned VUserExch (const psend_buf_t psbuf,   const unsigned  node);
+
 #if defined(VPROC_VHDL) || defined (ICARUS) || defined (VPROC_SV)
 # define VPrint(...) printf (__VA_ARGS__)
 #else
@@ -93,4 +103,7 @@ extern int  VUser         (const unsigned   node);
 // Pointer to VUserMain function type definition
 typedef void (*pVUserMain_t)(int node);
 
+// Sideband signal access API
+#include "VSignal.h"
+
 #endif
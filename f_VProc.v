@@ -24,10 +24,6 @@
 
 `include "vprocdefs.vh"
 
-`ifdef VPROC_SV
-`include "vprocdpi.vh"
-`endif
-
 // ============================================================
 // VProc module
 // ============================================================
@@ -36,7 +32,8 @@ module VProc
 #(parameter               INT_WIDTH       = 3,
                           NODE_WIDTH      = 4,
                           BURST_ADDR_INCR = 1,
-                          DISABLE_DELTA   = 0
+                          DISABLE_DELTA   = 0,
+                          DISABLE_IDLE_SKIP = 0
 )
 (
     // Clock
@@ -69,10 +66,20 @@ module VProc
     output reg             BurstLast,
 `endif
 
+`ifdef VPROC_RESET_IF
+    // Reset, asserted by user code (e.g. between tests)
+    output reg             Reset,
+`endif
+
     // Node number
     input [NODE_WIDTH-1:0] Node
 );
 
+`ifdef VPROC_SV
+// DPI-C imports, in the module's scope
+`include "vprocdpi.vh"
+`endif
+
 // ------------------------------------------------------------
 // Register definitions
 // ------------------------------------------------------------
@@ -88,12 +95,16 @@ integer               DataInSamp;
 integer               IntSamp;
 integer               IntSampLast;
 integer               NodeI;
+integer               CycleCount;
 reg                   RdAckSamp;
 reg                   WRAckSamp;
 
 // Internal initialised flag (set after VInit called)
 reg                   Initialised;
 
+// Set when the node is sleeping (ticks of SLEEPFOREVER)
+reg                   Sleeping;
+
 // Internal state
 integer               TickCount;
 integer               BlkCount;
@@ -129,6 +140,18 @@ endtask
 
 `endif
 
+`ifdef VPROC_BURST_ARRAY
+// Local copy of a burst's data, exchanged with the user thread in one
+// DPI-C call per burst (SystemVerilog with a burst interface only)
+int                   BurstArr [0:4095];
+`endif
+
+`ifndef VPROC_RESET_IF
+// When no reset interface define a local dummy register to
+// replace the missing port
+reg                   Reset;
+`endif
+
 // ------------------------------------------------------------
 // Initial process
 // ------------------------------------------------------------
@@ -140,8 +163,11 @@ begin
     WE                                  = 0;
     RD                                  = 0;
     Update                              = 0;
+    Reset                               = 0;
+    Sleeping                            = 0;
     BlkCount                            = 0;
     IntSampLast                         = 0;
+    CycleCount                          = 0;
 
     // Don't remove delay! Needed to allow Node to be assigned
     // before the call to VInit
@@ -164,6 +190,9 @@ begin
     NodeI                               = Node;
     VPTicks                             = `DELTACYCLE;
 
+    // Count clock cycles (modulo 2^31) for passing to VSched
+    CycleCount                          = (CycleCount + 1) & 32'h7fffffff;
+
     // Wait until the VProc software is initialised for this node (VInit called)
     // before starting accesses
     if (Initialised == 1'b1)
@@ -205,12 +234,18 @@ begin
                         if (RD)
                         begin
                             AccIdx          = AccIdx + 1;
+`ifdef VPROC_BURST_ARRAY
+                            // Return the whole burst's read data in one call
+                            BurstArr[AccIdx] = DataInSamp;
+                            `VBurstArray(NodeI, 1, AccIdx + 1, BurstArr);
+`else
                             `vaccess(NodeI, AccIdx, DataInSamp, VPDataOut);
+`endif
                         end
                     end
 
                     // Get new access command
-                    `VSched(NodeI, DataInSamp, VPDataOut, VPAddr, VPRW, VPTicks);
+                    `VSched(NodeI, DataInSamp, CycleCount, VPDataOut, VPAddr, VPRW, VPTicks);
 
                     // Update the outputs
                     Burst               <= VPRW[`BLKBITS];
@@ -218,6 +253,7 @@ begin
                     RD                  <= VPRW[`RDBIT];
                     BE                  <= VPRW[`BEBITS];
                     LBE                 <= VPRW[`LBEBITS];
+                    Reset               <= VPRW[`RSTBIT];
                     Addr                <= VPAddr;
 
                     // If new BlkCount is non-zero, setup burst transfer
@@ -239,7 +275,13 @@ begin
                         if (VPRW[`WEBIT])
                         begin
                             AccIdx      = 0;
+`ifdef VPROC_BURST_ARRAY
+                            // Fetch the whole burst's write data in one call
+                            `VBurstArray(NodeI, 0, BlkCount, BurstArr);
+                            VPDataOut   = BurstArr[0];
+`else
                             `vaccess(NodeI, AccIdx, `DONTCARE, VPDataOut);
+`endif
                         end
                         else
                         begin
@@ -255,7 +297,15 @@ begin
                 else
                 begin
                     AccIdx              = AccIdx + 1;
+`ifdef VPROC_BURST_ARRAY
+                    if (RD)
+                    begin
+                        BurstArr[AccIdx] = DataInSamp;
+                    end
+                    VPDataOut           = BurstArr[AccIdx];
+`else
                     `vaccess(NodeI, AccIdx, DataInSamp, VPDataOut);
+`endif
                     BlkCount            = BlkCount - 1;
 
                     if (BlkCount == 1)
@@ -282,20 +332,54 @@ begin
                     TickCount           = VPTicks - 1;
                 end
 
-                // Flag to update externally and wait for response.
-                // The `MINDELAY ensures it's not updated until other outputs
-                // are updated.
-                Update              <= `MINDELAY ~Update;
-                if (DISABLE_DELTA == 0)
+                // Flag to update externally and wait for response, unless
+                // the command has no listener (no wait flag set). The `MINDELAY
+                // ensures it's not updated until other outputs are updated.
+                if (VPRW[`NOWAITBIT] === 1'b0)
                 begin
-                    @(UpdateResponse);
+                    Update          <= `MINDELAY ~Update;
+                    if (DISABLE_DELTA == 0)
+                    begin
+                        @(UpdateResponse);
+                    end
                 end
             end
+
+            Sleeping                    = (VPTicks >= `SLEEPFOREVER);
         end
         else
         begin
             // Count down to zero and stop
             TickCount                   = (TickCount > 0) ? TickCount - 1 : 0;
+
+            // When idle, wait out the remaining ticks here rather than evaluating
+            // the whole process on each clock edge. A sleeping node needs no
+            // clock at all, and only wakes (at the next edge) on an interrupt change.
+            if (DISABLE_IDLE_SKIP == 0 && DISABLE_DELTA == 0 && RD === 1'b0 && WE === 1'b0)
+            begin
+                if (Sleeping)
+                begin
+                    @(Interrupt);
+                end
+                else
+                begin
+                    while (TickCount > 0)
+                    begin
+                        @(posedge Clk);
+
+                        CycleCount      = (CycleCount + 1) & 32'h7fffffff;
+                        IntSamp         = {1'b0, Interrupt};
+
+                        if (IntSamp != IntSampLast)
+                        begin
+                          `VIrq(NodeI, IntSamp);
+                          IntSampLast   = IntSamp;
+                        end
+
+                        TickCount       = TickCount - 1;
+                    end
+                end
+            end
         end
     end
 end
@@ -0,0 +1,85 @@
+// ====================================================================
+//
+// SystemVerilog sideband signal module for VProc, giving a node's
+// user code direct access to signals with DPI-C.
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ====================================================================
+
+// One instance per node, with VPROC_SIGNAL_IF defined for both the HDL
+// and the C code. Signal n, as indexed by VSetSignal(), VGetSignal()
+// and VWaitSignal(), is driven from SigOut[n] and read from SigIn[n].
+// The accesses are made by the node's VSched call, through the
+// functions exported here. The module is empty when VPROC_SIGNAL_IF
+// isn't defined, so the file can be in a file list regardless.
+
+`include "vprocdefs.vh"
+
+`ifdef VPROC_SIGNAL_IF
+
+module VProcSignal
+#(parameter               NUM_SIGNALS     = 8,
+                          WIDTH           = 32,   // Up to 32
+                          NODE_WIDTH      = 4
+)
+(
+    input      [WIDTH-1:0] SigIn  [0:NUM_SIGNALS-1],
+    output reg [WIDTH-1:0] SigOut [0:NUM_SIGNALS-1],
+
+    // Node number
+    input [NODE_WIDTH-1:0] Node
+);
+
+// DPI-C imports, in the module's scope
+`include "vprocdpi.vh"
+
+export "DPI-C" function VProcSignalSet;
+export "DPI-C" function VProcSignalGet;
+
+// ------------------------------------------------------------
+// Exported access functions, called in this module's scope
+// ------------------------------------------------------------
+
+function void VProcSignalSet (input int idx, input int value);
+    SigOut[idx]                         = value[WIDTH-1:0];
+endfunction
+
+function int VProcSignalGet (input int idx);
+    return int'(SigIn[idx]);
+endfunction
+
+// ------------------------------------------------------------
+// Initial process
+// ------------------------------------------------------------
+
+initial
+begin
+    for (int idx = 0; idx < NUM_SIGNALS; idx++)
+    begin
+        SigOut[idx]                     = {WIDTH{1'b0}};
+    end
+
+    // Wait for Node to be assigned before registering
+    `MINDELAY
+    VSignalRegBank(Node, NUM_SIGNALS);
+end
+
+endmodule
+
+`endif
@@ -0,0 +1,106 @@
+// ====================================================================
+//
+// Verilog side Virtual Processor port shell, for use with the pure
+// VPI transactor (code/VProcVpi.c).
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ====================================================================
+//
+// A drop in replacement for f_VProc.v with VPI simulators (e.g.
+// Icarus). The module has the same ports and parameters, but no
+// behavioural process. After initialisation, $vprocvpi registers a
+// callback on Clk, and the ports are then sampled and driven directly
+// from C. Update is never toggled, as for DISABLE_DELTA, and the
+// DISABLE_DELTA and DISABLE_IDLE_SKIP parameters are unused.
+//
+// ====================================================================
+
+`include "vprocdefs.vh"
+
+// ============================================================
+// VProc module
+// ============================================================
+
+module VProc
+#(parameter               INT_WIDTH       = 3,
+                          NODE_WIDTH      = 4,
+                          BURST_ADDR_INCR = 1,
+                          DISABLE_DELTA   = 0,
+                          DISABLE_IDLE_SKIP = 0
+)
+(
+    // Clock
+    input                  Clk,
+
+    // Bus interface
+    output reg [31:0]      Addr,
+
+`ifdef VPROC_BYTE_ENABLE
+    output reg  [3:0]      BE,
+`endif
+    output reg             WE,
+    output reg             RD,
+    output reg [31:0]      DataOut,
+    input      [31:0]      DataIn,
+    input                  WRAck,
+    input                  RDAck,
+
+    // Interrupt
+    input [INT_WIDTH-1:0]  Interrupt,
+
+    // Delta cycle control (unused)
+    output reg             Update,
+    input                  UpdateResponse,
+
+`ifdef VPROC_BURST_IF
+    // Burst count
+    output reg [11:0]      Burst,
+    output reg             BurstFirst,
+    output reg             BurstLast,
+`endif
+
+`ifdef VPROC_RESET_IF
+    // Reset, asserted by user code (e.g. between tests)
+    output reg             Reset,
+`endif
+
+    // Node number
+    input [NODE_WIDTH-1:0] Node
+);
+
+// ------------------------------------------------------------
+// Initial process
+// ------------------------------------------------------------
+
+initial
+begin
+    WE                                  = 0;
+    RD                                  = 0;
+    Update                              = 0;
+`ifdef VPROC_RESET_IF
+    Reset                               = 0;
+`endif
+
+    // Don't remove delay! Needed to allow Node to be assigned
+    // before the call to $vprocvpi
+    `MINDELAY
+    $vprocvpi(Node, BURST_ADDR_INCR);
+end
+
+endmodule
@@ -32,7 +32,9 @@ entity VProc is
   generic (INT_WIDTH       : integer := 3;
            NODE_WIDTH      : integer := 4;
            BURST_ADDR_INCR : integer := 1;
-           DISABLE_DELTA   : integer := 0
+           DISABLE_DELTA   : integer := 0;
+           DISABLE_IDLE_SKIP : integer := 0;
+           BURST_ARRAY     : integer := 0
   );
   port (
     Clk             : in  std_logic;
@@ -55,6 +57,8 @@ entity VProc is
     BurstFirst      : out std_logic;
     BurstLast       : out std_logic;
 
+    Reset           : out std_logic := '0';
+
     Node            : in  std_logic_vector(NODE_WIDTH-1 downto 0)
   );
 end;
@@ -69,6 +73,8 @@ constant      BEFIRSTLOBIT : integer := 14;
 constant      BEFIRSTHIBIT : integer := 17;
 constant      BELASTLOBIT  : integer := 18;
 constant      BELASTHIBIT  : integer := 21;
+constant      RSTbit       : integer := 22;
+constant      NOWAITbit    : integer := 23;
 constant      DeltaCycle   : integer := -1;
 
 signal        Initialised  : integer := 0;
@@ -103,8 +109,12 @@ begin
     variable DataInSamp  : integer;
     variable IntSamp     : integer;
     variable IntSampLast : integer := 0;
+    variable CycleCount  : integer := 0;
     variable RdAckSamp   : std_logic;
     variable WRAckSamp   : std_logic;
+    variable Sleeping    : boolean := false;
+    variable VPOut       : VPSchedOut_t;
+    variable BurstArr    : VPBurstArr_t;
 
   begin
 
@@ -121,6 +131,13 @@ begin
       WRAckSamp                 := WRAck;
       VPTicks                   := DeltaCycle;
 
+      -- Count clock cycles (modulo 2^31) for passing to VSched
+      if CycleCount = integer'high then
+        CycleCount              := 0;
+      else
+        CycleCount              := CycleCount + 1;
+      end if;
+
       if Initialised = 1 then
 
         -- Call VIrq when interrupt value changes, passing in
@@ -156,26 +173,43 @@ begin
                 if RD = '1' then
                     AccIdx          := AccIdx + 1;
 
-                    VAccess(to_integer(unsigned(Node)),
-                            AccIdx,
-                            DataInSamp,
-                            VPDataOut);
+                    if BURST_ARRAY /= 0 then
+                      -- Return the whole burst's read data in one call
+                      BurstArr(AccIdx) := DataInSamp;
+                      VBurstArray(to_integer(unsigned(Node)), 1, AccIdx + 1, BurstArr);
+                    else
+                      VAccess(to_integer(unsigned(Node)),
+                              AccIdx,
+                              DataInSamp,
+                              VPDataOut);
+                    end if;
                 end if;
               end if;
 
               -- Host process message scheduler called
-              VSched(to_integer(unsigned(Node)),
-                     DataInSamp,
-                     VPDataOut,
-                     VPAddr,
-                     VPRW,
-                     VPTicks);
+              if BURST_ARRAY /= 0 then
+                VSchedRec(to_integer(unsigned(Node)), DataInSamp, CycleCount, VPOut);
+
+                VPDataOut       := VPOut.DataOut;
+                VPAddr          := VPOut.Addr;
+                VPRW            := VPOut.Rw;
+                VPTicks         := VPOut.Ticks;
+              else
+                VSched(to_integer(unsigned(Node)),
+                       DataInSamp,
+                       CycleCount,
+                       VPDataOut,
+                       VPAddr,
+                       VPRW,
+                       VPTicks);
+              end if;
 
               Burst             <= std_logic_vector(to_unsigned(VPRW, 32)(BLKHIBIT downto BLKLOBIT));
               BE                <= std_logic_vector(to_unsigned(VPRW, 32)(BEFIRSTHIBIT downto BEFIRSTLOBIT));
               LBE               <= std_logic_vector(to_unsigned(VPRW, 32)(BELASTHIBIT downto BELASTLOBIT));
               WE                <= to_unsigned(VPRW, 32)(WEbit);
               RD                <= to_unsigned(VPRW, 32)(RDbit);
+              Reset             <= to_unsigned(VPRW, 32)(RSTbit);
               Addr              <= std_logic_vector(to_signed(VPAddr, 32));
 
               BlkCount          := to_integer(to_unsigned(VPRW, 32)(BLKHIBIT downto BLKLOBIT));
@@ -193,10 +227,16 @@ begin
                 if to_unsigned(VPRW, 32)(WEbit)  = '1' then
                   AccIdx        := 0;
 
-                  VAccess(to_integer(unsigned(Node)),
-                          AccIdx,
-                          0,
-                          VPDataOut);
+                  if BURST_ARRAY /= 0 then
+                    -- Fetch the whole burst's write data in one call
+                    VBurstArray(to_integer(unsigned(Node)), 0, BlkCount, BurstArr);
+                    VPDataOut   := BurstArr(0);
+                  else
+                    VAccess(to_integer(unsigned(Node)),
+                            AccIdx,
+                            0,
+                            VPDataOut);
+                  end if;
                 else
                   AccIdx        := -1;
                 end if;
@@ -209,10 +249,17 @@ begin
             else
               AccIdx            := AccIdx + 1;
 
-              VAccess(to_integer(unsigned(Node)),
-                      AccIdx,
-                      DataInSamp,
-                      VPDataOut);
+              if BURST_ARRAY /= 0 then
+                if RD = '1' then
+                  BurstArr(AccIdx) := DataInSamp;
+                end if;
+                VPDataOut       := BurstArr(AccIdx);
+              else
+                VAccess(to_integer(unsigned(Node)),
+                        AccIdx,
+                        DataInSamp,
+                        VPDataOut);
+              end if;
 
               DataOut           <= std_logic_vector(to_signed(VPDataOut, 32));
               Addr              <= std_logic_vector(unsigned(Addr) + BURST_ADDR_INCR);
@@ -235,14 +282,19 @@ begin
               TickVal           := VPTicks - 1;
             end if;
 
-            -- Flag to update externally and wait for response
-            Update              <= not Update;
-            if DISABLE_DELTA = 0 then
-              wait on UpdateResponse;
+            -- Flag to update externally and wait for response, unless
+            -- the command has no listener (no wait flag set)
+            if to_unsigned(VPRW, 32)(NOWAITbit) = '0' then
+              Update            <= not Update;
+              if DISABLE_DELTA = 0 then
+                wait on UpdateResponse;
+              end if;
             end if;
 
           end loop;
 
+          Sleeping              := VPTicks = integer'high;
+
         else
 
           -- Count down to zero and stop
@@ -252,6 +304,34 @@ begin
             TickVal             := 0;
           end if;
 
+          -- When idle, wait out the remaining ticks here rather than evaluating
+          -- the whole process on each clock edge. A sleeping node needs no
+          -- clock at all, and only wakes (at the next edge) on an interrupt change.
+          if DISABLE_IDLE_SKIP = 0 and DISABLE_DELTA = 0 and RD = '0' and WE = '0' then
+            if Sleeping then
+              wait on Interrupt;
+            else
+              while TickVal > 0 loop
+                wait until Clk'event and Clk = '1';
+
+                if CycleCount = integer'high then
+                  CycleCount    := 0;
+                else
+                  CycleCount    := CycleCount + 1;
+                end if;
+
+                IntSamp         := to_integer(signed("0" & Interrupt));
+
+                if IntSamp /= IntSampLast then
+                  VIrq(to_integer(unsigned(Node)), IntSamp);
+                  IntSampLast   := IntSamp;
+                end if;
+
+                TickVal         := TickVal - 1;
+              end loop;
+            end if;
+          end if;
+
         end if;
       end if;
     end loop;
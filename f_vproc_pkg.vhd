@@ -24,6 +24,16 @@
 
 package vproc_pkg is
 
+  -- Whole burst data, and VSched outputs, for single call transfers
+  type VPBurstArr_t is array (0 to 4095) of integer;
+
+  type VPSchedOut_t is record
+    DataOut   : integer;
+    Addr      : integer;
+    Rw        : integer;
+    Ticks     : integer;
+  end record;
+
   procedure VInit (
     node : in integer
   );
@@ -33,6 +43,7 @@ package vproc_pkg is
   procedure VSched (
     node      : in  integer;
     VPDataIn  : in  integer;
+    VPCycle   : in  integer;
     VPDataOut : out integer;
     VPAddr    : out integer;
     VPRw      : out integer;
@@ -64,6 +75,20 @@ attribute foreign of VSched : procedure is "VSched VProc.so";
   attribute foreign of VAccess : procedure is "VAccess VProc.so";
 --attribute foreign of VAccess : procedure is "VHPI VProc.so; VAccess";
 
+  procedure VSchedRec (
+    node      : in  integer;
+    VPDataIn  : in  integer;
+    VPCycle   : in  integer;
+    VPOut     : out VPSchedOut_t
+  );
+
+  procedure VBurstArray (
+    node      : in    integer;
+    rd        : in    integer;
+    len       : in    integer;
+    data      : inout VPBurstArr_t
+  );
+
 end;
 
 package body vproc_pkg is
@@ -78,6 +103,7 @@ package body vproc_pkg is
   procedure VSched (
     node      : in  integer;
     VPDataIn  : in  integer;
+    VPCycle   : in  integer;
     VPDataOut : out integer;
     VPAddr    : out integer;
     VPRw      : out integer;
@@ -113,4 +139,35 @@ package body vproc_pkg is
     report "ERROR: foreign subprogram out_params not called";
   end;
 
+
+  -- VSchedRec and VBurstArray are implemented here in terms of VSched and
+  -- VAccess, as FLI and VHPI have no direct array and record passing
+
+  procedure VSchedRec (
+    node      : in  integer;
+    VPDataIn  : in  integer;
+    VPCycle   : in  integer;
+    VPOut     : out VPSchedOut_t
+  ) is
+  begin
+    VSched(node, VPDataIn, VPCycle, VPOut.DataOut, VPOut.Addr, VPOut.Rw, VPOut.Ticks);
+  end;
+
+  procedure VBurstArray (
+    node      : in    integer;
+    rd        : in    integer;
+    len       : in    integer;
+    data      : inout VPBurstArr_t
+  ) is
+    variable unused : integer;
+  begin
+    for idx in 0 to len-1 loop
+      if rd /= 0 then
+        VAccess(node, idx, data(idx), unused);
+      else
+        VAccess(node, idx, 0, data(idx));
+      end if;
+    end loop;
+  end;
+
 end;
\ No newline at end of file
@@ -24,6 +24,16 @@
 
 package vproc_pkg is
 
+  -- Whole burst data, and VSched outputs, for single call transfers
+  type VPBurstArr_t is array (0 to 4095) of integer;
+
+  type VPSchedOut_t is record
+    DataOut   : integer;
+    Addr      : integer;
+    Rw        : integer;
+    Ticks     : integer;
+  end record;
+
   procedure VInit (
     node : in integer
   );
@@ -32,6 +42,7 @@ package vproc_pkg is
   procedure VSched (
     node      : in  integer;
     VPDataIn  : in  integer;
+    VPCycle   : in  integer;
     VPDataOut : out integer;
     VPAddr    : out integer;
     VPRw      : out integer;
@@ -59,6 +70,22 @@ attribute foreign of VSched : procedure is "VHPIDIRECT ./VProc.so VSched";
   );
   attribute foreign of VAccess : procedure is "VHPIDIRECT ./VProc.so VAccess";
 
+  procedure VSchedRec (
+    node      : in  integer;
+    VPDataIn  : in  integer;
+    VPCycle   : in  integer;
+    VPOut     : out VPSchedOut_t
+  );
+  attribute foreign of VSchedRec : procedure is "VHPIDIRECT ./VProc.so VSchedRec";
+
+  procedure VBurstArray (
+    node      : in    integer;
+    rd        : in    integer;
+    len       : in    integer;
+    data      : inout VPBurstArr_t
+  );
+  attribute foreign of VBurstArray : procedure is "VHPIDIRECT ./VProc.so VBurstArray";
+
 end;
 
 package body vproc_pkg is
@@ -73,6 +100,7 @@ package body vproc_pkg is
   procedure VSched (
     node      : in  integer;
     VPDataIn  : in  integer;
+    VPCycle   : in  integer;
     VPDataOut : out integer;
     VPAddr    : out integer;
     VPRw      : out integer;
@@ -108,4 +136,25 @@ package body vproc_pkg is
     report "ERROR: foreign subprogram out_params not called";
   end;
 
+
+  procedure VSchedRec (
+    node      : in  integer;
+    VPDataIn  : in  integer;
+    VPCycle   : in  integer;
+    VPOut     : out VPSchedOut_t
+  ) is
+  begin
+    report "ERROR: foreign subprogram out_params not called";
+  end;
+
+  procedure VBurstArray (
+    node      : in    integer;
+    rd        : in    integer;
+    len       : in    integer;
+    data      : inout VPBurstArr_t
+  ) is
+  begin
+    report "ERROR: foreign subprogram out_params not called";
+  end;
+
 end;
\ No newline at end of file
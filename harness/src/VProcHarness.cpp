@@ -0,0 +1,253 @@
+// ====================================================================
+// VProcHarness.cpp                                    Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// The clockNode() method follows the posedge process of f_VProc.v,
+// with the target acknowledging all reads and writes in the same
+// cycle (as for the memory in test/test.v). Writes are clocked into
+// the target at the edge after the command was issued, and read data
+// is sampled combinatorially from the current address. Writes issued
+// as delta cycle updates are passed to the target immediately, as
+// they would be by logic responding to the HDL's Update signal, the
+// toggles of which are counted, skipping commands flagged as no wait.
+// The clock edges at which the Reset output is asserted are counted.
+//
+// ===================================================================
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "VProcHarness.h"
+
+extern "C" {
+#include "VSched_pli.h"
+}
+
+// rw bit fields, matching vprocdefs.vh
+#define VPH_WEBIT          0x00000001
+#define VPH_RDBIT          0x00000002
+#define VPH_BLKSHIFT       2
+#define VPH_BLKMASK        0xfff
+#define VPH_BESHIFT        14
+#define VPH_LBESHIFT       18
+#define VPH_RSTBIT         0x00400000
+#define VPH_NOWAITBIT      0x00800000
+#define VPH_BEMASK         0xf
+
+#define VPH_DELTA_CYCLE    -1
+
+// -------------------------------------------------------------------------
+// Constructor
+// -------------------------------------------------------------------------
+
+VProcHarness::VProcHarness (const int num_nodes, VProcTarget* target, const uint32_t burst_addr_incr) :
+    nodes(num_nodes), burstAddrIncr(burst_addr_incr), cycle(0), cycleCount(0), finished(false)
+{
+    for (int node = 0; node < num_nodes; node++)
+    {
+        node_t &n     = nodes[node];
+
+        n.target      = target ? target : &n.mem;
+        n.Addr        = 0;
+        n.DataOut     = 0;
+        n.BE          = 0;
+        n.LBE         = 0;
+        n.WE          = false;
+        n.RD          = false;
+        n.TickCount   = 1;
+        n.BlkCount    = 0;
+        n.AccIdx      = 0;
+        n.Interrupt   = 0;
+        n.IntSampLast = 0;
+        n.NoWait      = false;
+        n.Updates     = 0;
+        n.Reset       = false;
+        n.Resets      = 0;
+
+        VInit(node);
+    }
+}
+
+// -------------------------------------------------------------------------
+// run()
+//
+// Clock all the nodes for the given number of cycles, or until
+// finish() has been called
+// -------------------------------------------------------------------------
+
+uint64_t VProcHarness::run (const uint64_t cycles)
+{
+    uint64_t start = cycle;
+
+    while (!finished && (cycle - start) < cycles)
+    {
+        cycle++;
+        cycleCount = (cycleCount + 1) & 0x7fffffff;
+
+        for (int node = 0; node < (int)nodes.size(); node++)
+        {
+            clockNode(node);
+        }
+    }
+
+    return cycle - start;
+}
+
+// -------------------------------------------------------------------------
+// setOutputs()
+//
+// Update a node's bus outputs from a new VSched command
+// -------------------------------------------------------------------------
+
+void VProcHarness::setOutputs (node_t &n, const int VPAddr, const int VPRW, const int VPDataOut, const int node)
+{
+    int burst = (VPRW >> VPH_BLKSHIFT) & VPH_BLKMASK;
+    int dout  = VPDataOut;
+
+    n.WE     = VPRW & VPH_WEBIT;
+    n.RD     = VPRW & VPH_RDBIT;
+    n.BE     = (VPRW >> VPH_BESHIFT)  & VPH_BEMASK;
+    n.LBE    = (VPRW >> VPH_LBESHIFT) & VPH_BEMASK;
+    n.NoWait = VPRW & VPH_NOWAITBIT;
+    n.Reset  = VPRW & VPH_RSTBIT;
+    n.Addr   = VPAddr;
+
+    if (burst)
+    {
+        n.BlkCount = burst;
+
+        // Writes get the first data from VAccess at index 0. Reads
+        // start at -1 as the index is pre-incremented.
+        if (n.WE)
+        {
+            n.AccIdx = 0;
+            VAccess(node, n.AccIdx, 0, &dout);
+        }
+        else
+        {
+            n.AccIdx = -1;
+        }
+    }
+
+    n.DataOut = dout;
+}
+
+// -------------------------------------------------------------------------
+// clockNode()
+//
+// Process a clock edge for a single node
+// -------------------------------------------------------------------------
+
+void VProcHarness::clockNode (const int node)
+{
+    node_t &n = nodes[node];
+
+    // Input data is sampled before the edge's write takes effect
+    int DataInSamp = n.target->read(n.Addr);
+
+    // Clock in any write from the previous cycle, acknowledged immediately
+    if (n.WE)
+    {
+        n.target->write(n.Addr, n.DataOut, n.BE);
+    }
+
+    // Count the edges with the reset output asserted
+    if (n.Reset)
+    {
+        n.Resets++;
+    }
+
+    if (n.Interrupt != n.IntSampLast)
+    {
+        VIrq(node, n.Interrupt);
+        n.IntSampLast = n.Interrupt;
+    }
+
+    // Reads and writes always complete in a single cycle, so only ticks
+    // need counting down
+    if (!n.RD && !n.WE && n.TickCount != 0)
+    {
+        n.TickCount--;
+        return;
+    }
+
+    int VPTicks = VPH_DELTA_CYCLE;
+
+    for (bool first = true; VPTicks < 0; first = false)
+    {
+        int VPDataOut;
+
+        // Resample after a delta cycle update
+        if (!first)
+        {
+            DataInSamp = n.target->read(n.Addr);
+        }
+
+        if (n.BlkCount <= 1)
+        {
+            // Pass back the last read data of a burst
+            if (n.BlkCount == 1)
+            {
+                n.BlkCount = 0;
+
+                if (n.RD)
+                {
+                    VAccess(node, ++n.AccIdx, DataInSamp, &VPDataOut);
+                }
+            }
+
+            int VPAddr, VPRW;
+
+            VSched(node, DataInSamp, cycleCount, &VPDataOut, &VPAddr, &VPRW, &VPTicks);
+
+            setOutputs(n, VPAddr, VPRW, VPDataOut, node);
+
+            // Delta cycle writes go straight to the target
+            if (VPTicks < 0 && n.WE)
+            {
+                n.target->write(n.Addr, n.DataOut, n.BE);
+            }
+        }
+        else
+        {
+            VAccess(node, ++n.AccIdx, DataInSamp, &VPDataOut);
+
+            n.BlkCount--;
+            n.BE       = (n.BlkCount == 1) ? n.LBE : VPH_BEMASK;
+            n.DataOut  = VPDataOut;
+            n.Addr    += burstAddrIncr;
+
+            VPTicks    = 0;
+        }
+
+        if (VPTicks > 0)
+        {
+            n.TickCount = VPTicks - 1;
+        }
+
+        // Update is toggled for each command (and burst word), unless the
+        // command has no listener
+        if (!n.NoWait)
+        {
+            n.Updates++;
+        }
+    }
+}
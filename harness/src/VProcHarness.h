@@ -0,0 +1,141 @@
+// ====================================================================
+// VProcHarness.h                                      Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// Simulator-free harness, reproducing the clock edge behaviour of the
+// VProc HDL component (f_VProc.v) in C++ and calling the DPI-C flavour
+// of VInit, VSched, VAccess and VIrq directly. The VProc C code must
+// be compiled with -DVPROC_SV, and the executable linked with
+// -rdynamic so that VUserMainX functions can be found.
+//
+// ===================================================================
+
+#ifndef _VPROCHARNESS_H_
+#define _VPROCHARNESS_H_
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+// --------------------------------------------------------------------
+// Target model base class, connected to a node's bus. Reads are
+// combinatorial from the current address, writes are clocked.
+// --------------------------------------------------------------------
+
+class VProcTarget
+{
+public:
+    virtual          ~VProcTarget () {};
+
+    virtual uint32_t read         (const uint32_t addr) = 0;
+    virtual void     write        (const uint32_t addr, const uint32_t data, const uint32_t be) = 0;
+};
+
+// --------------------------------------------------------------------
+// Simple sparse memory target, addressed in bus units (i.e. the
+// address presented on the bus is used unmodified as a key)
+// --------------------------------------------------------------------
+
+class VProcMemTarget : public VProcTarget
+{
+public:
+    uint32_t         read         (const uint32_t addr)
+                     {
+                         auto it = mem.find(addr);
+                         return (it == mem.end()) ? 0 : it->second;
+                     };
+
+    void             write        (const uint32_t addr, const uint32_t data, const uint32_t be)
+                     {
+                         uint32_t mask = ((be & 1) ? 0x000000ff : 0) | ((be & 2) ? 0x0000ff00 : 0) |
+                                         ((be & 4) ? 0x00ff0000 : 0) | ((be & 8) ? 0xff000000 : 0);
+                         mem[addr]     = (read(addr) & ~mask) | (data & mask);
+                     };
+
+private:
+    std::unordered_map<uint32_t, uint32_t> mem;
+};
+
+// --------------------------------------------------------------------
+// Harness class. Only one instance may exist in a process, as the
+// VProc node state is global.
+// --------------------------------------------------------------------
+
+class VProcHarness
+{
+public:
+                     VProcHarness (const int num_nodes, VProcTarget* target = NULL, const uint32_t burst_addr_incr = 4);
+
+    // Connect a target to a node (default is an internal memory per node)
+    void             setTarget    (const int node, VProcTarget* target) {nodes[node].target = target;};
+
+    // Set a node's interrupt input. VIrq is called on the next clock edge if changed.
+    void             setInterrupt (const int node, const uint32_t value) {nodes[node].Interrupt = value;};
+
+    // Run for a number of clock cycles, or until finish() called. Returns cycles run.
+    uint64_t         run          (const uint64_t cycles);
+
+    // Flag that run() should return at the end of the current cycle (e.g. from a target)
+    void             finish       (void) {finished = true;};
+    bool             isFinished   (void) {return finished;};
+
+    uint64_t         getCycle     (void) {return cycle;};
+
+    // Number of times a node's Update output has toggled (i.e. commands not flagged as no wait)
+    uint64_t         getUpdates   (const int node) {return nodes[node].Updates;};
+
+    // Number of clock edges at which a node's Reset output has been asserted
+    uint64_t         getResets    (const int node) {return nodes[node].Resets;};
+
+private:
+
+    // Per-node state mirroring the f_VProc.v registers
+    struct node_t {
+        VProcTarget*     target;
+        VProcMemTarget   mem;
+        uint32_t         Addr;
+        uint32_t         DataOut;
+        uint32_t         BE;
+        uint32_t         LBE;
+        bool             WE;
+        bool             RD;
+        int              TickCount;
+        int              BlkCount;
+        int              AccIdx;
+        uint32_t         Interrupt;
+        uint32_t         IntSampLast;
+        bool             NoWait;
+        uint64_t         Updates;
+        bool             Reset;
+        uint64_t         Resets;
+    };
+
+    void             clockNode    (const int node);
+    void             setOutputs   (node_t &n, const int VPAddr, const int VPRW, const int VPDataOut, const int node);
+
+    std::vector<node_t>  nodes;
+    uint32_t             burstAddrIncr;
+    uint64_t             cycle;
+    uint32_t             cycleCount;
+    bool                 finished;
+};
+
+#endif
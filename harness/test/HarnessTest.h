@@ -0,0 +1,81 @@
+// ====================================================================
+// HarnessTest.h                                       Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+
+#ifndef _HARNESSTEST_H_
+#define _HARNESSTEST_H_
+
+// Number of nodes. Node 0 runs the core tests and collects the
+// results of the others
+#define HARNESS_NODES          13
+
+// Node whose user code runs in a separate (forked) process, as for
+// VPROC_REMOTE
+#define HARNESS_REMOTE_NODE    8
+
+// Node whose user code is a list of test entry points (VPROC_TESTS),
+// with the reset output pulsed for HARNESS_TEST_RESET cycles between
+// them. The list is read from HARNESS_TESTS_FILE, unless given by a
+// +VPROC_TESTS=<list> argument.
+#define HARNESS_RESTART_NODE   9
+#define HARNESS_TEST_RESET     5
+#define HARNESS_TESTS_FILE     "restart.lst"
+
+// Node whose commands are recorded, or replayed, when the harness is run
+// with VPROC_RECORD_FILE or VPROC_REPLAY_FILE set
+#define HARNESS_REPLAY_NODE    10
+
+// Buffered log file, logging warnings and errors of categories 0x1 and
+// 0x4 (and category 0), as set in the environment for the log test
+#define HARNESS_VLOG_FILE      "harness.log"
+#define HARNESS_VLOG_LEVEL     "warn"
+#define HARNESS_VLOG_CATS      "5"
+
+// Writing to this address ends the run, with the data as exit status
+#define HARNESS_FINISH_ADDR    0xb0000000
+
+// Each of the other nodes writes its error count, or'ed with
+// HARNESS_RESULT_DONE, to this address plus 4 times its node number
+#define HARNESS_RESULT_ADDR    0xb0000100
+#define HARNESS_RESULT_DONE    0x80000000
+
+// Writes to this address are logged in order. Reading it gives the
+// number logged, and reading it plus 4*(n+1) gives the nth logged.
+#define HARNESS_LOG_ADDR       0xb0000200
+
+// Reading this address plus 4 times a node number gives the number of
+// times the node's Update output has toggled
+#define HARNESS_UPDATE_ADDR    0xb0000300
+
+// Reading this address plus 4 times a node number gives the number of
+// clock edges at which the node's Reset output has been asserted
+#define HARNESS_RESET_ADDR     0xb0000400
+
+// Cycle at which the harness raises interrupt 1 on node 0
+#define HARNESS_IRQ_CYCLE      2000
+
+// Iterations of write/read pairs for transaction rate measurement
+#define HARNESS_RATE_ITERS     100000
+
+// Maximum run time, in cycles
+#define HARNESS_TIMEOUT        10000000
+
+#endif
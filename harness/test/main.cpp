@@ -0,0 +1,202 @@
+// ====================================================================
+// main.cpp                                            Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// Top level for the harness self-test. HARNESS_NODES nodes share a
+// memory target, with a write to HARNESS_FINISH_ADDR ending the run
+// and giving the exit status. Writes to HARNESS_LOG_ADDR are logged,
+// for checking the order of transactions, and reads from
+// HARNESS_UPDATE_ADDR give the nodes' Update toggle counts. The user
+// code of HARNESS_REMOTE_NODE is run in a forked process, attached to
+// the node's VPROC_REMOTE segment as vpremote would be. Reads from
+// HARNESS_RESET_ADDR give the nodes' Reset output edge counts, and
+// HARNESS_RESTART_NODE runs the test list of VPROC_TESTS, or of a
+// +VPROC_TESTS=<list> argument, passed on as the plusarg would be.
+// Only HARNESS_REPLAY_NODE is recorded or replayed, and a replay is
+// checked to have had no read mismatches or retimed commands. The
+// buffered log settings are those expected by the log test.
+//
+// ===================================================================
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+
+#include "VProcHarness.h"
+#include "HarnessTest.h"
+
+extern "C" {
+#include "VUser.h"
+#include "VRestart.h"
+#include "VLog.h"
+}
+
+// Memory target that stops the harness on a write to the finish address,
+// and logs writes to the log address
+class TestTarget : public VProcMemTarget
+{
+public:
+                 TestTarget (VProcHarness** h) : harness(h), status(-1) {};
+
+    uint32_t     read       (const uint32_t addr)
+                 {
+                     if (addr == HARNESS_LOG_ADDR)
+                     {
+                         return log.size();
+                     }
+                     else if (addr > HARNESS_LOG_ADDR && addr <= HARNESS_LOG_ADDR + 4*log.size())
+                     {
+                         return log[(addr - HARNESS_LOG_ADDR)/4 - 1];
+                     }
+                     else if (addr >= HARNESS_UPDATE_ADDR && addr < HARNESS_UPDATE_ADDR + 4*HARNESS_NODES)
+                     {
+                         return (*harness)->getUpdates((addr - HARNESS_UPDATE_ADDR)/4);
+                     }
+                     else if (addr >= HARNESS_RESET_ADDR && addr < HARNESS_RESET_ADDR + 4*HARNESS_NODES)
+                     {
+                         return (*harness)->getResets((addr - HARNESS_RESET_ADDR)/4);
+                     }
+
+                     return VProcMemTarget::read(addr);
+                 };
+
+    void         write      (const uint32_t addr, const uint32_t data, const uint32_t be)
+                 {
+                     if (addr == HARNESS_FINISH_ADDR)
+                     {
+                         status = data;
+                         (*harness)->finish();
+                     }
+                     else if (addr == HARNESS_LOG_ADDR)
+                     {
+                         log.push_back(data);
+                     }
+                     else
+                     {
+                         VProcMemTarget::write(addr, data, be);
+                     }
+                 };
+
+    VProcHarness**        harness;
+    int                   status;
+    std::vector<uint32_t> log;
+};
+
+// Attach to the remote node's segment, in the forked user process,
+// and run its user code until the harness exits
+static void remoteUser (const char* prefix)
+{
+    ns[HARNESS_REMOTE_NODE] = (pSchedState_t) calloc(1, sizeof(SchedState_t));
+
+    VStatsInit(HARNESS_REMOTE_NODE);
+
+    if (VRemoteConnect(HARNESS_REMOTE_NODE, prefix))
+    {
+        exit(1);
+    }
+
+    pthread_exit(NULL);
+}
+
+int main (int argc, char** argv)
+{
+    VProcHarness* harness;
+    TestTarget    target(&harness);
+    char          prefix[64];
+    char          mask[32];
+    char          reset[32];
+    char          replay[32];
+    size_t        len = strlen(VRESTART_TESTS_ENV);
+
+    // Make the remote node's user code a separate process, with a
+    // segment name unique to this run
+    snprintf(prefix, sizeof(prefix), "/vpharness%d", (int)getpid());
+    snprintf(mask,   sizeof(mask),   "%llx", 1ULL << HARNESS_REMOTE_NODE);
+    setenv(VREMOTE_ENV,       prefix, 1);
+    setenv(VREMOTE_NODES_ENV, mask,   1);
+
+    // Test list and reset pulse for the restart node, with any list argument
+    // taking precedence over the environment
+    snprintf(reset, sizeof(reset), "%d", HARNESS_TEST_RESET);
+    setenv(VRESTART_TESTS_ENV, "@" HARNESS_TESTS_FILE, 0);
+    setenv(VRESTART_RESET_ENV, reset, 1);
+
+    // Record or replay only the replay test node
+    snprintf(replay, sizeof(replay), "%llx", 1ULL << HARNESS_REPLAY_NODE);
+    setenv(VREPLAY_NODES_ENV, replay, 1);
+
+    // Buffered log settings
+    setenv(VLOG_FILE_ENV,  HARNESS_VLOG_FILE,  1);
+    setenv(VLOG_LEVEL_ENV, HARNESS_VLOG_LEVEL, 1);
+    setenv(VLOG_CATS_ENV,  HARNESS_VLOG_CATS,  1);
+    unsetenv(VLOG_PER_NODE_ENV);
+
+    for (int idx = 1; idx < argc; idx++)
+    {
+        if (argv[idx][0] == '+' && strncmp(&argv[idx][1], VRESTART_TESTS_ENV, len) == 0 && argv[idx][len+1] == '=')
+        {
+            VRestartSetList(&argv[idx][len+2]);
+        }
+    }
+
+    fflush(stdout);
+
+    if (fork() == 0)
+    {
+        remoteUser(prefix);
+    }
+
+    harness = new VProcHarness(HARNESS_NODES, &target);
+
+    // Run to the interrupt cycle, pulse interrupt 1, then run to completion
+    harness->run(HARNESS_IRQ_CYCLE);
+    harness->setInterrupt(0, 1);
+    harness->run(1);
+    harness->setInterrupt(0, 0);
+    harness->run(HARNESS_TIMEOUT);
+
+    if (target.status < 0)
+    {
+        fprintf(stderr, "***Error: harness test timed out at cycle %lu\n", (unsigned long)harness->getCycle());
+        return 1;
+    }
+
+    printf("Harness test finished at cycle %lu\n", (unsigned long)harness->getCycle());
+
+    // A replayed node must get the same read data, on the same cycles, as recorded
+    VReplayState_t* rp = ns[HARNESS_REPLAY_NODE]->replay;
+
+    if (rp != NULL && rp->mode == VREPLAY_MODE_REPLAY)
+    {
+        printf("Replayed %llu commands on node %d\n", (unsigned long long)rp->commands, HARNESS_REPLAY_NODE);
+
+        if (rp->commands == 0 || rp->mismatches || rp->retimed)
+        {
+            fprintf(stderr, "***Error: node %d replay had %llu read mismatches and %llu retimed commands\n",
+                    HARNESS_REPLAY_NODE, (unsigned long long)rp->mismatches, (unsigned long long)rp->retimed);
+            return 1;
+        }
+    }
+
+    return target.status;
+}
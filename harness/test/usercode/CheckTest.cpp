@@ -0,0 +1,193 @@
+// ====================================================================
+// CheckTest.cpp                                       Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// Harness self-test user code for deferred checking, on node 5.
+// Checks are submitted with VCheckSubmitGen() at different cycles,
+// some with mismatching data, and with the earliest generators the
+// slowest, so that the checks complete out of order. The failures
+// VCheckSync() reports are captured from stdout, and checked to be
+// the expected ones, in cycle order. (The summary at the end of the
+// run includes these expected failures.)
+//
+// ===================================================================
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#include "VProcClass.h"
+#include "HarnessTest.h"
+
+extern "C" {
+#include "VCheck.h"
+}
+
+// I'm node 5
+static const int node = 5;
+
+static int       errors = 0;
+
+#define CHECK_NUM               5
+#define CHECK_WORDS             16
+
+// Generator context
+typedef struct {
+    uint32_t base;
+    unsigned delay;
+} genCtx_t;
+
+// Per check generator delay (us), and whether the data is corrupted
+static const unsigned delay[CHECK_NUM]   = {200000, 100000, 50000, 0, 0};
+static const int      corrupt[CHECK_NUM] = {1, 0, 1, 1, 0};
+
+// ---------------------------------------------
+// Check a value and report a mismatch
+// ---------------------------------------------
+
+static void check (const char *what, const uint64_t got, const uint64_t exp)
+{
+    if (got != exp)
+    {
+        VPrint("***Error: %s got %llu, expected %llu\n", what, (unsigned long long)got, (unsigned long long)exp);
+        errors++;
+    }
+}
+
+// ---------------------------------------------
+// Expected data generator
+// ---------------------------------------------
+
+static void gen (void *expected, const size_t bytes, void *ctx)
+{
+    genCtx_t *g = (genCtx_t *)ctx;
+
+    usleep(g->delay);
+
+    for (size_t idx = 0; idx < bytes / 4; idx++)
+    {
+        ((uint32_t *)expected)[idx] = g->base + idx;
+    }
+}
+
+// ---------------------------------------------
+// MAIN ENTRY POINT FOR NODE 5
+// ---------------------------------------------
+
+extern "C" void VUserMain5 (void)
+{
+    VProc    vp(node);
+    VStats_t stats;
+    uint32_t data[CHECK_WORDS];
+    uint64_t cycle[CHECK_NUM];
+    char     name[VCHECK_NAME_SIZE];
+    char     line[VCHECK_MSG_SIZE + 128];
+    int      reported = 0;
+
+    // Enough workers for the checks to run concurrently
+    setenv(VCHECK_THREADS_ENV, "4", 1);
+
+    for (int chk = 0; chk < CHECK_NUM; chk++)
+    {
+        genCtx_t ctx = {(uint32_t)chk << 16, delay[chk]};
+
+        vp.tick(10);
+        vp.getStats(&stats);
+        cycle[chk] = stats.cycle;
+
+        for (int idx = 0; idx < CHECK_WORDS; idx++)
+        {
+            data[idx] = ctx.base + idx;
+        }
+
+        if (corrupt[chk])
+        {
+            data[chk] ^= 1;
+        }
+
+        snprintf(name, sizeof(name), "check%d", chk);
+        VCheckSubmitGen(node, name, data, sizeof(data), VCHECK_COPY, gen, &ctx, sizeof(ctx));
+    }
+
+    // Capture the failures reported to stdout by VCheckSync()
+    FILE *tmp   = tmpfile();
+    int   saved = dup(1);
+
+    fflush(stdout);
+    dup2(fileno(tmp), 1);
+
+    check("sync failures", VCheckSync(node), 3);
+
+    fflush(stdout);
+    dup2(saved, 1);
+    close(saved);
+    rewind(tmp);
+
+    // Check the reports are the corrupted checks in cycle order, passing
+    // on any other output
+    int next = 0;
+
+    while (fgets(line, sizeof(line), tmp) != NULL)
+    {
+        unsigned long long cyc;
+        int                n;
+
+        if (sscanf(line, "***Error: VCheck node %d cycle %llu check %63s", &n, &cyc, name) != 3)
+        {
+            fputs(line, stdout);
+            continue;
+        }
+
+        while (next < CHECK_NUM && !corrupt[next])
+        {
+            next++;
+        }
+
+        if (next < CHECK_NUM)
+        {
+            char exp[VCHECK_NAME_SIZE];
+
+            snprintf(exp, sizeof(exp), "check%d", next);
+
+            check("report node", n, node);
+            check("report cycle", cyc, cycle[next]);
+            check("report order", strcmp(name, exp) == 0, 1);
+            next++;
+        }
+
+        reported++;
+    }
+
+    fclose(tmp);
+
+    check("failures reported", reported, 3);
+
+    // Failures already reported are counted, but not reported again
+    check("sync total", VCheckSync(node), 3);
+
+    vp.write(HARNESS_RESULT_ADDR + 4*node, HARNESS_RESULT_DONE | errors);
+
+    while (1)
+    {
+        vp.tick(GO_TO_SLEEP);
+    }
+}
@@ -0,0 +1,266 @@
+// ====================================================================
+// CoroTest.cpp                                        Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// Harness self-test user code for the C++20 coroutine executor
+// (VProcCoro.h), on node 6. Checks that:
+//
+//  * the transactions of two spawned sequences are interleaved, with
+//    each sequence's writes completing alternately, and read back
+//    correctly
+//  * sequences ticking to the same cycle wake in the order they
+//    awaited, after any waking earlier, and on the right cycle
+//  * a co_await'ed sub-sequence runs to completion before its caller
+//    resumes, and an exception it throws reaches the caller
+//  * an exception thrown by a spawned sequence is rethrown from run(),
+//    and the other sequences complete on calling run() again
+//
+// ===================================================================
+
+#include <stdexcept>
+#include <vector>
+
+#include "VProcClass.h"
+#include "VProcCoro.h"
+#include "HarnessTest.h"
+
+// I'm node 6
+static const int node = 6;
+
+static int       errors = 0;
+
+#define CORO_WORDS              8
+#define CORO_WAITERS            8
+
+// Memory regions for the sequences
+#define CORO_BASE_A             0x6000
+#define CORO_BASE_B             0x6100
+#define CORO_BASE_SUB           0x6200
+
+// Tag of a sequence's nth write
+#define TAG(_s, _n) (((_s) << 4) | (_n))
+
+// ---------------------------------------------
+// Check a value and report a mismatch
+// ---------------------------------------------
+
+static void check (const char *what, const uint64_t got, const uint64_t exp)
+{
+    if (got != exp)
+    {
+        VPrint("***Error: %s got 0x%llx, expected 0x%llx\n", what, (unsigned long long)got, (unsigned long long)exp);
+        errors++;
+    }
+}
+
+// ---------------------------------------------
+// Sequence writing a region, recording the order
+// the writes complete, then reading it back
+// ---------------------------------------------
+
+static VProcTask writeRead (VProcCoro &vp, const unsigned seq, const unsigned base, std::vector<unsigned> *order)
+{
+    for (unsigned idx = 0; idx < CORO_WORDS; idx++)
+    {
+        co_await vp.write(base + 4*idx, base + idx);
+        order->push_back(TAG(seq, idx));
+    }
+
+    for (unsigned idx = 0; idx < CORO_WORDS; idx++)
+    {
+        unsigned data = co_await vp.read(base + 4*idx);
+
+        check("coroutine read data", data, base + idx);
+    }
+}
+
+// ---------------------------------------------
+// Sequence ticking, and recording the order and
+// cycle it woke
+// ---------------------------------------------
+
+static VProcTask waiter (VProcCoro &vp, const unsigned id, const unsigned ticks, std::vector<unsigned> *order)
+{
+    uint64_t start = vp.cycle();
+
+    co_await vp.tick(ticks);
+
+    check("tick wake cycle", vp.cycle(), start + ticks);
+    order->push_back(id);
+}
+
+// ---------------------------------------------
+// Sub-sequence, summing a region it has written
+// ---------------------------------------------
+
+static VProcTask sum (VProcCoro &vp, const unsigned base, unsigned *total)
+{
+    *total = 0;
+
+    for (unsigned idx = 0; idx < CORO_WORDS; idx++)
+    {
+        co_await vp.write(base + 4*idx, idx + 1);
+    }
+
+    for (unsigned idx = 0; idx < CORO_WORDS; idx++)
+    {
+        *total += co_await vp.read(base + 4*idx);
+    }
+}
+
+// ---------------------------------------------
+// Sub-sequence throwing after a transaction
+// ---------------------------------------------
+
+static VProcTask thrower (VProcCoro &vp)
+{
+    co_await vp.write(CORO_BASE_SUB, 0);
+    throw std::runtime_error("coroutine test");
+}
+
+// ---------------------------------------------
+// Sequence awaiting the sub-sequences
+// ---------------------------------------------
+
+static VProcTask parent (VProcCoro &vp, bool *finished)
+{
+    unsigned total  = 0;
+    bool     caught = false;
+
+    co_await sum(vp, CORO_BASE_SUB, &total);
+    check("sub-sequence total", total, CORO_WORDS * (CORO_WORDS + 1) / 2);
+
+    try
+    {
+        co_await thrower(vp);
+    }
+    catch (const std::runtime_error &e)
+    {
+        caught = true;
+    }
+
+    check("sub-sequence exception caught", caught, 1);
+
+    *finished = true;
+}
+
+// ---------------------------------------------
+// Sequence ticking, then throwing
+// ---------------------------------------------
+
+static VProcTask failer (VProcCoro &vp)
+{
+    co_await vp.tick(5);
+    throw std::runtime_error("coroutine test");
+}
+
+// ---------------------------------------------
+// MAIN ENTRY POINT FOR NODE 6
+// ---------------------------------------------
+
+extern "C" void VUserMain6 (void)
+{
+    VProc vp(node);
+
+    // Interleaved transactions of two sequences
+    {
+        VProcCoro             cvp(node);
+        std::vector<unsigned> order;
+
+        cvp.spawn(writeRead(cvp, 0, CORO_BASE_A, &order));
+        cvp.spawn(writeRead(cvp, 1, CORO_BASE_B, &order));
+        cvp.run();
+
+        check("interleaved writes", order.size(), 2 * CORO_WORDS);
+
+        for (unsigned idx = 0; idx < order.size(); idx++)
+        {
+            check("interleaved write order", order[idx], TAG(idx % 2, idx / 2));
+        }
+    }
+
+    // Wake order of ticks, with the last spawned waking first, and the rest
+    // all waking on the same cycle in the order they awaited
+    {
+        VProcCoro             cvp(node);
+        std::vector<unsigned> order;
+
+        for (unsigned id = 0; id < CORO_WAITERS; id++)
+        {
+            cvp.spawn(waiter(cvp, id, 10, &order));
+        }
+
+        cvp.spawn(waiter(cvp, CORO_WAITERS, 5, &order));
+        cvp.run();
+
+        check("tick wakes", order.size(), CORO_WAITERS + 1);
+
+        for (unsigned idx = 0; idx < order.size(); idx++)
+        {
+            check("tick wake order", order[idx], idx ? idx - 1 : CORO_WAITERS);
+        }
+    }
+
+    // Nested sub-sequences
+    {
+        VProcCoro cvp(node);
+        bool      finished = false;
+
+        cvp.spawn(parent(cvp, &finished));
+        cvp.run();
+
+        check("parent finished", finished, 1);
+    }
+
+    // Exception from a spawned sequence, rethrown from run()
+    {
+        VProcCoro             cvp(node);
+        std::vector<unsigned> order;
+        bool                  caught = false;
+
+        cvp.spawn(failer(cvp));
+        cvp.spawn(waiter(cvp, 0, 20, &order));
+
+        try
+        {
+            cvp.run();
+        }
+        catch (const std::runtime_error &e)
+        {
+            caught = true;
+        }
+
+        check("run() exception caught", caught, 1);
+        check("running after exception", cvp.running(), 1);
+
+        cvp.run();
+
+        check("running after rerun", cvp.running(), 0);
+        check("waiter after exception", order.size(), 1);
+    }
+
+    vp.write(HARNESS_RESULT_ADDR + 4*node, HARNESS_RESULT_DONE | errors);
+
+    while (1)
+    {
+        vp.tick(GO_TO_SLEEP);
+    }
+}
@@ -0,0 +1,141 @@
+// ====================================================================
+// DeltaTest.cpp                                       Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// Harness self-test user code for delta cycle command vectors
+// (VDeltaVec()), on node 7, and on node 8 with its user code in a
+// separate process (HARNESS_REMOTE_NODE). A vector of mixed writes,
+// reads and an idle command is applied, and checked for:
+//
+//  * the read data returned in the read commands, reflecting the
+//    writes earlier in the vector
+//  * the whole vector completing within the one clock cycle
+//  * the Update output toggling only for the commands without
+//    VDELTA_NOWAIT
+//  * a single exchange with the simulation for the vector, or one per
+//    command for the remote node, which falls back to exchanging each
+//    command in turn
+//
+// ===================================================================
+
+#include "VProcClass.h"
+#include "HarnessTest.h"
+
+static int errors[HARNESS_NODES];
+
+// Addresses written and read by the vector, for each node
+#define DELTA_ADDR_A(_n)        (0x7000U + 0x100U*(_n))
+#define DELTA_ADDR_B(_n)        (0x7004U + 0x100U*(_n))
+
+#define DELTA_UNREAD            0xdeadbeef
+
+// ---------------------------------------------
+// Check a value and report a mismatch
+// ---------------------------------------------
+
+static void check (const int node, const char *what, const uint64_t got, const uint64_t exp)
+{
+    if (got != exp)
+    {
+        VPrint("***Error: node %d %s got 0x%llx, expected 0x%llx\n", node, what, (unsigned long long)got,
+               (unsigned long long)exp);
+        errors[node]++;
+    }
+}
+
+// ---------------------------------------------
+// Delta vector test, common to both nodes
+// ---------------------------------------------
+
+static void deltaTest (const int node, const bool remote)
+{
+    VProc       vp(node);
+    VStats_t    before, after;
+    unsigned    upd0, upd1;
+
+    VDeltaCmd_t cmds[] = {
+        {DELTA_ADDR_A(node), 0x11,         VDELTA_WRITE | VDELTA_NOWAIT},
+        {DELTA_ADDR_B(node), 0x22,         VDELTA_WRITE},
+        {DELTA_ADDR_A(node), DELTA_UNREAD, VDELTA_READ},
+        {DELTA_ADDR_A(node), 0x33,         VDELTA_WRITE | VDELTA_NOWAIT},
+        {DELTA_ADDR_A(node), DELTA_UNREAD, VDELTA_READ},
+        {0,                  0,            0},
+        {DELTA_ADDR_B(node), DELTA_UNREAD, VDELTA_READ | VDELTA_NOWAIT}
+    };
+
+    const unsigned num    = sizeof(cmds) / sizeof(cmds[0]);
+    const unsigned nowait = 3;
+
+    vp.tick(10);
+
+    vp.read(HARNESS_UPDATE_ADDR + 4*node, &upd0);
+    vp.getStats(&before);
+
+    vp.deltaVec(cmds, num);
+
+    vp.getStats(&after);
+    vp.read(HARNESS_UPDATE_ADDR + 4*node, &upd1);
+
+    check(node, "vector read A",          cmds[2].data, 0x11);
+    check(node, "vector read A rewrite",  cmds[4].data, 0x33);
+    check(node, "vector read B",          cmds[6].data, 0x22);
+    check(node, "vector write data",      cmds[3].data, 0x33);
+
+    check(node, "vector cycle",           after.cycle, before.cycle);
+    check(node, "vector exchanges",       after.exchanges - before.exchanges, remote ? num : 1);
+
+    // The second read of the count adds its own toggle
+    check(node, "vector updates",         upd1 - upd0, num - nowait + 1);
+
+    // The last writes are visible to normal reads
+    unsigned data;
+
+    vp.read(DELTA_ADDR_A(node), &data);
+    check(node, "read A after vector",    data, 0x33);
+
+    vp.read(DELTA_ADDR_B(node), &data);
+    check(node, "read B after vector",    data, 0x22);
+
+    vp.write(HARNESS_RESULT_ADDR + 4*node, HARNESS_RESULT_DONE | errors[node]);
+
+    while (1)
+    {
+        vp.tick(GO_TO_SLEEP);
+    }
+}
+
+// ---------------------------------------------
+// MAIN ENTRY POINT FOR NODE 7
+// ---------------------------------------------
+
+extern "C" void VUserMain7 (void)
+{
+    deltaTest(7, false);
+}
+
+// ---------------------------------------------
+// MAIN ENTRY POINT FOR NODE 8
+// ---------------------------------------------
+
+extern "C" void VUserMain8 (void)
+{
+    deltaTest(HARNESS_REMOTE_NODE, true);
+}
@@ -0,0 +1,180 @@
+// ====================================================================
+// LogTest.cpp                                         Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// Harness self-test user code for buffered logging, on node 12. The
+// top level sets the log file, level (by name) and categories in the
+// environment, and these are checked with VLogEnabled(). More messages
+// than a node's ring holds are then logged, at mixed levels and
+// categories, some filtered out, followed by messages after changing
+// the level and categories at run time. Once flushed, the log file is
+// checked to hold just the messages expected, in order, each stamped
+// with the node, level, category and the cycle it was logged.
+//
+// ===================================================================
+
+#include <cstdio>
+#include <cstring>
+
+#include "VProcClass.h"
+#include "HarnessTest.h"
+
+extern "C" {
+#include "VLog.h"
+}
+
+// I'm node 12
+static const int node = 12;
+
+static int       errors = 0;
+
+// Messages logged, and debug messages logged after changing the level
+#define LOG_MSGS                (VP_LOG_SLOTS * 3)
+#define LOG_DEBUG_MSGS          10
+
+// Levels and categories of the messages, in turn, with the last two of
+// each four filtered by the level and categories in the environment
+static const unsigned level[4] = {VLOG_ERROR, VLOG_WARN, VLOG_INFO, VLOG_WARN};
+static const uint32_t cat[4]   = {0x1,        0x4,       0x1,       0x2};
+
+static const char    *name[4]  = {"ERROR", "WARN", "INFO", "DEBUG"};
+
+// ---------------------------------------------
+// Check a value and report a mismatch
+// ---------------------------------------------
+
+static void check (const char *what, const uint64_t got, const uint64_t exp)
+{
+    if (got != exp)
+    {
+        VPrint("***Error: %s got %llu, expected %llu\n", what, (unsigned long long)got, (unsigned long long)exp);
+        errors++;
+    }
+}
+
+// ---------------------------------------------
+// Check the next line of the log
+// ---------------------------------------------
+
+static void checkLine (FILE *fp, const uint64_t cycle, const unsigned lvl, const uint32_t c, const int msg)
+{
+    char               line[VP_LOG_MSG_SIZE + 64];
+    char               lname[8];
+    unsigned long long cyc;
+    unsigned           lcat;
+    int                lnode, lmsg;
+
+    if (fgets(line, sizeof(line), fp) == NULL ||
+        sscanf(line, "%llu %d %7s %x: message %d", &cyc, &lnode, lname, &lcat, &lmsg) != 5)
+    {
+        VPrint("***Error: missing or bad log line for message %d\n", msg);
+        errors++;
+        return;
+    }
+
+    check("log message",  lmsg,  msg);
+    check("log cycle",    cyc,   cycle);
+    check("log node",     lnode, node);
+    check("log category", lcat,  c);
+    check("log level",    strcmp(lname, name[lvl]) == 0, 1);
+}
+
+// ---------------------------------------------
+// MAIN ENTRY POINT FOR NODE 12
+// ---------------------------------------------
+
+extern "C" void VUserMain12 (void)
+{
+    VProc    vp(node);
+    VStats_t stats;
+    uint64_t cycle[LOG_MSGS];
+    char     line[VP_LOG_MSG_SIZE + 64];
+
+    // Settings from the environment
+    check("enabled error",          VLogEnabled(VLOG_ERROR, 0x1), 1);
+    check("enabled warn",           VLogEnabled(VLOG_WARN,  0x4), 1);
+    check("enabled info",           VLogEnabled(VLOG_INFO,  0x1), 0);
+    check("enabled category",       VLogEnabled(VLOG_WARN,  0x2), 0);
+    check("enabled category 0",     VLogEnabled(VLOG_WARN,  0),   1);
+
+    // More messages than the ring holds, at advancing cycles
+    for (int msg = 0; msg < LOG_MSGS; msg++)
+    {
+        if (msg % 100 == 0)
+        {
+            vp.tick(1);
+        }
+
+        vp.getStats(&stats);
+        cycle[msg] = stats.cycle;
+
+        VLog(node, level[msg % 4], cat[msg % 4], "message %d\n", msg);
+    }
+
+    // Debug messages of category 0 only
+    VLogSetLevel(VLOG_DEBUG);
+    VLogSetCats(0);
+
+    vp.tick(1);
+    vp.getStats(&stats);
+
+    for (int msg = 0; msg < LOG_DEBUG_MSGS; msg++)
+    {
+        VLog(node, VLOG_DEBUG, 0,   "message %d", LOG_MSGS + msg);
+        VLog(node, VLOG_DEBUG, 0x1, "message %d", -1);
+    }
+
+    VLogFlush();
+
+    FILE *fp = fopen(HARNESS_VLOG_FILE, "r");
+
+    if (fp == NULL)
+    {
+        VPrint("***Error: failed to open %s\n", HARNESS_VLOG_FILE);
+        errors++;
+    }
+    else
+    {
+        for (int msg = 0; msg < LOG_MSGS; msg++)
+        {
+            if (msg % 4 < 2)
+            {
+                checkLine(fp, cycle[msg], level[msg % 4], cat[msg % 4], msg);
+            }
+        }
+
+        for (int msg = 0; msg < LOG_DEBUG_MSGS; msg++)
+        {
+            checkLine(fp, stats.cycle, VLOG_DEBUG, 0, LOG_MSGS + msg);
+        }
+
+        check("log end", fgets(line, sizeof(line), fp) == NULL, 1);
+
+        fclose(fp);
+    }
+
+    vp.write(HARNESS_RESULT_ADDR + 4*node, HARNESS_RESULT_DONE | errors);
+
+    while (1)
+    {
+        vp.tick(GO_TO_SLEEP);
+    }
+}
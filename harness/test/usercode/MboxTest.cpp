@@ -0,0 +1,207 @@
+// ====================================================================
+// MboxTest.cpp                                        Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// Harness self-test user code for mailboxes and barriers, on nodes 1
+// to 3. Node 1 fills a mailbox that node 2 doesn't start to empty
+// until MBOX_RECV_CYCLE, so node 1 is parked while it's full, and
+// node 3 waits on an empty mailbox that node 1 doesn't send to until
+// MBOX_SEND_CYCLE. All three then meet at a barrier, with node 3
+// arriving last, at MBOX_BARRIER_CYCLE.
+//
+// ===================================================================
+
+#include "VProcClass.h"
+#include "HarnessTest.h"
+
+// Mailboxes and barrier used
+#define MBOX_FULL               0
+#define MBOX_EMPTY              1
+#define MBOX_TRY                2
+#define MBOX_BARRIER            0
+
+// Cycles at which the tests start their waiting operations
+#define MBOX_RECV_CYCLE         500
+#define MBOX_SEND_CYCLE         1000
+#define MBOX_BARRIER_CYCLE      1500
+
+// Messages sent to the full mailbox
+#define MBOX_NUM_MSGS           (VMBOX_DEPTH + 8)
+
+static int      errors[4];
+
+// Cycle at which node 3 arrived at the barrier
+static uint64_t lastArrival;
+
+// ---------------------------------------------
+// Check a value and report a mismatch
+// ---------------------------------------------
+
+static void check (const int node, const char *what, const uint64_t got, const uint64_t exp)
+{
+    if (got != exp)
+    {
+        VPrint("***Error: node %d %s got %llu, expected %llu\n", node, what, (unsigned long long)got, (unsigned long long)exp);
+        errors[node]++;
+    }
+}
+
+// ---------------------------------------------
+// Get a node's current cycle
+// ---------------------------------------------
+
+static uint64_t cycle (VProc &vp)
+{
+    VStats_t stats;
+
+    vp.getStats(&stats);
+
+    return stats.cycle;
+}
+
+// ---------------------------------------------
+// Tick until a node reaches a given cycle
+// ---------------------------------------------
+
+static void waitUntil (VProc &vp, const uint64_t cyc)
+{
+    uint64_t now = cycle(vp);
+
+    if (now < cyc)
+    {
+        vp.tick(cyc - now);
+    }
+}
+
+// ---------------------------------------------
+// Meet at the barrier, checking the release
+// cycle, then report the node's result
+// ---------------------------------------------
+
+static void finish (VProc &vp, const int node)
+{
+    uint64_t release = vp.barrier(MBOX_BARRIER, 3);
+
+    // Nodes parked at the barrier are released within a cycle of
+    // the last arrival
+    check(node, "barrier release", release >= lastArrival && release <= lastArrival + 1, 1);
+    check(node, "barrier cycle", cycle(vp), release);
+
+    vp.write(HARNESS_RESULT_ADDR + 4*node, HARNESS_RESULT_DONE | errors[node]);
+
+    while (1)
+    {
+        vp.tick(GO_TO_SLEEP);
+    }
+}
+
+// ---------------------------------------------
+// MAIN ENTRY POINT FOR NODE 1
+// ---------------------------------------------
+
+extern "C" void VUserMain1 (void)
+{
+    VProc vp(1);
+
+    // Fill the mailbox, then send more, parking until node 2 receives
+    for (int idx = 0; idx < MBOX_NUM_MSGS; idx++)
+    {
+        vp.mboxSend(MBOX_FULL, idx);
+
+        if (idx == VMBOX_DEPTH - 1)
+        {
+            check(1, "parked before full", cycle(vp) < MBOX_RECV_CYCLE, 1);
+        }
+    }
+    check(1, "parked while full", cycle(vp) >= MBOX_RECV_CYCLE, 1);
+
+    // Send to the empty mailbox node 3 is waiting on
+    waitUntil(vp, MBOX_SEND_CYCLE);
+    vp.mboxSend(MBOX_EMPTY, 0x1234);
+
+    finish(vp, 1);
+}
+
+// ---------------------------------------------
+// MAIN ENTRY POINT FOR NODE 2
+// ---------------------------------------------
+
+extern "C" void VUserMain2 (void)
+{
+    VProc      vp(2);
+    VMboxMsg_t msg;
+
+    // Empty the full mailbox. The messages sent once node 1 was parked
+    // are stamped after the receiving started.
+    waitUntil(vp, MBOX_RECV_CYCLE);
+
+    for (int idx = 0; idx < MBOX_NUM_MSGS; idx++)
+    {
+        vp.mboxRecv(MBOX_FULL, &msg);
+
+        check(2, "full mailbox data", msg.data, idx);
+        check(2, "full mailbox source", msg.src, 1);
+        check(2, "full mailbox stamp", idx < VMBOX_DEPTH ? msg.cycle < MBOX_RECV_CYCLE : msg.cycle >= MBOX_RECV_CYCLE, 1);
+    }
+
+    finish(vp, 2);
+}
+
+// ---------------------------------------------
+// MAIN ENTRY POINT FOR NODE 3
+// ---------------------------------------------
+
+extern "C" void VUserMain3 (void)
+{
+    VProc      vp(3);
+    VMboxMsg_t msg;
+    int        sent = 0;
+
+    // Wait on the empty mailbox until node 1 sends
+    vp.mboxRecv(MBOX_EMPTY, &msg);
+
+    check(3, "empty mailbox data", msg.data, 0x1234);
+    check(3, "empty mailbox source", msg.src, 1);
+    check(3, "empty mailbox stamp", msg.cycle >= MBOX_SEND_CYCLE, 1);
+    check(3, "parked while empty", cycle(vp) >= msg.cycle, 1);
+
+    // Non-blocking calls fail, rather than park, when empty or full
+    check(3, "try receive empty", VMboxTryRecv(MBOX_TRY, &msg, 3), 0);
+
+    while (VMboxTrySend(MBOX_TRY, sent, 3))
+    {
+        sent++;
+    }
+    check(3, "try send full", sent, VMBOX_DEPTH);
+
+    for (int idx = 0; idx < VMBOX_DEPTH; idx++)
+    {
+        check(3, "try receive", VMboxTryRecv(MBOX_TRY, &msg, 3), 1);
+        check(3, "try receive data", msg.data, idx);
+    }
+    check(3, "try receive emptied", VMboxTryRecv(MBOX_TRY, &msg, 3), 0);
+
+    // Be the last to arrive at the barrier
+    waitUntil(vp, MBOX_BARRIER_CYCLE);
+    lastArrival = cycle(vp);
+
+    finish(vp, 3);
+}
@@ -0,0 +1,225 @@
+// ====================================================================
+// QueueTest.cpp                                       Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// Harness self-test user code for transaction queue arbitration, on
+// node 4. Three clients, A, B and C, with priorities 2, 0 and 1, write
+// a tag for each transaction to the harness log address, and the
+// logged order is checked for each policy.
+//
+// For the FIFO, round robin and priority policies, all the requests
+// are queued before node 4 starts serving. For the VQUEUE_SYNC tests,
+// each client is a thread making blocking writes after different
+// delays, which would change the order without VQUEUE_SYNC.
+//
+// The clients get numbers 0 to 2 in the order opened, and the round
+// robin orders follow from the last client served by the previous
+// test.
+//
+// ===================================================================
+
+#include <atomic>
+#include <thread>
+#include <unistd.h>
+
+#include "VProcClass.h"
+#include "HarnessTest.h"
+
+extern "C" {
+#include "VQueue.h"
+}
+
+// I'm node 4
+static const int node = 4;
+
+static int       errors = 0;
+
+// Client priorities, and delays before each write in the sync tests
+static const unsigned prio[3]  = {2, 0, 1};
+static const unsigned delay[3] = {0, 2000, 1000};
+
+// Transaction tag of a client's nth request
+#define TAG(_c, _n) (((_c) << 4) | (_n))
+
+// ---------------------------------------------
+// Check a value and report a mismatch
+// ---------------------------------------------
+
+static void check (const char *what, const unsigned got, const unsigned exp)
+{
+    if (got != exp)
+    {
+        VPrint("***Error: %s got 0x%08x, expected 0x%08x\n", what, got, exp);
+        errors++;
+    }
+}
+
+// ---------------------------------------------
+// Queue all the requests of three clients, then
+// close them, waiting until they're served
+// ---------------------------------------------
+
+static void preload (std::atomic<int> *loaded)
+{
+    static const int num[3] = {3, 2, 3};
+    VQueueReq_t      req[3][3];
+    int              client[3];
+
+    for (int c = 0; c < 3; c++)
+    {
+        client[c] = VQueueOpen(prio[c], node);
+    }
+
+    for (int c = 0; c < 3; c++)
+    {
+        for (int n = 0; n < num[c]; n++)
+        {
+            req[c][n].op    = VQUEUE_OP_WRITE;
+            req[c][n].addr  = HARNESS_LOG_ADDR;
+            req[c][n].data  = TAG(c, n);
+            req[c][n].delta = 0;
+
+            VQueueSubmit(client[c], &req[c][n]);
+        }
+    }
+
+    *loaded = 1;
+
+    for (int c = 0; c < 3; c++)
+    {
+        VQueueClose(client[c]);
+    }
+}
+
+// ---------------------------------------------
+// Sync test client thread
+// ---------------------------------------------
+
+static void syncClient (const int client, const int c)
+{
+    for (int n = 0; n < 4; n++)
+    {
+        usleep(delay[c]);
+        VQueueWrite(client, HARNESS_LOG_ADDR, TAG(c, n), 0);
+    }
+
+    VQueueClose(client);
+}
+
+// ---------------------------------------------
+// Check the order logged since a test started
+// ---------------------------------------------
+
+static void checkOrder (VProc &vp, const char *what, const unsigned start, const unsigned *exp, const unsigned len)
+{
+    unsigned data;
+
+    vp.read(HARNESS_LOG_ADDR, &data);
+    check(what, data - start, len);
+
+    for (unsigned idx = 0; idx < len && start + idx < data; idx++)
+    {
+        vp.read(HARNESS_LOG_ADDR + 4*(start + idx + 1), &data);
+        check(what, data, exp[idx]);
+    }
+}
+
+// ---------------------------------------------
+// Serve preloaded requests by a policy
+// ---------------------------------------------
+
+static void runPreload (VProc &vp, const char *what, const int policy, const unsigned *exp)
+{
+    std::atomic<int> loaded(0);
+    unsigned         start;
+
+    vp.read(HARNESS_LOG_ADDR, &start);
+
+    std::thread t(preload, &loaded);
+
+    while (!loaded)
+    {
+        std::this_thread::yield();
+    }
+
+    check(what, VQueueServe(policy, node), 8);
+    t.join();
+
+    checkOrder(vp, what, start, exp, 8);
+}
+
+// ---------------------------------------------
+// Serve client threads by a policy with
+// VQUEUE_SYNC
+// ---------------------------------------------
+
+static void runSync (VProc &vp, const char *what, const int policy, const unsigned *exp)
+{
+    std::thread t[3];
+    unsigned    start;
+
+    vp.read(HARNESS_LOG_ADDR, &start);
+
+    // Open all the clients before serving starts
+    for (int c = 0; c < 3; c++)
+    {
+        t[c] = std::thread(syncClient, VQueueOpen(prio[c], node), c);
+    }
+
+    check(what, VQueueServe(policy | VQUEUE_SYNC, node), 12);
+
+    for (int c = 0; c < 3; c++)
+    {
+        t[c].join();
+    }
+
+    checkOrder(vp, what, start, exp, 12);
+}
+
+// ---------------------------------------------
+// MAIN ENTRY POINT FOR NODE 4
+// ---------------------------------------------
+
+extern "C" void VUserMain4 (void)
+{
+    VProc vp(node);
+
+    static const unsigned fifo[8]      = {TAG(0,0), TAG(0,1), TAG(0,2), TAG(1,0), TAG(1,1), TAG(2,0), TAG(2,1), TAG(2,2)};
+    static const unsigned priority[8]  = {TAG(1,0), TAG(1,1), TAG(2,0), TAG(2,1), TAG(2,2), TAG(0,0), TAG(0,1), TAG(0,2)};
+    static const unsigned rr[8]        = {TAG(1,0), TAG(2,0), TAG(0,0), TAG(1,1), TAG(2,1), TAG(0,1), TAG(2,2), TAG(0,2)};
+    static const unsigned syncrr[12]   = {TAG(1,0), TAG(2,0), TAG(0,0), TAG(1,1), TAG(2,1), TAG(0,1),
+                                          TAG(1,2), TAG(2,2), TAG(0,2), TAG(1,3), TAG(2,3), TAG(0,3)};
+    static const unsigned syncprio[12] = {TAG(1,0), TAG(1,1), TAG(1,2), TAG(1,3), TAG(2,0), TAG(2,1),
+                                          TAG(2,2), TAG(2,3), TAG(0,0), TAG(0,1), TAG(0,2), TAG(0,3)};
+
+    runPreload(vp, "FIFO order",         VQUEUE_ARB_FIFO,     fifo);
+    runPreload(vp, "priority order",     VQUEUE_ARB_PRIORITY, priority);
+    runPreload(vp, "round robin order",  VQUEUE_ARB_RR,       rr);
+    runSync   (vp, "sync round robin",   VQUEUE_ARB_RR,       syncrr);
+    runSync   (vp, "sync priority",      VQUEUE_ARB_PRIORITY, syncprio);
+
+    vp.write(HARNESS_RESULT_ADDR + 4*node, HARNESS_RESULT_DONE | errors);
+
+    while (1)
+    {
+        vp.tick(GO_TO_SLEEP);
+    }
+}
@@ -0,0 +1,137 @@
+// ====================================================================
+// ReplayTest.cpp                                      Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// Harness self-test user code for record and replay, on node 10
+// (HARNESS_REPLAY_NODE). A repeatable mix of word, byte, burst and
+// delta cycle accesses, with ticks between them, is checked as it
+// runs. "make run" records the node's commands on the first run of the
+// harness, and replays them on the second, when this code is not run
+// and the top level checks the replayed reads returned the recorded
+// data, with every command issued on its recorded cycle.
+//
+// ===================================================================
+
+#include "VProcClass.h"
+#include "HarnessTest.h"
+
+static int       errors = 0;
+
+#define REPLAY_BASE             0xa000
+#define REPLAY_WORDS            64
+#define REPLAY_BURST            32
+
+// ---------------------------------------------
+// Check a value and report a mismatch
+// ---------------------------------------------
+
+static void check (const char *what, const unsigned got, const unsigned exp)
+{
+    if (got != exp)
+    {
+        VPrint("***Error: %s got 0x%08x, expected 0x%08x\n", what, got, exp);
+        errors++;
+    }
+}
+
+// ---------------------------------------------
+// Repeatable pseudo-random numbers
+// ---------------------------------------------
+
+static unsigned next (unsigned &seed)
+{
+    seed = seed * 1664525 + 1013904223;
+
+    return seed;
+}
+
+// ---------------------------------------------
+// MAIN ENTRY POINT FOR NODE 10
+// ---------------------------------------------
+
+extern "C" void VUserMain10 (void)
+{
+    VProc    vp(HARNESS_REPLAY_NODE);
+    unsigned seed = 0x1234;
+    unsigned exp[REPLAY_WORDS];
+    unsigned buf[REPLAY_BURST];
+    unsigned data;
+
+    // Words written, with random gaps, and read back in reverse
+    for (int idx = 0; idx < REPLAY_WORDS; idx++)
+    {
+        exp[idx] = next(seed);
+        vp.write(REPLAY_BASE + 4*idx, exp[idx]);
+        vp.tick(next(seed) % 4);
+    }
+
+    for (int idx = REPLAY_WORDS - 1; idx >= 0; idx--)
+    {
+        vp.read(REPLAY_BASE + 4*idx, &data);
+        check("replay word read", data, exp[idx]);
+    }
+
+    // Bytes written into the first word
+    for (int idx = 0; idx < 4; idx++)
+    {
+        vp.writeByte(REPLAY_BASE + idx, 0x10 + idx);
+    }
+
+    vp.read(REPLAY_BASE, &data);
+    check("replay byte writes", data, 0x13121110);
+
+    // A burst over the words, read back
+    for (int idx = 0; idx < REPLAY_BURST; idx++)
+    {
+        buf[idx] = exp[idx] ^ 0xffffffff;
+    }
+
+    vp.burstWrite(REPLAY_BASE, buf, REPLAY_BURST);
+
+    for (int idx = 0; idx < REPLAY_BURST; idx++)
+    {
+        buf[idx] = 0;
+    }
+
+    vp.burstRead(REPLAY_BASE, buf, REPLAY_BURST);
+
+    for (int idx = 0; idx < REPLAY_BURST; idx++)
+    {
+        check("replay burst read", buf[idx], exp[idx] ^ 0xffffffff);
+    }
+
+    // Delta cycle write and read, then a normal read
+    vp.write(REPLAY_BASE, 0x5a5a5a5a, 1);
+    vp.read(REPLAY_BASE, &data, 1);
+    check("replay delta read", data, 0x5a5a5a5a);
+
+    vp.tick(20);
+
+    vp.read(REPLAY_BASE + 4*(REPLAY_WORDS - 1), &data);
+    check("replay last word", data, exp[REPLAY_WORDS - 1]);
+
+    vp.write(HARNESS_RESULT_ADDR + 4*HARNESS_REPLAY_NODE, HARNESS_RESULT_DONE | errors);
+
+    while (1)
+    {
+        vp.tick(GO_TO_SLEEP);
+    }
+}
@@ -0,0 +1,144 @@
+// ====================================================================
+// RestartTest.cpp                                     Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// Harness self-test user code for restarting a node at a sequence of
+// test entry points, on node 9 (HARNESS_RESTART_NODE). The test list,
+// from VPROC_TESTS (or a +VPROC_TESTS argument), is RestartTestA then
+// RestartTestB, and RestartTestA sets RestartTestC to run next with
+// VRestart(), so the entry points are expected to run in the order
+// A, C, B. Each checks it runs in its turn, that the node's reset
+// output was pulsed for HARNESS_TEST_RESET cycles before it was
+// entered (other than the first), and that an interrupt callback
+// registered by the previous entry point has been cleared.
+//
+// ===================================================================
+
+#include "VProcClass.h"
+#include "HarnessTest.h"
+
+extern "C" {
+#include "VRestart.h"
+}
+
+static int       errors  = 0;
+
+// Number of entry points run, and the cycle the last returned
+static int       entered = 0;
+static uint64_t  lastEnd = 0;
+
+// ---------------------------------------------
+// Check a value and report a mismatch
+// ---------------------------------------------
+
+static void check (const char *what, const uint64_t got, const uint64_t exp)
+{
+    if (got != exp)
+    {
+        VPrint("***Error: %s got %llu, expected %llu\n", what, (unsigned long long)got, (unsigned long long)exp);
+        errors++;
+    }
+}
+
+// ---------------------------------------------
+// Interrupt callback, which should not survive
+// a restart
+// ---------------------------------------------
+
+static int irqCb (int irq)
+{
+    return 0;
+}
+
+// ---------------------------------------------
+// Checks on entering an entry point
+// ---------------------------------------------
+
+static void enter (VProc &vp, const char *what, const int order)
+{
+    VStats_t stats;
+    unsigned resets;
+
+    vp.getStats(&stats);
+    vp.read(HARNESS_RESET_ADDR + 4*HARNESS_RESTART_NODE, &resets);
+
+    check(what, entered, order);
+    check("irq callback cleared", ns[HARNESS_RESTART_NODE]->VUserIrqCB == NULL, 1);
+    check("reset cycles", resets, order * HARNESS_TEST_RESET);
+
+    // The reset pulse is the only thing between the entry points
+    if (order)
+    {
+        check("restart cycle", stats.cycle - lastEnd, HARNESS_TEST_RESET);
+    }
+
+    entered++;
+}
+
+// ---------------------------------------------
+// Actions on leaving an entry point
+// ---------------------------------------------
+
+static void leave (VProc &vp)
+{
+    VStats_t stats;
+
+    vp.regIrq(irqCb);
+    vp.tick(10);
+
+    vp.getStats(&stats);
+    lastEnd = stats.cycle;
+}
+
+// ---------------------------------------------
+// TEST ENTRY POINTS FOR NODE 9
+// ---------------------------------------------
+
+extern "C" void RestartTestC (int node);
+
+extern "C" void RestartTestA (int node)
+{
+    VProc vp(node);
+
+    enter(vp, "RestartTestA order", 0);
+
+    VRestart(node, RestartTestC);
+
+    leave(vp);
+}
+
+extern "C" void RestartTestC (int node)
+{
+    VProc vp(node);
+
+    enter(vp, "RestartTestC order", 1);
+    leave(vp);
+}
+
+extern "C" void RestartTestB (int node)
+{
+    VProc vp(node);
+
+    enter(vp, "RestartTestB order", 2);
+
+    // Return to be retired by VRestartRun()
+    vp.write(HARNESS_RESULT_ADDR + 4*node, HARNESS_RESULT_DONE | errors);
+}
@@ -0,0 +1,177 @@
+// ====================================================================
+// StreamTest.cpp                                      Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// Harness self-test user code for file streaming, on node 11. A file
+// of more than the stream's ring of buffers, and not a whole number of
+// words, is streamed into memory and back out to a second file, which
+// is checked to match. The bytes and bursts of each stream are checked,
+// and the partial last word is checked to have been written with byte
+// enables.
+//
+// ===================================================================
+
+#include <cstdio>
+#include <unistd.h>
+
+#include "VProcClass.h"
+#include "HarnessTest.h"
+
+extern "C" {
+#include "VStream.h"
+}
+
+// I'm node 11
+static const int node = 11;
+
+static int       errors = 0;
+
+#define STREAM_IN_FILE          "stream_in.bin"
+#define STREAM_OUT_FILE         "stream_out.bin"
+
+#define STREAM_ADDR             0x01000000
+#define STREAM_BURST            256
+
+// One more than the ring of buffers, and a partial word
+#define STREAM_BUF_BYTES        (VP_STREAM_BUF_WORDS * 4)
+#define STREAM_BYTES            ((VP_STREAM_BUFFERS + 1) * STREAM_BUF_BYTES + 3)
+#define STREAM_WORDS            ((STREAM_BYTES + 3) / 4)
+#define STREAM_BURSTS           ((VP_STREAM_BUFFERS + 1) * (STREAM_BUF_BYTES / (STREAM_BURST * 4)) + 1)
+
+// ---------------------------------------------
+// Check a value and report a mismatch
+// ---------------------------------------------
+
+static void check (const char *what, const uint64_t got, const uint64_t exp)
+{
+    if (got != exp)
+    {
+        VPrint("***Error: %s got 0x%llx, expected 0x%llx\n", what, (unsigned long long)got, (unsigned long long)exp);
+        errors++;
+    }
+}
+
+// ---------------------------------------------
+// Byte of the input file at an offset
+// ---------------------------------------------
+
+static uint8_t fileByte (const uint64_t off)
+{
+    return (uint8_t)((off * 131) ^ (off >> 8));
+}
+
+// ---------------------------------------------
+// Word of the input file at an offset, with
+// bytes past the end of the file all ones
+// ---------------------------------------------
+
+static unsigned fileWord (const uint64_t off)
+{
+    unsigned word = 0;
+
+    for (int idx = 3; idx >= 0; idx--)
+    {
+        word = (word << 8) | (off + idx < STREAM_BYTES ? fileByte(off + idx) : 0xff);
+    }
+
+    return word;
+}
+
+// ---------------------------------------------
+// MAIN ENTRY POINT FOR NODE 11
+// ---------------------------------------------
+
+extern "C" void VUserMain11 (void)
+{
+    VProc          vp(node);
+    VStreamStats_t stats;
+    FILE*          fp;
+    unsigned       data;
+    int            ch;
+    uint64_t       off;
+
+    if ((fp = fopen(STREAM_IN_FILE, "wb")) == NULL)
+    {
+        VPrint("***Error: failed to create %s\n", STREAM_IN_FILE);
+        exit(1);
+    }
+
+    for (off = 0; off < STREAM_BYTES; off++)
+    {
+        fputc(fileByte(off), fp);
+    }
+
+    fclose(fp);
+
+    // The top byte of the partial last word is not to be written
+    vp.write(STREAM_ADDR + 4*(STREAM_WORDS - 1), 0xffffffff);
+
+    // File to memory, with the whole file streamed
+    check("file to addr bytes", VStreamFileToAddr(STREAM_IN_FILE, STREAM_ADDR, 4, 0, STREAM_BURST, node), STREAM_BYTES);
+
+    VStreamGetStats(&stats, node);
+    check("file to addr stats bytes",  stats.bytes,  STREAM_BYTES);
+    check("file to addr stats bursts", stats.bursts, STREAM_BURSTS);
+
+    vp.read(STREAM_ADDR, &data);
+    check("first word", data, fileWord(0));
+
+    off = 4*(STREAM_WORDS - 1);
+    vp.read(STREAM_ADDR + off, &data);
+    check("partial last word", data, fileWord(off));
+
+    // Memory to file, and compared with the original
+    check("addr to file bytes", VStreamAddrToFile(STREAM_OUT_FILE, STREAM_ADDR, 4, STREAM_BYTES, STREAM_BURST, node),
+          STREAM_BYTES);
+
+    VStreamGetStats(&stats, node);
+    check("addr to file stats bytes",  stats.bytes,  STREAM_BYTES);
+    check("addr to file stats bursts", stats.bursts, STREAM_BURSTS);
+
+    if ((fp = fopen(STREAM_OUT_FILE, "rb")) == NULL)
+    {
+        VPrint("***Error: failed to open %s\n", STREAM_OUT_FILE);
+        exit(1);
+    }
+
+    for (off = 0; (ch = fgetc(fp)) != EOF; off++)
+    {
+        if (ch != fileByte(off))
+        {
+            check("streamed file byte", ch, fileByte(off));
+            break;
+        }
+    }
+
+    fclose(fp);
+
+    check("streamed file length", off, STREAM_BYTES);
+
+    unlink(STREAM_IN_FILE);
+    unlink(STREAM_OUT_FILE);
+
+    vp.write(HARNESS_RESULT_ADDR + 4*node, HARNESS_RESULT_DONE | errors);
+
+    while (1)
+    {
+        vp.tick(GO_TO_SLEEP);
+    }
+}
@@ -0,0 +1,164 @@
+// ====================================================================
+// VUserMain0.cpp                                      Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+// ===================================================================
+//
+// Harness self-test user code. Checks word, byte, burst and delta
+// cycle accesses, tick timing and interrupts against the harness
+// memory, then measures transaction rate. The results of the other
+// nodes' tests are then collected, and the total number of errors is
+// written to the finish address to end the run.
+//
+// ===================================================================
+
+#include <cstdio>
+#include <ctime>
+
+#include "VProcClass.h"
+#include "HarnessTest.h"
+
+// I'm node 0
+static const int node = 0;
+
+static int       errors  = 0;
+static volatile  int irqSeen = 0;
+
+// ---------------------------------------------
+// Check a value and report a mismatch
+// ---------------------------------------------
+
+static void check (const char *what, const unsigned got, const unsigned exp)
+{
+    if (got != exp)
+    {
+        VPrint("***Error: %s got 0x%08x, expected 0x%08x\n", what, got, exp);
+        errors++;
+    }
+}
+
+// ---------------------------------------------
+// Interrupt callback
+// ---------------------------------------------
+
+static int irqCb (int irq)
+{
+    if (irq)
+    {
+        irqSeen = irqSeen + 1;
+    }
+
+    return 0;
+}
+
+// ---------------------------------------------
+// MAIN ENTRY POINT FOR NODE 0
+// ---------------------------------------------
+
+extern "C" void VUserMain0 (void)
+{
+    VProc    vp(node);
+    VStats_t stats;
+    unsigned data;
+    uint32_t wbuf[64], rbuf[64];
+    uint64_t cyc;
+
+    vp.regIrq(irqCb);
+
+    // Single words
+    vp.write(0x1000, 0x12345678);
+    vp.read (0x1000, &data);
+    check("word read", data, 0x12345678);
+
+    // Byte enables
+    vp.writeByte(0x1002, 0xab);
+    vp.readByte (0x1002, &data);
+    check("byte read", data, 0xab);
+    vp.read (0x1000, &data);
+    check("byte merge", data, 0x12ab5678);
+
+    // Bursts (the write buffer is overwritten with the sampled input data)
+    for (int idx = 0; idx < 64; idx++)
+    {
+        wbuf[idx] = 0xa5000000 | idx;
+    }
+    vp.burstWrite(0x2000, wbuf, 64);
+    vp.burstRead (0x2000, rbuf, 64);
+    for (int idx = 0; idx < 64; idx++)
+    {
+        check("burst read", rbuf[idx], 0xa5000000 | idx);
+    }
+
+    // Delta cycle accesses take no clock cycles
+    vp.getStats(&stats); cyc = stats.cycle;
+    vp.write(0x3000, 0xcafef00d, 1);
+    vp.read (0x3000, &data, 1);
+    vp.getStats(&stats);
+    check("delta read", data, 0xcafef00d);
+    check("delta cycles", (unsigned)(stats.cycle - cyc), 0);
+
+    // Tick timing
+    vp.getStats(&stats); cyc = stats.cycle;
+    vp.tick(100);
+    vp.getStats(&stats);
+    check("tick cycles", (unsigned)(stats.cycle - cyc), 100);
+
+    // Wait for the interrupt the harness raises at HARNESS_IRQ_CYCLE
+    while (!irqSeen && stats.cycle < 2 * HARNESS_IRQ_CYCLE)
+    {
+        vp.tick(10);
+        vp.getStats(&stats);
+    }
+    check("interrupt", irqSeen, 1);
+
+    // Transaction rate
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int idx = 0; idx < HARNESS_RATE_ITERS; idx++)
+    {
+        vp.write((idx << 2) & 0xffc, idx);
+        vp.read ((idx << 2) & 0xffc, &data);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    double secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    VPrint("%d transactions in %.3f secs (%.0f txns/sec)\n", 2 * HARNESS_RATE_ITERS, secs, 2 * HARNESS_RATE_ITERS / secs);
+
+    // Collect the other nodes' results
+    for (int n = 1; n < HARNESS_NODES; n++)
+    {
+        do
+        {
+            vp.tick(100);
+            vp.read(HARNESS_RESULT_ADDR + 4*n, &data);
+        }
+        while (!(data & HARNESS_RESULT_DONE));
+
+        errors += data & ~HARNESS_RESULT_DONE;
+    }
+
+    VPrint("%s: %d error%s\n", errors ? "FAIL" : "PASS", errors, errors == 1 ? "" : "s");
+
+    vp.write(HARNESS_FINISH_ADDR, errors);
+
+    while (1)
+    {
+        vp.tick(GO_TO_SLEEP);
+    }
+}
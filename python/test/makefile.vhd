@@ -67,7 +67,22 @@ endif
 
 # VPROC C source code
 VPROC_C            = VSched.c \
-                     VUser.c
+                     VUser.c  \
+                     VStats.c \
+                     VTrace.c \
+                     VTimeline.c \
+                     VLive.c     \
+                     VRemote.c   \
+                     VBridge.c   \
+                     VReplay.c   \
+                     VStream.c   \
+                     VRestart.c  \
+                     VLog.c      \
+                     VCheck.c    \
+                     VProcVpi.c  \
+                     VSignal.c   \
+                     VMbox.c     \
+                     VQueue.c
 
 # Python interface C code compiled into PyVProc.so
 PYTHON_C           = PythonVProc.c
@@ -0,0 +1,97 @@
+//=====================================================================
+//
+// VRemoteMain.c                                      Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Top level for user code running in a separate process from the
+// simulation. Attaches to the segments of the given nodes, created
+// by a simulation run with VPROC_REMOTE set, and runs VUserMainX
+// for each in its own thread, as VProc would in the simulation.
+//
+// Usage: <prog> [-p <prefix>] <node> [<node> ...]
+//
+// The prefix defaults to the value of VPROC_REMOTE.
+//
+//=====================================================================
+
+#include <string.h>
+#include <unistd.h>
+#include "VProc.h"
+#include "VUser.h"
+
+// Node state, as defined in VSched.c for the simulation
+pSchedState_t ns[VP_MAX_NODES];
+
+int main (int argc, char **argv)
+{
+    char *prefix = getenv(VREMOTE_ENV);
+    int   opt, nodes = 0;
+
+    while ((opt = getopt(argc, argv, "p:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'p':
+            prefix = optarg;
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-p <prefix>] <node> [<node> ...]\n", argv[0]);
+            exit(opt == 'h' ? 0 : 1);
+        }
+    }
+
+    if (prefix == NULL || prefix[0] == '\0')
+    {
+        VPrint("***Error: no segment prefix given with -p or %s\n", VREMOTE_ENV);
+        exit(1);
+    }
+
+    for (int idx = optind; idx < argc; idx++)
+    {
+        int node = atoi(argv[idx]);
+
+        if (node < 0 || node >= VP_MAX_NODES || ns[node] != NULL)
+        {
+            VPrint("***Error: bad or repeated node number %s\n", argv[idx]);
+            exit(1);
+        }
+
+        ns[node] = (pSchedState_t) calloc(1, sizeof(SchedState_t));
+
+        VStatsInit(node);
+
+        if (VRemoteConnect(node, prefix))
+        {
+            exit(1);
+        }
+
+        nodes++;
+    }
+
+    if (nodes == 0)
+    {
+        VPrint("***Error: no nodes specified\n");
+        exit(1);
+    }
+
+    // User threads run until the simulation ends
+    pthread_exit(NULL);
+}
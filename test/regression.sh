@@ -53,7 +53,7 @@ echo "" | tee -a $LOGFILE
 echo "============ C/C++ regression tests ============" $'\n' | tee -a $LOGFILE
 for usrcode in usercode usercodeIrq
 do
-  for mkfile in $MKFILEBASE "makefile HDL=VHDL" makefile.verilator
+  for mkfile in $MKFILEBASE "makefile HDL=VHDL" "makefile.ica VPITRANS=1" makefile.verilator
   do
    echo "Running $mkfile with $usrcode/ ..." | tee -a $LOGFILE
    make -f $mkfile clean
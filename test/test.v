@@ -74,6 +74,17 @@ wire          VPRD0;
 wire          VPRD1;
 wire  [1:0]   Update;
 
+// Sideband signals for node 1, with SigSet set by the user code, and
+// SigLoop its value looped back a clock cycle later
+`ifdef VPROC_SIGNAL_IF
+wire [31:0]   SigSet;
+wire [31:0]   SigIn  [0:1];
+wire [31:0]   SigOut [0:1];
+`else
+reg  [31:0]   SigSet;
+`endif
+reg  [31:0]   SigLoop;
+
 // ---------------------------------------------------------
 // Combinatorial logic
 // ---------------------------------------------------------
@@ -156,6 +167,26 @@ assign VPBE1 = 4'hf;
             .Node               (1)
            );
 
+ // ---------------------------------------------------------
+ // Sideband signals for node 1, with DPI-C, with SigSet at
+ // index 0 and SigLoop at index 1. (With VPI the user code
+ // registers the signals by name.)
+ // ---------------------------------------------------------
+
+`ifdef VPROC_SIGNAL_IF
+ assign SigSet    = SigOut[0];
+ assign SigIn[0]  = SigSet;
+ assign SigIn[1]  = SigLoop;
+
+ VProcSignal #(.NUM_SIGNALS     (2),
+               .NODE_WIDTH      (`NODEWIDTH)
+              ) vs1
+              (.SigIn           (SigIn),
+               .SigOut          (SigOut),
+               .Node            (1)
+              );
+`endif
+
  // ---------------------------------------------------------
  // Memory
  // ---------------------------------------------------------
@@ -186,6 +217,10 @@ begin
     Interrupt0  = 0;
     Interrupt1  = 0;
     Seed        = 32'h00250864;
+    SigLoop     = 0;
+`ifndef VPROC_SIGNAL_IF
+    SigSet      = 0;
+`endif
 
     `MINDELAY        // Ensure first x->1 clock edge is complete before initialisation
     Count      = 0;
@@ -212,6 +247,9 @@ begin
     // Generate delayed version of reset
     nreset_h <= #`RegDel nreset;
 
+    // Loop back the sideband signal set by node 1
+    SigLoop  <= #`RegDel SigSet;
+
     // Increment count and stop if reached stop count
     Count      = Count + 1;
     if (Count == `TIMEOUTCOUNT || (VPWE1 == 1'b1 && VPAddr1[31:28] == 4'hb))
@@ -251,6 +251,48 @@ extern "C" void VUserMain1()
 
     VPrint("Node %d: burst read 11 bytes from addr %08x\n", node, addr);
 
+#ifdef VSIGNAL_SUPPORTED
+    // -------------------------------------------
+    // Set a sideband signal, and wait for it to
+    // be looped back
+
+    int sigSet, sigLoop;
+
+# ifdef VPROC_SV
+    // Indexes of the VProcSignal module ports
+    sigSet  = 0;
+    sigLoop = 1;
+# else
+    sigSet  = vp1.signalIdx("test.SigSet");
+    sigLoop = vp1.signalIdx("test.SigLoop");
+# endif
+
+    data = 0x0000a5a5;
+    vp1.setSignal(sigSet, data);
+
+    // Not looped back until the next clock edge
+    vp1.getSignal(sigLoop, &num);
+
+    if (num == data)
+    {
+        VPrint("***Error: sideband signal looped back without a clock edge in node %d\n", node);
+        SLEEP;
+    }
+
+    vp1.waitSignal(sigLoop, data);
+    vp1.getSignal(sigLoop, &num);
+
+    if (num != data)
+    {
+        VPrint("***Error: sideband signal miscompare in node %d (%08x)\n", node, num);
+        SLEEP;
+    }
+    else
+    {
+        VPrint("Node %d: sideband signal looped back %08x\n", node, num);
+    }
+#endif
+
     // Wait a bit and then stop the simulation
     vp1.tick(10);
     vp1.write(SIMSTOPADDR, 0);
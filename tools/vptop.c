@@ -0,0 +1,238 @@
+//=====================================================================
+//
+// vptop.c                                            Date: 2026/10/19
+//
+// Copyright (c) 2026 Simon Southwell.
+//
+// This file is part of VProc.
+//
+// VProc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// VProc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with VProc. If not, see <http://www.gnu.org/licenses/>.
+//
+//=====================================================================
+//
+// Top-like monitor for a running VProc simulation with the
+// VPROC_LIVE_STATS environment variable set. Attaches read-only
+// to the live statistics shared memory segment, so has no effect
+// on the running simulation.
+//
+// Usage: vptop [-i <interval ms>] [-n <iterations>] [<pid>|<shm name>]
+//
+//=====================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <dirent.h>
+#include <signal.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define VLIVE_NO_PROTOTYPES
+#include "VLive.h"
+
+#define NAME_BUF_SIZE           512
+
+static const char *stateStr[] = {"idle", "running", "blocked", "sleeping"};
+
+// -------------------------------------------------------------------------
+// nowNs()
+// -------------------------------------------------------------------------
+
+static uint64_t nowNs (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// -------------------------------------------------------------------------
+// findSegment()
+//
+// If no name given, look for a single VProc segment in /dev/shm
+// -------------------------------------------------------------------------
+
+static int findSegment (char *name)
+{
+    DIR           *dir;
+    struct dirent *ent;
+    int            count = 0;
+    const char    *prefix = VLIVE_NAME_PREFIX + 1;
+
+    if ((dir = opendir("/dev/shm")) == NULL)
+    {
+        return 0;
+    }
+
+    while ((ent = readdir(dir)) != NULL)
+    {
+        if (strncmp(ent->d_name, prefix, strlen(prefix)) == 0)
+        {
+            if (count == 0)
+            {
+                snprintf(name, NAME_BUF_SIZE, "/%s", ent->d_name);
+            }
+            else
+            {
+                if (count == 1)
+                {
+                    fprintf(stderr, "Multiple simulations found, select one of:\n  %s\n", name+1);
+                }
+                fprintf(stderr, "  %s\n", ent->d_name);
+            }
+            count++;
+        }
+    }
+
+    closedir(dir);
+
+    return count;
+}
+
+// -------------------------------------------------------------------------
+// main()
+// -------------------------------------------------------------------------
+
+int main (int argc, char **argv)
+{
+    char          name[NAME_BUF_SIZE];
+    int           interval = 1000;
+    int           iterations = -1;
+    int           opt, fd;
+    struct stat   st;
+    VLiveSeg_t   *seg;
+    VLiveNode_t  *prev;
+    uint64_t      prev_ns;
+
+    while ((opt = getopt(argc, argv, "i:n:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'i': interval   = atoi(optarg); break;
+        case 'n': iterations = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-i <interval ms>] [-n <iterations>] [<pid>|<shm name>]\n", argv[0]);
+            exit(1);
+        }
+    }
+
+    if (optind < argc)
+    {
+        if (argv[optind][0] == '/')
+        {
+            snprintf(name, NAME_BUF_SIZE, "%s", argv[optind]);
+        }
+        else
+        {
+            snprintf(name, NAME_BUF_SIZE, "%s%s", VLIVE_NAME_PREFIX, argv[optind]);
+        }
+    }
+    else
+    {
+        int count = findSegment(name);
+
+        if (count == 0)
+        {
+            fprintf(stderr, "No running VProc simulation found (is %s set?)\n", VLIVE_ENV);
+            exit(1);
+        }
+        else if (count > 1)
+        {
+            exit(1);
+        }
+    }
+
+    if ((fd = shm_open(name, O_RDONLY, 0)) == -1 || fstat(fd, &st) == -1 || st.st_size < (off_t)sizeof(VLiveSeg_t))
+    {
+        fprintf(stderr, "***Error: cannot open shared memory segment %s\n", name);
+        exit(1);
+    }
+
+    seg = (VLiveSeg_t *) mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (seg == MAP_FAILED || strncmp(seg->magic, VLIVE_MAGIC, sizeof(seg->magic)) != 0 ||
+        seg->version != VLIVE_VERSION || (off_t)VLIVE_SEG_SIZE(seg->max_nodes) > st.st_size)
+    {
+        fprintf(stderr, "***Error: %s is not a VProc live statistics segment\n", name);
+        exit(1);
+    }
+
+    prev    = (VLiveNode_t *) calloc(seg->max_nodes, sizeof(VLiveNode_t));
+    prev_ns = nowNs();
+
+    while (iterations != 0)
+    {
+        struct timespec ts = {interval / 1000, (interval % 1000) * 1000000L};
+        uint64_t        now;
+        double          dt;
+
+        nanosleep(&ts, NULL);
+
+        now = nowNs();
+        dt  = (double)(now - prev_ns) / 1e9;
+
+        printf("\033[H\033[J");
+        printf("VProc simulation pid %llu  %s  up %.0fs\n\n", (unsigned long long)seg->pid, name,
+               (double)(now - seg->start_ns) / 1e9);
+        printf("%-5s %-9s %14s %12s %14s %12s %12s %10s\n",
+               "NODE", "STATE", "CYCLE", "KCYC/S", "TXNS", "TXNS/S", "WORDS", "LASTADDR");
+
+        for (uint32_t node = 0; node < seg->max_nodes; node++)
+        {
+            VLiveNode_t cur;
+            uint32_t    state = VLIVE_LOAD(seg->node[node].state);
+
+            if (state == VLIVE_STATE_IDLE)
+            {
+                continue;
+            }
+
+            cur.cycle     = VLIVE_LOAD(seg->node[node].cycle);
+            cur.txns      = VLIVE_LOAD(seg->node[node].txns);
+            cur.words     = VLIVE_LOAD(seg->node[node].words);
+            cur.last_addr = VLIVE_LOAD(seg->node[node].last_addr);
+
+            printf("%-5u %-9s %14llu %12.1f %14llu %12.0f %12llu   %08x\n",
+                   node, state < 4 ? stateStr[state] : "?",
+                   (unsigned long long)cur.cycle,
+                   prev[node].cycle ? (double)(cur.cycle - prev[node].cycle) / dt / 1e3 : 0.0,
+                   (unsigned long long)cur.txns,
+                   prev[node].cycle ? (double)(cur.txns - prev[node].txns) / dt : 0.0,
+                   (unsigned long long)cur.words,
+                   cur.last_addr);
+
+            prev[node] = cur;
+        }
+
+        fflush(stdout);
+        prev_ns = now;
+
+        if (kill((pid_t)seg->pid, 0) == -1 && errno == ESRCH)
+        {
+            printf("\nSimulation has exited\n");
+            break;
+        }
+
+        if (iterations > 0)
+        {
+            iterations--;
+        }
+    }
+
+    return 0;
+}
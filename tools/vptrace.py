@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+###################################################################
+# VProc binary transaction trace converter
+#
+# Copyright (c) 2026 Simon Southwell.
+#
+# This file is part of VProc.
+#
+# This code is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# The code is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this code. If not, see <http://www.gnu.org/licenses/>.
+#
+###################################################################
+#
+# Converts a trace file written when VPROC_TRACE_FILE is set into
+# CSV, or into a VCD file with one transaction stream per node that
+# can be loaded alongside the simulation waveforms (e.g. in GTKWave).
+#
+# Usage: vptrace.py [-f csv|vcd] [-p <clk period>] [-u <timescale>]
+#                   [-o <output>] <trace file>
+#
+###################################################################
+
+import argparse
+import struct
+import sys
+
+MAGIC    = b"VPTRACE\0"
+HDR_FMT  = "<8sII"
+REC_FMT  = "<QQIIIBBBB"
+
+OP_NAMES = ["tick", "write", "read", "burst_write", "burst_read"]
+
+# ---------------------------------------------------------------
+# Read the trace file, returning a list of record tuples
+# (cycle, wall_ns, addr, data, duration, op, be, node)
+# ---------------------------------------------------------------
+
+def read_trace(fname) :
+
+  with open(fname, "rb") as fp :
+    hdr = fp.read(struct.calcsize(HDR_FMT))
+
+    if len(hdr) < struct.calcsize(HDR_FMT) :
+      sys.exit("***Error: %s is too short to be a trace file" % fname)
+
+    magic, version, rec_size = struct.unpack(HDR_FMT, hdr)
+
+    if magic != MAGIC :
+      sys.exit("***Error: %s is not a VProc trace file" % fname)
+
+    if version != 1 or rec_size != struct.calcsize(REC_FMT) :
+      sys.exit("***Error: unsupported trace version %d (record size %d)" % (version, rec_size))
+
+    recs = []
+    while True :
+      buf = fp.read(rec_size)
+      if len(buf) < rec_size :
+        break
+      cycle, wall, addr, data, dur, op, be, node, _ = struct.unpack(REC_FMT, buf)
+      recs.append((cycle, wall, addr, data, dur, op, be, node))
+
+  # Rings are drained per node, so put back into cycle order
+  recs.sort(key = lambda r : (r[0], r[7]))
+
+  return recs
+
+# ---------------------------------------------------------------
+# Write records as CSV
+# ---------------------------------------------------------------
+
+def write_csv(recs, fp) :
+
+  fp.write("cycle,wall_ns,node,op,addr,data,be,duration\n")
+
+  for cycle, wall, addr, data, dur, op, be, node in recs :
+    opname = OP_NAMES[op] if op < len(OP_NAMES) else str(op)
+    fp.write("%d,%d,%d,%s,0x%08x,0x%08x,0x%x,%d\n" % (cycle, wall, node, opname, addr, data, be, dur))
+
+# ---------------------------------------------------------------
+# Return a VCD identifier code for an index, in base 94 using the
+# printable ASCII characters '!' to '~'
+# ---------------------------------------------------------------
+
+def vcd_ident(idx) :
+
+  ident = ""
+
+  while True :
+    ident += chr(33 + idx % 94)
+    idx    = idx // 94
+    if idx == 0 :
+      return ident
+    idx   -= 1
+
+# ---------------------------------------------------------------
+# Write records as VCD, with per node op, addr, data and
+# busy signals. Ticks are shown as op only, with busy low.
+# ---------------------------------------------------------------
+
+def write_vcd(recs, fp, period, timescale) :
+
+  nodes = sorted(set(r[7] for r in recs))
+  ids   = {}
+
+  for node in nodes :
+    for sig in ["op", "addr", "data", "busy"] :
+      ids[(node, sig)] = vcd_ident(len(ids))
+
+  fp.write("$version VProc vptrace.py $end\n")
+  fp.write("$timescale %s $end\n" % timescale)
+  fp.write("$scope module vproc $end\n")
+
+  for node in nodes :
+    fp.write("$scope module node%d $end\n" % node)
+    fp.write("$var wire 8 %s op $end\n"    % ids[(node, "op")])
+    fp.write("$var wire 32 %s addr $end\n" % ids[(node, "addr")])
+    fp.write("$var wire 32 %s data $end\n" % ids[(node, "data")])
+    fp.write("$var wire 1 %s busy $end\n"  % ids[(node, "busy")])
+    fp.write("$upscope $end\n")
+
+  fp.write("$upscope $end\n$enddefinitions $end\n")
+
+  # Build a list of (time, order, text) value changes. Record end events
+  # sort before start events at the same time so back-to-back commands
+  # show their boundaries.
+  events = []
+  for cycle, wall, addr, data, dur, op, be, node in recs :
+    start = cycle * period
+    events.append((start, 1, "b{:b} {}".format(op,   ids[(node, "op")])))
+    events.append((start, 1, "b{:b} {}".format(addr, ids[(node, "addr")])))
+    events.append((start, 1, "b{:b} {}".format(data, ids[(node, "data")])))
+    if op != 0 :
+      events.append((start, 1, "1" + ids[(node, "busy")]))
+      events.append(((cycle + max(dur, 1)) * period, 0, "0" + ids[(node, "busy")]))
+
+  events.sort(key = lambda e : (e[0], e[1]))
+
+  fp.write("#0\n$dumpvars\n")
+  for node in nodes :
+    fp.write("bx %s\nbx %s\nbx %s\n0%s\n" % (ids[(node, "op")], ids[(node, "addr")],
+                                          ids[(node, "data")], ids[(node, "busy")]))
+  fp.write("$end\n")
+
+  last = 0
+  for time, _, text in events :
+    if time != last :
+      fp.write("#%d\n" % time)
+      last = time
+    fp.write(text + "\n")
+
+# ---------------------------------------------------------------
+# Main
+# ---------------------------------------------------------------
+
+def main() :
+
+  parser = argparse.ArgumentParser(description = "Convert a VProc binary trace file")
+  parser.add_argument("trace",                                   help = "trace file (VPROC_TRACE_FILE)")
+  parser.add_argument("-f", "--format",    default = "csv",      choices = ["csv", "vcd"])
+  parser.add_argument("-p", "--period",    default = 1, type = int,
+                      help = "clock period in timescale units for VCD output (default 1)")
+  parser.add_argument("-u", "--timescale", default = "1ns",      help = "VCD timescale (default 1ns)")
+  parser.add_argument("-o", "--output",    default = None,       help = "output file (default stdout)")
+  args = parser.parse_args()
+
+  recs = read_trace(args.trace)
+  fp   = open(args.output, "w") if args.output else sys.stdout
+
+  if args.format == "vcd" :
+    write_vcd(recs, fp, args.period, args.timescale)
+  else :
+    write_csv(recs, fp)
+
+  if args.output :
+    fp.close()
+
+if __name__ == "__main__" :
+  main()
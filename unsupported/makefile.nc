@@ -34,7 +34,22 @@ VPROCDIR        = ./code
 USRCDIR         = ./usercode
 
 VPROC_C         = ${VPROCDIR}/VSched.c           		\
-                  ${VPROCDIR}/VUser.c
+                  ${VPROCDIR}/VUser.c              \
+                  ${VPROCDIR}/VStats.c             \
+                  ${VPROCDIR}/VTrace.c             \
+                  ${VPROCDIR}/VTimeline.c          \
+                  ${VPROCDIR}/VLive.c              \
+                  ${VPROCDIR}/VRemote.c            \
+                  ${VPROCDIR}/VBridge.c            \
+                  ${VPROCDIR}/VReplay.c            \
+                  ${VPROCDIR}/VStream.c            \
+                  ${VPROCDIR}/VRestart.c           \
+                  ${VPROCDIR}/VLog.c               \
+                  ${VPROCDIR}/VCheck.c             \
+                  ${VPROCDIR}/VProcVpi.c           \
+                  ${VPROCDIR}/VSignal.c            \
+                  ${VPROCDIR}/VMbox.c              \
+                  ${VPROCDIR}/VQueue.c
 
 
 # Test specific C flags ('include' paths and any required -D definitions)
@@ -31,8 +31,11 @@
 `define BLKBITS                 13:2
 `define BEBITS                  17:14
 `define LBEBITS                 21:18
+`define RSTBIT                  22
+`define NOWAITBIT               23
 
 `define DELTACYCLE              -1
+`define SLEEPFOREVER            2147483647
 `define DONTCARE                 0
 
 `ifdef VERILATOR
@@ -53,6 +56,7 @@
 `define VSched                   VSched
 `define VIrq                     VIrq
 `define VProcUser                VProcUser
+`define VBurstArray              VBurstArray
 
 // If Verilog map PLI deinitions to VPI system tasks
 `else
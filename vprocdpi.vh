@@ -22,12 +22,24 @@
 //
 // ====================================================================
 
-// Import DPI-C fuctions
+// Import DPI-C fuctions. This is included in the body of each module
+// making the calls, so the imports are in the module's scope rather
+// than $unit, which a simulator may make per file. It therefore has no
+// include guard.
 
 import "DPI-C" function void VInit     (input  int node);
 
-import "DPI-C" function void VSched    (input  int node,
+// VSched calls functions exported from VProcSignal, when used, so is
+// then a context function
+`ifdef VPROC_SIGNAL_IF
+`define VSCHED_CONTEXT context
+`else
+`define VSCHED_CONTEXT
+`endif
+
+import "DPI-C" `VSCHED_CONTEXT function void VSched (input  int node,
                                         input  int VPDataIn, 
+                                        input  int VPCycle,
                                         output int VPDataOut,
                                         output int VPAddr, 
                                         output int VPRw,
@@ -40,4 +52,16 @@ import "DPI-C" function void VAccess   (input  int node,
                                         
 import "DPI-C" function void VProcUser (input  int  node, input int value);
 
-import "DPI-C" function void VIrq      (input  int  node, input int irq);
\ No newline at end of file
+import "DPI-C" function void VIrq      (input  int  node, input int irq);
+
+`ifdef VPROC_BURST_ARRAY
+import "DPI-C" function void VBurstArray (input int node,
+                                          input int rd,
+                                          input int len,
+                                          inout int data[]);
+`endif
+
+`ifdef VPROC_SIGNAL_IF
+import "DPI-C" context function void VSignalRegBank (input int node,
+                                                     input int num);
+`endif